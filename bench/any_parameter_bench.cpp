@@ -0,0 +1,160 @@
+// any_parameter_bench.cpp
+// Protocol-wide passes over 2000 parameters (double, int, bool, Vector3d, Matrix3d) held as
+// std::vector<AnyParameter> and as individually heap-allocated IParameter objects (scattered between other
+// allocations): validation (non-finite values), serialization ("name = value unit" lines) and diffing
+// against a copy with 1% of the values changed. The IParameter path dispatches like the existing type-erased
+// code, with virtual calls (TypeId(), ValueBytes(), FormatValueTo(), ...) and a switch over TypeId().
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <methodverse/parameter/any_parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// a ParameterBase with a run-time name, so that every parameter has its own id
+template<class T, auto Unit>
+class Named : public ParameterBase<T, Unit> {
+public:
+    Named(std::string name, const T& value) : ParameterBase<T, Unit>(value), name_(std::move(name)), id_(name_) {}
+    std::string_view NameView() const noexcept override { return name_; }
+    ParameterId Id() const noexcept override { return id_; }
+
+private:
+    std::string name_;
+    ParameterId id_;
+};
+
+std::unique_ptr<IParameter> make_parameter(std::size_t i, double value) {
+    std::string name = "P" + std::to_string(i);
+    switch (i % 8) {
+        case 4: return std::make_unique<Named<int, one>>(std::move(name), static_cast<int>(value));
+        case 5: return std::make_unique<Named<bool, one>>(std::move(name), i % 2 == 0);
+        case 6: return std::make_unique<Named<Eigen::Vector3d, si::metre>>(std::move(name), Eigen::Vector3d::Constant(value));
+        case 7: return std::make_unique<Named<Eigen::Matrix3d, one>>(std::move(name), Eigen::Matrix3d::Identity() * value);
+        default: return std::make_unique<Named<double, si::second>>(std::move(name), value);
+    }
+}
+
+// ---- the same passes on IParameter pointers
+template<class F>
+decltype(auto) visit_erased(const IParameter& p, F&& f) {
+    return boost::mp11::mp_with_index<primitive_type_count>(p.TypeId(), [&](auto I) -> decltype(auto) {
+        return f(p.UncheckedViewAs<boost::mp11::mp_at_c<primitive_types, I>>());
+    });
+}
+
+std::vector<ParameterId> find_non_finite(const std::vector<const IParameter*>& parameters) {
+    std::vector<ParameterId> invalid;
+    for (const IParameter* p : parameters) {
+        const bool finite = visit_erased(*p, [](auto values) {
+            return std::all_of(values.begin(), values.end(), [](const auto& v) { return methodverse::parameter::detail::finite_value(v); });
+        });
+        if (!finite) invalid.push_back(p->Id());
+    }
+    return invalid;
+}
+
+void format_parameters_to(fmt::memory_buffer& out, const std::vector<const IParameter*>& parameters) {
+    for (const IParameter* p : parameters) {
+        out.append(p->NameView());
+        out.append(std::string_view(" = "));
+        p->FormatValueTo(out);
+        const RuntimeUnit unit = p->GetRuntimeUnit();
+        if (!unit.IsDimensionless() || unit.magnitude != 1.0) {
+            out.push_back(' ');
+            out.append(unit.ToString());
+        }
+        out.push_back('\n');
+    }
+}
+
+std::size_t count_changed(const std::vector<const IParameter*>& before, const std::vector<const IParameter*>& after) {
+    auto by_id = [](const std::vector<const IParameter*>& v) {
+        std::vector<const IParameter*> sorted = v;
+        std::sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) { return a->Id().value < b->Id().value; });
+        return sorted;
+    };
+    const auto b = by_id(before);
+    const auto a = by_id(after);
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < b.size(); ++i) {
+        const bool same = b[i]->TypeId() == a[i]->TypeId() && b[i]->GetRuntimeUnit() == a[i]->GetRuntimeUnit() &&
+                          visit_erased(*b[i], [&](auto values) {
+                              using T = typename decltype(values)::value_type;
+                              const auto other = a[i]->UncheckedViewAs<T>();
+                              return methodverse::parameter::detail::values_equal(values, other);
+                          });
+        changed += same ? 0 : 1;
+    }
+    return changed;
+}
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 2000;
+    constexpr std::size_t repetitions = 500;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> noise_size(64, 4096);
+    std::vector<std::unique_ptr<char[]>> noise;
+    std::vector<std::unique_ptr<IParameter>> owned_before, owned_after;
+    std::vector<const IParameter*> erased_before, erased_after;
+    std::vector<AnyParameter> any_before, any_after;
+    for (std::size_t i = 0; i < parameter_count; ++i) {
+        const double value = 1.0 + static_cast<double>(i) * 1e-3;
+        owned_before.push_back(make_parameter(i, value));
+        noise.push_back(std::make_unique<char[]>(noise_size(rng)));
+        owned_after.push_back(make_parameter(i, i % 100 == 0 ? value + 1.0 : value));
+        noise.push_back(std::make_unique<char[]>(noise_size(rng)));
+        erased_before.push_back(owned_before.back().get());
+        erased_after.push_back(owned_after.back().get());
+        any_before.push_back(AnyParameter::From(*owned_before.back()));
+        any_after.push_back(AnyParameter::From(*owned_after.back()));
+    }
+
+    std::size_t sink = 0;
+    const double validate_erased = time_ns(repetitions, [&] { sink += find_non_finite(erased_before).size(); });
+    const double validate_any = time_ns(repetitions, [&] { sink += FindNonFinite(any_before).size(); });
+
+    fmt::memory_buffer out;
+    const double format_erased = time_ns(repetitions, [&] {
+        out.clear();
+        format_parameters_to(out, erased_before);
+    });
+    const std::string text_erased = fmt::to_string(out);
+    const double format_any = time_ns(repetitions, [&] {
+        out.clear();
+        FormatParametersTo(out, any_before);
+    });
+    const bool same_text = text_erased == fmt::to_string(out);
+
+    std::size_t changed_erased = 0, changed_any = 0;
+    const double diff_erased = time_ns(repetitions, [&] { changed_erased = count_changed(erased_before, erased_after); });
+    const double diff_any = time_ns(repetitions, [&] { changed_any = DiffParameters(any_before, any_after).size(); });
+
+    std::printf("%zu parameters, sizeof(AnyParameter) = %zu\n", parameter_count, sizeof(AnyParameter));
+    std::printf("validate   IParameter* %10.1f us  AnyParameter %10.1f us (%4.2fx)\n", validate_erased / 1e3,
+                validate_any / 1e3, validate_erased / validate_any);
+    std::printf("serialize  IParameter* %10.1f us  AnyParameter %10.1f us (%4.2fx)%s\n", format_erased / 1e3,
+                format_any / 1e3, format_erased / format_any, same_text ? "" : "  MISMATCH");
+    std::printf("diff       IParameter* %10.1f us  AnyParameter %10.1f us (%4.2fx)  %zu/%zu changed\n",
+                diff_erased / 1e3, diff_any / 1e3, diff_erased / diff_any, changed_erased, changed_any);
+    return sink == 0 ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+// bit_mask_bench.cpp
+// Logical ops on a 1M-line acquisition mask, held as ParameterBase<bool> (one bool per value, combined by the
+// per-element bool policies) and as ParameterBase<BitMask> (one packed value, combined word by word), both
+// through EagerApply and the same op tags, plus counting and iterating the set bits.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t lines = 1 << 20;
+    constexpr std::size_t repetitions = 50;
+
+    std::mt19937 rng(42);
+    std::bernoulli_distribution sampled(0.3);
+    std::vector<bool> a_values(lines), b_values(lines);
+    for (std::size_t i = 0; i < lines; ++i) {
+        a_values[i] = sampled(rng);
+        b_values[i] = sampled(rng);
+    }
+    const ParameterBase<bool, one> a_bools(a_values);
+    const ParameterBase<bool, one> b_bools(b_values);
+    const ParameterBase<BitMask, one> a_mask(BitMask(a_bools.View()));
+    const ParameterBase<BitMask, one> b_mask(BitMask(b_bools.View()));
+
+    std::size_t sink = 0;
+    auto bench_op = [&](const char* name, auto op) {
+        using Op = decltype(op);
+        const double bools = time_ns(repetitions, [&] { sink += EagerApply<Op>(a_bools, b_bools).Size(); });
+        const double mask = time_ns(repetitions, [&] { sink += EagerApply<Op>(a_mask, b_mask).Val().Size(); });
+        std::printf("%-6s bool %10.1f us  BitMask %8.1f us (%5.1fx)\n", name, bools / 1e3, mask / 1e3, bools / mask);
+    };
+    bench_op("and", and_op{});
+    bench_op("or", or_op{});
+    bench_op("xor", xor_op{});
+    bench_op("xnor", xnor_op{});
+
+    const double not_bools = time_ns(repetitions, [&] { sink += EagerApply<not_op>(a_bools).Size(); });
+    const double not_mask = time_ns(repetitions, [&] { sink += EagerApply<not_op>(a_mask).Val().Size(); });
+    std::printf("%-6s bool %10.1f us  BitMask %8.1f us (%5.1fx)\n", "not", not_bools / 1e3, not_mask / 1e3,
+                not_bools / not_mask);
+
+    std::size_t count_bools = 0, count_mask = 0;
+    const double count_b = time_ns(repetitions, [&] {
+        count_bools = 0;
+        for (const bool v : a_bools.View()) count_bools += v;
+    });
+    const double count_m = time_ns(repetitions, [&] { count_mask = a_mask.Val().Count(); });
+    std::printf("%-6s bool %10.1f us  BitMask %8.1f us (%5.1fx)%s\n", "count", count_b / 1e3, count_m / 1e3,
+                count_b / count_m, count_bools == count_mask ? "" : "  MISMATCH");
+
+    std::size_t sum_bools = 0, sum_mask = 0;
+    const double each_b = time_ns(repetitions, [&] {
+        sum_bools = 0;
+        const auto values = a_bools.View();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (values[i]) sum_bools += i;
+        }
+    });
+    const double each_m = time_ns(repetitions, [&] {
+        sum_mask = 0;
+        a_mask.Val().ForEachSet([&](std::size_t i) { sum_mask += i; });
+    });
+    std::printf("%-6s bool %10.1f us  BitMask %8.1f us (%5.1fx)%s\n", "each", each_b / 1e3, each_m / 1e3,
+                each_b / each_m, sum_bools == sum_mask ? "" : "  MISMATCH");
+    std::printf("%zu lines, %zu bytes as bool, %zu bytes as BitMask\n", lines, lines * sizeof(bool),
+                a_mask.Val().Words().size() * sizeof(BitMask::word_type));
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+// change_log_bench.cpp
+// Cost of the change notifications of Parameter::operator=: a loop of assignments without subscribers (one
+// branch), with a subscriber and one transaction around the loop (one batch), and with a subscriber and no
+// transaction (one batch per assignment). The raw store through Get() is the reference.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct EchoTime : Parameter<double, EchoTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TE";
+};
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t assignments = 10'000;
+    EchoTime te(0.0);
+
+    const double raw = time_ns(1'000, [&] {
+        for (std::size_t i = 0; i < assignments; ++i) {
+            te.Get()[0] = static_cast<double>(i);
+            asm volatile("" : : "r"(te.Get().data()) : "memory"); // keep every store
+        }
+    }) / assignments;
+    const double unsubscribed = time_ns(1'000, [&] {
+        for (std::size_t i = 0; i < assignments; ++i) {
+            te = static_cast<double>(i);
+            asm volatile("" : : "r"(te.Get().data()) : "memory");
+        }
+    }) / assignments;
+
+    std::size_t batches = 0;
+    std::size_t changes = 0;
+    auto subscription = SubscribeChanges([&](std::span<const ParameterChange> batch) {
+        ++batches;
+        changes += batch.size();
+    });
+    constexpr std::size_t transactions = 100;
+    const double transaction = time_ns(transactions, [&] {
+        ChangeTransaction tx;
+        for (std::size_t i = 0; i < assignments; ++i) te = static_cast<double>(i);
+    }) / assignments;
+    const std::size_t transaction_batches = batches;
+    const double immediate = time_ns(10, [&] {
+        for (std::size_t i = 0; i < assignments; ++i) te = static_cast<double>(i);
+    }) / assignments;
+
+    std::printf("assignment, raw store through Get()        %7.2f ns\n", raw);
+    std::printf("assignment, no subscriber                  %7.2f ns\n", unsubscribed);
+    std::printf("assignment, subscriber, one transaction    %7.2f ns (%zu batches for %zu transactions)\n",
+                transaction, transaction_batches, transactions + 1);
+    std::printf("assignment, subscriber, no transaction     %7.2f ns (one batch per assignment)\n", immediate);
+    (void)changes;
+    return 0;
+}
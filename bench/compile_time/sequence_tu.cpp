@@ -0,0 +1,67 @@
+// sequence_tu.cpp
+// A typical translation unit of sequence code for tools/compile_time_bench.py: it declares parameters,
+// assigns and combines them and passes them on as IParameter, but does not format them. It is compiled
+// against methodverse-parameter (header-only) and methodverse-parameter-impl (extern templates).
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+namespace {
+
+struct EchoTime : Parameter<double, EchoTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TE";
+};
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct FlipAngle : Parameter<double, FlipAngle, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "FlipAngle";
+};
+
+struct FieldOfView : Parameter<Eigen::Vector3d, FieldOfView, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "FieldOfView";
+};
+
+struct Rotation : Parameter<Eigen::Matrix3d, Rotation, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Rotation";
+};
+
+struct MatrixSize : Parameter<int, MatrixSize, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "MatrixSize";
+};
+
+struct Label : Parameter<std::string, Label, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Label";
+};
+
+} // namespace
+
+double PrepareSequence(std::vector<IParameter*>& protocol) {
+    static EchoTime te(0.01);
+    static RepetitionTime tr(2.0);
+    static FlipAngle fa(30.0);
+    static FieldOfView fov(Eigen::Vector3d(0.25, 0.25, 0.1));
+    static Rotation rotation(Eigen::Matrix3d(Eigen::Matrix3d::Identity()));
+    static MatrixSize matrix{256, 256};
+    static Label label(std::string("t1_gre"));
+
+    te = 0.012;
+    tr.Set(2.5);
+    const EchoTime echo_spacing = te + te;
+    fov.Set(Eigen::Vector3d(0.22, 0.22, 0.1));
+    protocol = {&te, &tr, &fa, &fov, &rotation, &matrix, &label};
+    return echo_spacing.Val() + tr.Val() / static_cast<double>(matrix.Val());
+}
@@ -0,0 +1,110 @@
+// concurrent_bench.cpp
+// Read throughput of a parameter shared by 1 to 32 reader threads while one writer thread keeps updating it:
+// ConcurrentParameter (Left-Right) versus a parameter guarded by std::mutex and by std::shared_mutex.
+// Every read sums the values, every write assigns new values.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <methodverse/parameter/concurrent.h>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Gradients : Parameter<Eigen::Vector3d, Gradients, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Gradients";
+};
+
+double sum(const Gradients& p) {
+    double s = 0.0;
+    for (const auto& v : p.View()) s += v.x();
+    return s;
+}
+
+void assign(Gradients& p, double k) { p.Get().assign(16, Eigen::Vector3d(k, -k, k)); }
+
+struct LeftRight {
+    ConcurrentParameter<Gradients> p{std::vector<Eigen::Vector3d>(16, Eigen::Vector3d::Zero())};
+    double read() const { return p.Read(sum); }
+    void write(double k) { p.Write([k](Gradients& g) { assign(g, k); }); }
+};
+
+struct Mutex {
+    mutable std::mutex m;
+    Gradients p{std::vector<Eigen::Vector3d>(16, Eigen::Vector3d::Zero())};
+    double read() const {
+        std::lock_guard lock(m);
+        return sum(p);
+    }
+    void write(double k) {
+        std::lock_guard lock(m);
+        assign(p, k);
+    }
+};
+
+struct SharedMutex {
+    mutable std::shared_mutex m;
+    Gradients p{std::vector<Eigen::Vector3d>(16, Eigen::Vector3d::Zero())};
+    double read() const {
+        std::shared_lock lock(m);
+        return sum(p);
+    }
+    void write(double k) {
+        std::unique_lock lock(m);
+        assign(p, k);
+    }
+};
+
+// reads per microsecond over all readers
+template<class Shared>
+double run(int reader_count) {
+    Shared shared;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < reader_count; ++r) {
+        threads.emplace_back([&] {
+            std::uint64_t n = 0;
+            volatile double sink = 0.0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                sink = shared.read();
+                ++n;
+            }
+            (void)sink;
+            reads.fetch_add(n);
+        });
+    }
+    threads.emplace_back([&] {
+        double k = 0.0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            shared.write(k += 1.0);
+            std::this_thread::sleep_for(std::chrono::microseconds(50)); // UI edits, not a write storm
+        }
+    });
+
+    const auto duration = std::chrono::milliseconds(200);
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& t : threads) t.join();
+    return static_cast<double>(reads.load()) / std::chrono::duration<double, std::micro>(duration).count();
+}
+
+int main() {
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    std::printf("%8s %16s %16s %16s   (reads/us, one writer)\n", "readers", "Left-Right", "std::mutex", "shared_mutex");
+    for (int readers : {1, 2, 4, 8, 16, 32}) {
+        const double lr = run<LeftRight>(readers);
+        const double m = run<Mutex>(readers);
+        const double sm = run<SharedMutex>(readers);
+        std::printf("%8d %16.2f %16.2f %16.2f\n", readers, lr, m, sm);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+// format_bench.cpp
+// Stringifies a protocol of mixed parameters per "frame", as logging and UI refresh do. Compares the former
+// std::ostringstream implementation of ValueAsString() with the fmt based ValueAsString() and with
+// FormatValueTo() appending into one caller-owned fmt::memory_buffer.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// the former implementation, for comparison
+template<class T>
+std::string stream_to_string(std::span<const T> values) {
+    std::ostringstream oss;
+    oss << std::boolalpha;
+    if (values.size() == 1) {
+        oss << values[0];
+    } else {
+        oss << "[";
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) oss << ", ";
+            oss << values[i];
+        }
+        oss << "]";
+    }
+    return oss.str();
+}
+
+// type-erased stream path over the same parameters
+struct Entry {
+    std::unique_ptr<IParameter> param;
+    std::string (*stream)(const IParameter&);
+};
+
+template<class T>
+Entry make_entry(std::vector<T> values) {
+    return {std::make_unique<ParameterBase<T, si::second>>(std::move(values)), [](const IParameter& p) {
+                return stream_to_string(static_cast<const ParameterBase<T, si::second>&>(p).View());
+            }};
+}
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 2000;
+    constexpr std::size_t repetitions = 200;
+
+    std::vector<Entry> protocol;
+    for (std::size_t i = 0; i < parameter_count; ++i) {
+        const double x = 0.001 * static_cast<double>(i) + 0.1;
+        switch (i % 5) {
+            case 0: protocol.push_back(make_entry<double>({x})); break;
+            case 1: protocol.push_back(make_entry<int>({static_cast<int>(i)})); break;
+            case 2: protocol.push_back(make_entry<bool>({true})); break;
+            case 3: protocol.push_back(make_entry<double>({x, 2 * x, 3 * x, 4 * x})); break;
+            default: protocol.push_back(make_entry<Eigen::Vector3d>({Eigen::Vector3d(x, -x, 1.0)})); break;
+        }
+    }
+
+    std::size_t bytes = 0;
+    const double stream = time_ns(repetitions, [&] {
+        bytes = 0;
+        for (const auto& e : protocol) bytes += e.stream(*e.param).size();
+    });
+    const double value_as_string = time_ns(repetitions, [&] {
+        bytes = 0;
+        for (const auto& e : protocol) bytes += e.param->ValueAsString().size();
+    });
+    fmt::memory_buffer buffer;
+    const double format_to = time_ns(repetitions, [&] {
+        buffer.clear();
+        for (const auto& e : protocol) {
+            e.param->FormatValueTo(buffer);
+            buffer.push_back('\n');
+        }
+        bytes = buffer.size();
+    });
+
+    const auto per_parameter = [](double ns) { return ns / static_cast<double>(parameter_count); };
+    std::printf("%zu parameters per frame (%zu bytes)\n", parameter_count, bytes);
+    std::printf("ostringstream ValueAsString %10.1f ns/parameter\n", per_parameter(stream));
+    std::printf("fmt ValueAsString           %10.1f ns/parameter (%4.2fx)\n", per_parameter(value_as_string),
+                stream / value_as_string);
+    std::printf("fmt FormatValueTo (buffer)  %10.1f ns/parameter (%4.2fx)\n", per_parameter(format_to),
+                stream / format_to);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// formula_bench.cpp
+// Re-evaluates a synthetic protocol of 500 compiled formulas, each depending on base timing parameters
+// and on earlier formulas, as the UI does after every parameter change. Target: under 50 us per protocol.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <methodverse/parameter/formula.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+int main() {
+    constexpr std::size_t base_count = 20;
+    constexpr std::size_t formula_count = 500;
+    constexpr std::size_t repetitions = 20'000;
+
+    std::vector<ParameterBase<double, si::second>> base;
+    base.reserve(base_count);
+    FormulaSymbols symbols;
+    for (std::size_t i = 0; i < base_count; ++i) {
+        base.emplace_back(0.001 * static_cast<double>(i + 1));
+        symbols.emplace(fmt::format("t{}", i), &base.back());
+    }
+
+    const auto t0_compile = std::chrono::steady_clock::now();
+    std::vector<Formula> protocol;
+    protocol.reserve(formula_count);
+    std::size_t instructions = 0;
+    for (std::size_t i = 0; i < formula_count; ++i) {
+        // e.g. f7 = t7/2 + t8 + f6/2 - t9/10
+        const std::string c = i == 0 ? "t0" : fmt::format("f{}", i - 1);
+        protocol.emplace_back(fmt::format("f{} = t{}/2 + t{} + {}/2 - t{}/10", i, i % base_count, (i + 1) % base_count,
+                                          c, (i + 2) % base_count),
+                              symbols);
+        symbols.emplace(protocol.back().Target(), &protocol.back().Result());
+        instructions += protocol.back().InstructionCount();
+    }
+    const auto t1_compile = std::chrono::steady_clock::now();
+
+    volatile double sink = 0.0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        base[r % base_count].Set(0.001 * static_cast<double>(r % 7 + 1));
+        for (auto& f : protocol) f.Evaluate();
+        sink = protocol.back().Result().UncheckedViewAs<double>()[0];
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    (void)sink;
+
+    const double us = std::chrono::duration<double, std::micro>(t1 - t0).count() / static_cast<double>(repetitions);
+    std::printf("compile %zu formulas (%zu instructions)   %10.1f us\n", formula_count, instructions,
+                std::chrono::duration<double, std::micro>(t1_compile - t0_compile).count());
+    std::printf("evaluate protocol                          %10.2f us (target < 50 us)\n", us);
+    std::printf("per instruction                            %10.2f ns\n", us * 1000.0 / static_cast<double>(instructions));
+    return 0;
+}
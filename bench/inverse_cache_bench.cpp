@@ -0,0 +1,101 @@
+// inverse_cache_bench.cpp
+// Slice orientation workload: 16 slice rotations that are inverted and divided by many times per prepare.
+// Compares the per-call inversion of the policies with the batched inversion and the inverse cache of
+// ParameterBase<Eigen::Matrix3d> (detected and declared orthonormal), and a division of 1000 positions by a
+// single broadcast rotation, which the policy inverts once per element.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <Eigen/Geometry>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t slices = 16;
+    constexpr std::size_t positions = 1000;
+    constexpr std::size_t repetitions = 20000;
+    namespace mvd = methodverse::parameter::detail;
+
+    std::vector<Eigen::Matrix3d> rotations;
+    for (std::size_t i = 0; i < slices; ++i) {
+        const double angle = 0.1 * static_cast<double>(i);
+        rotations.push_back(Eigen::AngleAxisd(angle, Eigen::Vector3d(1.0, 2.0, 3.0).normalized()).toRotationMatrix());
+    }
+    std::vector<Eigen::RowVector3d> points;
+    for (std::size_t i = 0; i < positions; ++i) points.emplace_back(1.0 * i, 2.0, -0.5 * i);
+
+    ParameterBase<Eigen::Matrix3d, one> detected(rotations);
+    ParameterBase<Eigen::Matrix3d, one> declared(rotations);
+    declared.DeclareOrthonormal();
+    const ParameterBase<Eigen::RowVector3d, si::metre> slice_points(std::vector<Eigen::RowVector3d>(points.begin(), points.begin() + slices));
+    const ParameterBase<Eigen::RowVector3d, si::metre> all_points(points);
+    ParameterBase<Eigen::Matrix3d, one> single(rotations[3]);
+
+    double sink = 0.0;
+    using inverse_policy = op_policy<eigen_mat_tag, void, inverse_op>;
+    using div_policy = op_policy<eigen_rowvec_tag, eigen_mat_tag, div_op>;
+    std::vector<Eigen::Matrix3d> inverses(slices);
+    std::vector<Eigen::RowVector3d> quotients(positions);
+
+    // ---- inverse of 16 matrices
+    const double per_call = time_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < slices; ++i) inverses[i] = inverse_policy::impl(rotations[i]);
+        sink += inverses[slices - 1](0, 0);
+    });
+    const double batched = time_ns(repetitions, [&] {
+        InvertMatrices(rotations, inverses);
+        sink += inverses[slices - 1](0, 0);
+    });
+    const double cached_detected = time_ns(repetitions, [&] { sink += detected.Inverse()[slices - 1](0, 0); });
+    const double refresh_detected = time_ns(repetitions, [&] {
+        (void)detected.Get(); // invalidates
+        sink += detected.Inverse()[slices - 1](0, 0);
+    });
+    const double refresh_declared = time_ns(repetitions, [&] {
+        (void)declared.Get();
+        sink += declared.Inverse()[slices - 1](0, 0);
+    });
+
+    // ---- 16 positions / 16 rotations, element by element
+    const double div_policy_ns = time_ns(repetitions, [&] {
+        mvd::elementwise<div_policy>(slice_points.View().data(), slices, rotations.data(), slices, quotients.data());
+        sink += quotients[0](0);
+    });
+    (void)declared.Inverse();
+    const double div_cached = time_ns(repetitions, [&] { sink += EagerApply<div_op>(slice_points, declared)[0](0); });
+
+    // ---- 1000 positions / one broadcast rotation
+    const double broadcast_policy = time_ns(repetitions / 10, [&] {
+        mvd::elementwise<div_policy>(points.data(), positions, &rotations[3], 1, quotients.data());
+        sink += quotients[0](0);
+    });
+    const double broadcast_eager = time_ns(repetitions / 10, [&] { sink += EagerApply<div_op>(all_points, single)[0](0); });
+    single.DeclareOrthonormal();
+    (void)single.Inverse();
+    const double broadcast_cached = time_ns(repetitions / 10, [&] { sink += EagerApply<div_op>(all_points, single)[0](0); });
+
+    std::printf("inverse of %zu rotations      per call %8.1f ns  batched %8.1f ns  cache hit %6.1f ns\n", slices,
+                per_call, batched, cached_detected);
+    std::printf("                             refill (detected) %8.1f ns  refill (declared) %8.1f ns\n",
+                refresh_detected, refresh_declared);
+    std::printf("%zu positions / %zu rotations policy %8.1f ns  EagerApply, cached %8.1f ns (%4.1fx)\n", slices, slices,
+                div_policy_ns, div_cached, div_policy_ns / div_cached);
+    std::printf("%zu positions / 1 rotation  policy %8.1f ns  EagerApply %8.1f ns (%4.1fx)  cached %8.1f ns (%4.1fx)\n",
+                positions, broadcast_policy, broadcast_eager, broadcast_policy / broadcast_eager, broadcast_cached,
+                broadcast_policy / broadcast_cached);
+    return sink == 0.0 ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+// parameter_access_bench.cpp
+// Compares the copying accessors Val()/Vals() with the zero-copy accessors ValRef()/View() for every type in
+// primitive_types, for a single value and for 1000 values.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/mp11/algorithm.hpp>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class T> const char* type_name();
+template<> const char* type_name<bool>() { return "bool"; }
+template<> const char* type_name<int>() { return "int"; }
+template<> const char* type_name<double>() { return "double"; }
+template<> const char* type_name<std::string>() { return "std::string"; }
+template<> const char* type_name<Eigen::Vector3d>() { return "Eigen::Vector3d"; }
+template<> const char* type_name<Eigen::RowVector3d>() { return "Eigen::RowVector3d"; }
+template<> const char* type_name<Eigen::Matrix3d>() { return "Eigen::Matrix3d"; }
+template<> const char* type_name<Eigen::Quaterniond>() { return "Eigen::Quaterniond"; }
+template<> const char* type_name<Eigen::VectorXd>() { return "Eigen::VectorXd"; }
+template<> const char* type_name<Eigen::ArrayXd>() { return "Eigen::ArrayXd"; }
+template<> const char* type_name<Eigen::VectorXf>() { return "Eigen::VectorXf"; }
+template<> const char* type_name<Eigen::ArrayXf>() { return "Eigen::ArrayXf"; }
+
+template<class T> T sample();
+template<> bool sample<bool>() { return true; }
+template<> int sample<int>() { return 42; }
+template<> double sample<double>() { return 4.2; }
+template<> std::string sample<std::string>() { return "a protocol string long enough to defeat SSO"; }
+template<> Eigen::Vector3d sample<Eigen::Vector3d>() { return {1, 2, 3}; }
+template<> Eigen::RowVector3d sample<Eigen::RowVector3d>() { return {1, 2, 3}; }
+template<> Eigen::Matrix3d sample<Eigen::Matrix3d>() { return Eigen::Matrix3d::Identity(); }
+template<> Eigen::Quaterniond sample<Eigen::Quaterniond>() { return Eigen::Quaterniond(1, 0, 0, 0); }
+template<> Eigen::VectorXd sample<Eigen::VectorXd>() { return Eigen::VectorXd::LinSpaced(64, 0, 1); }
+template<> Eigen::ArrayXd sample<Eigen::ArrayXd>() { return Eigen::ArrayXd::LinSpaced(64, 0, 1); }
+template<> Eigen::VectorXf sample<Eigen::VectorXf>() { return Eigen::VectorXf::LinSpaced(64, 0, 1); }
+template<> Eigen::ArrayXf sample<Eigen::ArrayXf>() { return Eigen::ArrayXf::LinSpaced(64, 0, 1); }
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+// Prevent the compiler from removing the accessor call
+template<class T>
+void escape(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+template<class T>
+void run(std::size_t n) {
+    const std::size_t repetitions = n == 1 ? 1'000'000 : 10'000;
+    ParameterBase<T, si::metre> p(std::vector<T>(n, sample<T>()));
+
+    const double val = time_ns(repetitions, [&] { T v = p.Val(); escape(v); });
+    const double val_ref = time_ns(repetitions, [&] { const T& v = p.ValRef(); escape(v); });
+    const double vals = time_ns(repetitions, [&] { auto v = p.Vals(); escape(v); });
+    const double view = time_ns(repetitions, [&] { auto v = p.View(); escape(v); });
+    std::printf("%-20s n=%-5zu Val %8.2f ns  ValRef %6.2f ns | Vals %10.2f ns  View %6.2f ns\n",
+                type_name<T>(), n, val, val_ref, vals, view);
+}
+
+int main() {
+    boost::mp11::mp_for_each<boost::mp11::mp_transform<boost::mp11::mp_identity, primitive_types>>([](auto id) {
+        using T = typename decltype(id)::type;
+        run<T>(1);
+        run<T>(1000);
+    });
+    return 0;
+}
@@ -0,0 +1,111 @@
+// parameter_alloc_bench.cpp
+// Counts heap allocations made by ParameterBase construction, copies and operator temporaries.
+// The global operator new/delete are replaced by counting versions, so every allocation in the process
+// is seen, including those made inside the standard library.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+#include <methodverse/parameter/parameter.h>
+
+namespace {
+    std::atomic<std::size_t> g_allocations{0};
+
+    void* counted_alloc(std::size_t n, std::size_t align) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (n == 0) n = 1;
+        if (align < alignof(std::max_align_t)) align = alignof(std::max_align_t);
+#ifdef _WIN32
+        void* p = _aligned_malloc(n, align);
+#else
+        void* p = std::aligned_alloc(align, (n + align - 1) / align * align);
+#endif
+        if (!p) throw std::bad_alloc();
+        return p;
+    }
+
+    void counted_free(void* p) noexcept {
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(std::size_t n) { return counted_alloc(n, alignof(std::max_align_t)); }
+void* operator new[](std::size_t n) { return counted_alloc(n, alignof(std::max_align_t)); }
+void* operator new(std::size_t n, std::align_val_t a) { return counted_alloc(n, static_cast<std::size_t>(a)); }
+void* operator new[](std::size_t n, std::align_val_t a) { return counted_alloc(n, static_cast<std::size_t>(a)); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// Run body iterations times and report the allocations per iteration and the time per iteration
+template<class F>
+std::size_t measure(const char* label, std::size_t iterations, F&& body) {
+    const auto allocs_before = g_allocations.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) body(i);
+    const auto t1 = std::chrono::steady_clock::now();
+    const auto allocs = g_allocations.load() - allocs_before;
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+    std::printf("%-40s %10.3f allocs/iter %10.2f ns/iter\n", label,
+                static_cast<double>(allocs) / static_cast<double>(iterations), ns);
+    return allocs;
+}
+
+int main() {
+    constexpr std::size_t iterations = 1'000'000;
+    constexpr auto Hz_per_T = si::hertz / si::tesla;
+    constexpr auto T_per_m = si::tesla / si::metre;
+
+    ParameterBase<double, Hz_per_T> gamma(42.577478461e6);
+    ParameterBase<double, T_per_m> grad_str(10.0);
+    ParameterBase<double, si::second> dt(0.001);
+
+    volatile double sink = 0.0;
+
+    measure("construct scalar", iterations, [&](std::size_t i) {
+        ParameterBase<double, si::second> p(static_cast<double>(i));
+        sink = p.Val();
+    });
+
+    measure("copy scalar", iterations, [&](std::size_t) {
+        ParameterBase<double, si::second> p(dt);
+        sink = p.Val();
+    });
+
+    const auto chain_allocs = measure("gamma * grad_str * dt", iterations, [&](std::size_t) {
+        ParameterBase<double, si::hertz / si::metre * si::second> r = gamma * grad_str * dt;
+        sink = r.Val();
+    });
+
+    measure("construct Matrix3d", iterations, [&](std::size_t) {
+        ParameterBase<Eigen::Matrix3d, si::metre> p(Eigen::Matrix3d::Identity());
+        sink = p.Val()(0, 0);
+    });
+
+    measure("construct 3 doubles (heap)", iterations, [&](std::size_t) {
+        ParameterBase<double, si::metre> p{1.0, 2.0, 3.0};
+        sink = p.Val();
+    });
+
+    (void)sink;
+    return chain_allocs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,54 @@
+// parameter_elementwise_bench.cpp
+// Measures the throughput of the element-wise ParameterBase operators on large value arrays and reports
+// it as bytes moved per second, to be compared with the memory bandwidth of the machine.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// Run body repetitions times and print ns per call and the effective bandwidth for bytes per call
+template<class F>
+void measure(const char* label, std::size_t repetitions, std::size_t bytes, F&& body) {
+    body(); // warm up, first touch of the result buffers
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+    std::printf("%-36s %12.1f ns/op %8.2f GB/s\n", label, ns, static_cast<double>(bytes) / ns);
+}
+
+int main() {
+    constexpr std::size_t n = 100'000;
+    constexpr std::size_t repetitions = 2'000;
+
+    std::vector<double> a(n), b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = 1.0 + static_cast<double>(i);
+        b[i] = 2.0 + static_cast<double>(i % 7);
+    }
+    ParameterBase<double, si::metre> pa(a);
+    ParameterBase<double, si::metre> pb(b);
+    ParameterBase<double, one> scale(0.5);
+
+    volatile double sink = 0.0;
+    measure("add 100k + 100k", repetitions, 3 * n * sizeof(double), [&] { sink = (pa + pb).Eval().Get().back(); });
+    measure("mul 100k * 100k", repetitions, 3 * n * sizeof(double), [&] { sink = (pa * pb).Eval().Get().back(); });
+    measure("div 100k / 100k", repetitions, 3 * n * sizeof(double), [&] { sink = (pa / pb).Eval().Get().back(); });
+    measure("mul 100k * broadcast scalar", repetitions, 2 * n * sizeof(double), [&] { sink = (pa * scale).Eval().Get().back(); });
+
+    // reference: hand-written loop into a preallocated buffer
+    std::vector<double> out(n);
+    measure("raw loop add (reference)", repetitions, 3 * n * sizeof(double), [&] {
+        for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i];
+        sink = out.back();
+    });
+
+    (void)sink;
+    return 0;
+}
@@ -0,0 +1,55 @@
+// parameter_expression_bench.cpp
+// Compares the fused evaluation of lazy ParameterExpr chains against the eager path (EagerApply), which
+// materializes one intermediate ParameterBase per operator.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+void run(std::size_t n, std::size_t repetitions) {
+    constexpr auto Hz_per_T = si::hertz / si::tesla;
+    constexpr auto T_per_m = si::tesla / si::metre;
+
+    std::vector<double> g(n);
+    for (std::size_t i = 0; i < n; ++i) g[i] = 1.0 + static_cast<double>(i % 100);
+    ParameterBase<double, Hz_per_T> gamma(42.577478461e6);
+    ParameterBase<double, T_per_m> grad_str(g);
+    ParameterBase<double, si::second> dt(g);
+    ParameterBase<double, one> scale(0.5);
+
+    volatile double sink = 0.0;
+    const double eager = time_ns(repetitions, [&] {
+        auto r = EagerApply<mul_op>(EagerApply<mul_op>(EagerApply<mul_op>(gamma, grad_str), dt), scale);
+        sink = r.Get().back();
+    });
+    const double fused = time_ns(repetitions, [&] {
+        ParameterBase<double, si::hertz / si::metre * si::second> r = gamma * grad_str * dt * scale;
+        sink = r.Get().back();
+    });
+    (void)sink;
+    std::printf("gamma*grad*dt*scale n=%-8zu eager %12.1f ns  fused %12.1f ns  speedup %5.2fx\n",
+                n, eager, fused, eager / fused);
+}
+
+int main() {
+    run(1, 1'000'000);
+    run(1'000, 100'000);
+    run(100'000, 1'000);
+    run(1'000'000, 100);
+    return 0;
+}
@@ -0,0 +1,66 @@
+// parse_bench.cpp
+// Parses the text of a 1M-element double parameter ("[v1, v2, ...]" as written by ValueAsString()) back
+// into a ParameterBase, and compares with reading the same text through std::istringstream. Values with
+// few digits (typical protocol values) take the exact fast path, random full-precision values (17 digits)
+// mostly fall back to std::from_chars.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <methodverse/parameter/parse.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ms(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+void run(const char* label, const std::vector<double>& values) {
+    const std::string text = ParameterBase<double, si::second>(values).ValueAsString() + " s";
+
+    ParameterBase<double, si::second> p;
+    const double from_chars_ms = time_ms(10, [&] { ParseInto(text, p); });
+
+    std::vector<double> streamed;
+    const double stream_ms = time_ms(3, [&] {
+        streamed.clear();
+        std::istringstream in(text);
+        char c;
+        double v;
+        in >> c; // '['
+        while (in >> v) {
+            streamed.push_back(v);
+            in >> c; // ',' or ']'
+        }
+    });
+
+    const bool same = p.Size() == values.size() && std::equal(values.begin(), values.end(), p.View().begin());
+    std::printf("%-16s %zu doubles, %9zu bytes, round trip %s: ParseInto %8.2f ms, istringstream %8.2f ms (%4.2fx)\n",
+                label, values.size(), text.size(), same ? "exact" : "MISMATCH", from_chars_ms, stream_ms,
+                stream_ms / from_chars_ms);
+}
+
+int main() {
+    constexpr std::size_t count = 1'000'000;
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+    std::vector<double> full(count), short_values(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        full[i] = dist(rng);
+        short_values[i] = static_cast<double>(static_cast<long>(full[i] * 1000)) / 1000; // 3 decimals
+    }
+    run("3 decimals", short_values);
+    run("full precision", full);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// protocol_bench.cpp
+// Compares a protocol held as individually heap-allocated parameters (std::vector<std::unique_ptr<IParameter>>,
+// scattered between other allocations as in a long-running application) with Protocol, which stores the
+// parameters contiguously in a ParameterArena: whole-protocol copy and one pass over all parameters.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include <methodverse/parameter/arena.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// "P0", "P1", ... as compile-time names, so every parameter has its own class and id
+template<std::size_t I>
+consteval auto indexed_name() {
+    std::array<char, 8> s{'P'};
+    std::size_t digits = 1;
+    for (std::size_t v = I; v >= 10; v /= 10) ++digits;
+    for (std::size_t v = I, k = digits; k > 0; v /= 10, --k) s[k] = static_cast<char>('0' + v % 10);
+    return s;
+}
+
+template<std::size_t I>
+using indexed_value_t = std::conditional_t<I % 3 == 0, double, std::conditional_t<I % 3 == 1, Eigen::Vector3d, Eigen::Matrix3d>>;
+
+template<std::size_t I>
+struct Indexed : Parameter<indexed_value_t<I>, Indexed<I>, si::second> {
+    using Parameter<indexed_value_t<I>, Indexed<I>, si::second>::Parameter;
+    static constexpr auto name_storage = indexed_name<I>();
+    static constexpr const char* name = name_storage.data();
+};
+
+template<std::size_t I>
+indexed_value_t<I> initial_value() {
+    if constexpr (I % 3 == 0) return static_cast<double>(I);
+    else if constexpr (I % 3 == 1) return Eigen::Vector3d::Constant(static_cast<double>(I));
+    else return Eigen::Matrix3d::Identity();
+}
+
+// heap baseline: one allocation per parameter plus a clone function to copy the protocol
+struct HeapProtocol {
+    using clone_fn = std::unique_ptr<IParameter> (*)(const IParameter&);
+    std::vector<std::pair<std::unique_ptr<IParameter>, clone_fn>> params;
+
+    HeapProtocol() = default;
+    HeapProtocol(const HeapProtocol& other) {
+        params.reserve(other.params.size());
+        for (const auto& [p, clone] : other.params) params.emplace_back(clone(*p), clone);
+    }
+};
+
+template<std::size_t... I>
+void fill(HeapProtocol& heap, Protocol& protocol, std::vector<std::unique_ptr<char[]>>& noise, std::index_sequence<I...>) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> size(64, 4096);
+    (
+        [&] {
+            noise.push_back(std::make_unique<char[]>(size(rng)));
+            heap.params.emplace_back(std::make_unique<Indexed<I>>(initial_value<I>()), [](const IParameter& p) {
+                return std::unique_ptr<IParameter>(std::make_unique<Indexed<I>>(static_cast<const Indexed<I>&>(p)));
+            });
+            protocol.Emplace<Indexed<I>>(initial_value<I>());
+        }(),
+        ...);
+}
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+double visit(const IParameter& p) {
+    return p.TypeId() == primitive_type_id_v<double> ? p.UncheckedViewAs<double>()[0] : 1.0;
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 300;
+    constexpr std::size_t repetitions = 20'000;
+
+    HeapProtocol heap;
+    Protocol protocol;
+    std::vector<std::unique_ptr<char[]>> noise;
+    fill(heap, protocol, noise, std::make_index_sequence<parameter_count>{});
+
+    volatile double sink = 0.0;
+    const double heap_copy = time_ns(repetitions, [&] {
+        HeapProtocol copy(heap);
+        sink = visit(*copy.params.back().first);
+    });
+    const double arena_copy = time_ns(repetitions, [&] {
+        Protocol copy(protocol);
+        sink = visit(copy[copy.Size() - 1]);
+    });
+    const double heap_iterate = time_ns(repetitions, [&] {
+        double s = 0.0;
+        for (const auto& [p, clone] : heap.params) s += visit(*p);
+        sink = s;
+    });
+    const double arena_iterate = time_ns(repetitions, [&] {
+        double s = 0.0;
+        protocol.ForEach([&](const IParameter& p) { s += visit(p); });
+        sink = s;
+    });
+    (void)sink;
+
+    std::printf("%zu parameters, %zu arena bytes\n", parameter_count, protocol.Arena().BytesUsed());
+    std::printf("copy    heap %10.1f ns  arena %10.1f ns (%4.2fx)\n", heap_copy, arena_copy, heap_copy / arena_copy);
+    std::printf("iterate heap %10.1f ns  arena %10.1f ns (%4.2fx)\n", heap_iterate, arena_iterate,
+                heap_iterate / arena_iterate);
+    return 0;
+}
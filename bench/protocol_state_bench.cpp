@@ -0,0 +1,78 @@
+// protocol_state_bench.cpp
+// Cost of a "what-if" variant of a protocol (copy the protocol, change one parameter): deep copy of every
+// parameter (std::vector of parameters) versus ProtocolState, which shares all unchanged parameters with
+// the original. Also reports the lookup cost of both.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <methodverse/parameter/protocol_state.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Named : ParameterBase<double, si::second> {
+    std::string name;
+    Named(std::string n, std::vector<double> v) : ParameterBase<double, si::second>(v), name(std::move(n)) {}
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 2'000;
+    constexpr std::size_t values_per_parameter = 64;
+    constexpr std::size_t changed = parameter_count / 2;
+
+    std::vector<Named> deep;
+    ProtocolState state;
+    deep.reserve(parameter_count);
+    for (std::size_t i = 0; i < parameter_count; ++i) {
+        std::vector<double> v(values_per_parameter, static_cast<double>(i));
+        deep.emplace_back("Param_" + std::to_string(i), v);
+        state.Set(std::make_shared<const Named>(deep.back()));
+    }
+    const ParameterId changed_id = deep[changed].Id();
+
+    volatile double sink = 0.0;
+    const double deep_variant = time_ns(200, [&] {
+        std::vector<Named> variant(deep);
+        variant[changed].Get()[0] += 1.0;
+        sink = variant[changed].Get()[0];
+    });
+    const double shared_variant = time_ns(20'000, [&] {
+        ProtocolState variant = state;
+        auto p = std::make_shared<Named>(static_cast<const Named&>(*variant.Find(changed_id)));
+        p->Get()[0] += 1.0;
+        variant.Set(std::shared_ptr<const IParameter>(std::move(p)));
+        sink = variant.Find(changed_id)->UncheckedViewAs<double>()[0];
+    });
+    const double snapshot = time_ns(200'000, [&] {
+        ProtocolState copy = state;
+        sink = static_cast<double>(copy.Size());
+    });
+    const double lookup = time_ns(200, [&] {
+        double s = 0.0;
+        for (const auto& p : deep) s += state.Find(p.Id())->UncheckedViewAs<double>()[0];
+        sink = s;
+    }) / parameter_count;
+    (void)sink;
+
+    std::printf("%zu parameters x %zu doubles\n", parameter_count, values_per_parameter);
+    std::printf("variant (copy + change one)  deep %10.1f ns  shared %10.1f ns (%6.1fx)\n", deep_variant,
+                shared_variant, deep_variant / shared_variant);
+    std::printf("snapshot (copy only)                           %10.1f ns\n", snapshot);
+    std::printf("lookup by id                                   %10.1f ns\n", lookup);
+    return 0;
+}
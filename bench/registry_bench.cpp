@@ -0,0 +1,67 @@
+// registry_bench.cpp
+// Compares name-based lookup in a std::unordered_map<std::string, IParameter*> (as protocol maps did with
+// Name()) with ParameterRegistry lookups by compile-time ParameterId and by run-time hashed name.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <methodverse/parameter/registry.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct EchoTime : Parameter<double, EchoTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TE";
+};
+
+// fills the protocol with parameters that have run-time names
+struct Named : ParameterBase<double> {
+    std::string name;
+    explicit Named(std::string n) : name(std::move(n)) {}
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+template<class F>
+void measure(const char* label, std::size_t iterations, F&& body) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) body(i);
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iterations);
+    std::printf("%-44s %8.2f ns/lookup\n", label, ns);
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 2000;
+    constexpr std::size_t iterations = 10'000'000;
+
+    std::vector<Named> params;
+    params.reserve(parameter_count);
+    for (std::size_t i = 0; i < parameter_count; ++i) params.emplace_back("Param_" + std::to_string(i));
+    EchoTime te(0.01);
+
+    std::unordered_map<std::string, IParameter*> by_name;
+    ParameterRegistry registry(parameter_count + 1);
+    for (auto& p : params) {
+        by_name.emplace(p.Name(), &p);
+        registry.Insert(p);
+    }
+    by_name.emplace(te.Name(), &te);
+    registry.Insert(te);
+
+    const IParameter& ref = te;
+    volatile std::size_t sink = 0;
+    measure("unordered_map[Name()]", iterations, [&](std::size_t) { sink = sink + (by_name.find(ref.Name()) != by_name.end()); });
+    measure("unordered_map[std::string(\"TE\")]", iterations, [&](std::size_t) { sink = sink + (by_name.find("TE") != by_name.end()); });
+    measure("ParameterRegistry::Find(EchoTime::id)", iterations, [&](std::size_t) { sink = sink + (registry.Find(EchoTime::id) != nullptr); });
+    measure("ParameterRegistry::Find<EchoTime>()", iterations, [&](std::size_t) { sink = sink + (registry.Find<EchoTime>() != nullptr); });
+    measure("ParameterRegistry::Find(NameView()) mixed", iterations, [&](std::size_t i) {
+        sink = sink + (registry.Find(params[i % parameter_count].NameView()) != nullptr);
+    });
+    (void)sink;
+    return 0;
+}
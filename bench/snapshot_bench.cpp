@@ -0,0 +1,138 @@
+// snapshot_bench.cpp
+// Cold load of a 100 MB protocol library (10000 parameters of 1250 doubles): text file (one
+// "name<TAB>ValueAsString() unit" line per parameter, parsed with ParseValues) versus binary snapshot
+// opened with Snapshot (mmap, values read in place). The page cache of both files is dropped with
+// posix_fadvise before every load, which is best effort: pages may stay cached on some systems.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <methodverse/parameter/parse.h>
+#include <methodverse/parameter/snapshot.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Named : ParameterBase<double, si::second> {
+    std::string name;
+    Named() = default;
+    Named(std::string n, std::vector<double> v) : ParameterBase<double, si::second>(v), name(std::move(n)) {}
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+void drop_cache(const std::string& path) {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+#endif
+}
+
+template<class F>
+double time_ms(const std::string& path, std::size_t repetitions, F&& body) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < repetitions; ++i) {
+        drop_cache(path);
+        const auto t0 = std::chrono::steady_clock::now();
+        body();
+        const auto t1 = std::chrono::steady_clock::now();
+        total += std::chrono::duration<double, std::milli>(t1 - t0).count();
+    }
+    return total / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t parameter_count = 10'000;
+    constexpr std::size_t values_per_parameter = 1'250;
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string text_path = (dir / "methodverse_protocol_library.txt").string();
+    const std::string snapshot_path = (dir / "methodverse_protocol_library.mvps").string();
+
+    {
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        std::vector<Named> library;
+        library.reserve(parameter_count);
+        for (std::size_t i = 0; i < parameter_count; ++i) {
+            std::vector<double> v(values_per_parameter);
+            for (double& x : v) x = std::round(dist(rng) * 1e6) / 1e6;
+            library.emplace_back("Param_" + std::to_string(i), std::move(v));
+        }
+        std::vector<const IParameter*> params;
+        for (const auto& p : library) params.push_back(&p);
+        WriteSnapshot(snapshot_path, params);
+
+        std::ofstream text(text_path, std::ios::binary);
+        fmt::memory_buffer line;
+        for (const auto& p : library) {
+            line.clear();
+            fmt::format_to(fmt::appender(line), "{}\t{:u}\n", p.NameView(), p);
+            text.write(line.data(), static_cast<std::streamsize>(line.size()));
+        }
+    }
+
+    std::vector<std::string> names(parameter_count);
+    for (std::size_t i = 0; i < parameter_count; ++i) names[i] = "Param_" + std::to_string(i);
+
+    volatile double sink = 0.0;
+
+    // text: read the file, parse every parameter
+    std::vector<Named> loaded(parameter_count);
+    const double text_ms = time_ms(text_path, 3, [&] {
+        std::ifstream in(text_path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::string_view rest(contents);
+        for (std::size_t i = 0; i < parameter_count && !rest.empty(); ++i) {
+            const std::size_t tab = rest.find('\t');
+            const std::size_t end = rest.find('\n');
+            loaded[i].name = std::string(rest.substr(0, tab));
+            ParseValues<double, si::second>(rest.substr(tab + 1, end - tab - 1), loaded[i].Get());
+            rest.remove_prefix(end + 1);
+        }
+        sink = loaded.back().Get().back();
+    });
+
+    // snapshot: open and look up every parameter (values are paged in on first access)
+    const double open_ms = time_ms(snapshot_path, 3, [&] {
+        const Snapshot snapshot(snapshot_path);
+        double s = 0.0;
+        for (const auto& n : names) s += snapshot.Find(n)->UncheckedViewAs<double>()[0];
+        sink = s;
+    });
+
+    // snapshot: open and read every value
+    const double read_ms = time_ms(snapshot_path, 3, [&] {
+        const Snapshot snapshot(snapshot_path);
+        double s = 0.0;
+        for (const auto& n : names) {
+            for (double v : snapshot.Find(n)->UncheckedViewAs<double>()) s += v;
+        }
+        sink = s;
+    });
+    (void)sink;
+
+    std::printf("library: %zu parameters x %zu doubles, text %.1f MB, snapshot %.1f MB\n", parameter_count,
+                values_per_parameter, static_cast<double>(std::filesystem::file_size(text_path)) / 1e6,
+                static_cast<double>(std::filesystem::file_size(snapshot_path)) / 1e6);
+    std::printf("text load + parse                 %9.2f ms\n", text_ms);
+    std::printf("snapshot open + find all          %9.2f ms (%6.1fx)\n", open_ms, text_ms / open_ms);
+    std::printf("snapshot open + read every value  %9.2f ms (%6.1fx)\n", read_ms, text_ms / read_ms);
+
+    std::filesystem::remove(text_path);
+    std::filesystem::remove(snapshot_path);
+    return 0;
+}
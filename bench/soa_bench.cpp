@@ -0,0 +1,70 @@
+// soa_bench.cpp
+// Compares AoS (ParameterBase<Eigen::Vector3d>) and SoA (SoaParameter<Eigen::Vector3d>) element-wise dot,
+// cross and coefficient-wise products on gradient direction tables.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <methodverse/parameter/soa.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+void run(std::size_t n) {
+    const std::size_t repetitions = 20'000'000 / n + 1;
+    std::vector<Eigen::Vector3d> a(n), b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double t = static_cast<double>(i);
+        a[i] = Eigen::Vector3d(std::sin(t), std::cos(t), 0.1 * t);
+        b[i] = Eigen::Vector3d(std::cos(t), 0.5, -std::sin(t));
+    }
+    ParameterBase<Eigen::Vector3d, si::metre> aos_a(a), aos_b(b);
+    SoaParameter<Eigen::Vector3d, si::metre> soa_a(a), soa_b(b);
+
+    volatile double sink = 0.0;
+    const double aos_dot = time_ns(repetitions, [&] { sink = EagerApply<dot_op>(aos_a, aos_b).Get().back(); });
+    const double soa_dot = time_ns(repetitions, [&] { sink = Dot(soa_a, soa_b).Get().back(); });
+    const double aos_cross = time_ns(repetitions, [&] { sink = EagerApply<cross_op>(aos_a, aos_b).Get().back().x(); });
+    const double soa_cross = time_ns(repetitions, [&] { sink = Cross(soa_a, soa_b).Get().lane(0)[n - 1]; });
+    const double aos_mul = time_ns(repetitions, [&] { sink = EagerApply<coefw_mul_op>(aos_a, aos_b).Get().back().x(); });
+    const double soa_mul = time_ns(repetitions, [&] { sink = CoefwMul(soa_a, soa_b).Get().lane(0)[n - 1]; });
+
+    // kernels only, into preallocated outputs (no result allocation in the timed region)
+    using cross_policy = op_policy<eigen_colvec_tag, eigen_colvec_tag, cross_op>;
+    std::vector<Eigen::Vector3d> aos_out(n);
+    soa_vector<Eigen::Vector3d> soa_out(n);
+    const double aos_cross_k = time_ns(repetitions, [&] {
+        methodverse::parameter::detail::elementwise<cross_policy>(a.data(), n, b.data(), n, aos_out.data());
+        sink = aos_out.back().x();
+    });
+    const double soa_cross_k = time_ns(repetitions, [&] {
+        soa_kernel<eigen_colvec_tag, cross_op>::run(soa_a.Get(), soa_b.Get(), soa_out, n);
+        sink = soa_out.lane(0)[n - 1];
+    });
+    (void)sink;
+
+    std::printf("n=%-7zu cross kernel only: AoS %10.1f ns SoA %10.1f ns (%4.2fx)\n",
+                n, aos_cross_k, soa_cross_k, aos_cross_k / soa_cross_k);
+    std::printf("n=%-7zu dot AoS %10.1f ns SoA %10.1f ns (%4.2fx) | cross AoS %10.1f ns SoA %10.1f ns (%4.2fx) | "
+                "coefw_mul AoS %10.1f ns SoA %10.1f ns (%4.2fx)\n",
+                n, aos_dot, soa_dot, aos_dot / soa_dot, aos_cross, soa_cross, aos_cross / soa_cross,
+                aos_mul, soa_mul, aos_mul / soa_mul);
+}
+
+int main() {
+    run(64);
+    run(4096);
+    run(65536);
+    return 0;
+}
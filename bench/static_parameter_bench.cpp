@@ -0,0 +1,55 @@
+// static_parameter_bench.cpp
+// Timing constants of a readout derived from hardware constants inside a prepare loop: with ParameterBase the
+// derived values are recomputed (and their temporaries built) on every call, with StaticParameter they are
+// folded at compile time and the loop only reads them.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/static_parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+inline constexpr StaticParameter<double, 1, si::second> grad_raster(10e-6);
+inline constexpr StaticParameter<int, 1> ramp_samples(12);
+inline constexpr StaticParameter<double, 1, si::second> flat_time(1.2e-3);
+inline constexpr StaticParameter<double, 1, si::second> echo_spacing(4e-3);
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t repetitions = 1000000;
+
+    const ParameterBase<double, si::second> raster_dynamic(grad_raster.Val());
+    const ParameterBase<int, one> samples_dynamic(ramp_samples.Val());
+    const ParameterBase<double, si::second> flat_dynamic(flat_time.Val());
+    const ParameterBase<double, si::second> spacing_dynamic(echo_spacing.Val());
+
+    volatile double sink = 0.0;
+    const double dynamic = time_ns(repetitions, [&] {
+        const ParameterBase<double, si::second> ramp = raster_dynamic * samples_dynamic;
+        const ParameterBase<double, si::second> readout = ramp + flat_dynamic + ramp;
+        const ParameterBase<double, si::second> gap = spacing_dynamic - readout;
+        sink = sink + gap.Val();
+    });
+
+    const double folded = time_ns(repetitions, [&] {
+        constexpr auto ramp = grad_raster * ramp_samples;
+        constexpr auto gap = echo_spacing - (ramp + flat_time + ramp);
+        sink = sink + gap.Val();
+    });
+
+    std::printf("derived constants per prepare call: ParameterBase %6.1f ns  StaticParameter %6.1f ns (%5.1fx)\n",
+                dynamic, folded, dynamic / folded);
+    return 0;
+}
@@ -0,0 +1,185 @@
+// bench.h
+// This file defines the small in-house benchmark framework of the methodverse_bench suite. A benchmark is
+// registered with a name, an element count and a setup function; setup prepares the data and returns the
+// body that is timed. The runner calibrates the number of iterations of the body to reach a minimum time,
+// repeats the measurement and reports the median time per iteration, on the console and as JSON for
+// tools/compare_bench.py. Setup runs right before a benchmark, so the data of 1M-element benchmarks is not
+// held for the whole suite.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+
+namespace methodverse::bench {
+
+    // ---- keep a value (or the memory it points to) alive for the optimizer
+    template<class T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // element counts every benchmark of the suite runs at
+    inline constexpr std::size_t suite_sizes[] = {1, 1'000, 1'000'000};
+
+    using BenchmarkBody = std::function<void()>;
+    using BenchmarkSetup = std::function<BenchmarkBody()>;
+
+    struct Benchmark {
+        std::string name; // "group/case/..."; the size is appended when reported
+        std::size_t size;
+        BenchmarkSetup setup;
+    };
+
+    struct Result {
+        std::string name;
+        std::size_t size;
+        std::size_t iterations;
+        double ns_per_iteration; // median of the repetitions
+        double ns_min;
+        double ns_max;
+    };
+
+    struct Options {
+        double min_time_s = 0.05;
+        int repetitions = 3;
+        std::string filter;      // ECMAScript regex on "name/size"
+        std::string json_path;   // write the results as JSON when not empty
+        bool list_only = false;
+    };
+
+    // ======== Registry ========
+    class Registry {
+    public:
+        void Add(std::string name, std::size_t size, BenchmarkSetup setup) {
+            benchmarks_.push_back({std::move(name), size, std::move(setup)});
+        }
+
+        // Add(name, size, setup(size)) for every size of suite_sizes
+        template<class Setup>
+        void AddSizes(const std::string& name, Setup setup) {
+            for (std::size_t n : suite_sizes) Add(name, n, [setup, n] { return setup(n); });
+        }
+
+        [[nodiscard]] const std::vector<Benchmark>& Benchmarks() const noexcept { return benchmarks_; }
+
+    private:
+        std::vector<Benchmark> benchmarks_;
+    };
+
+    [[nodiscard]] inline std::string FullName(const std::string& name, std::size_t size) {
+        return fmt::format("{}/{}", name, size);
+    }
+
+    // ======== Runner ========
+    [[nodiscard]] inline Result Run(const Benchmark& benchmark, const Options& options) {
+        using clock = std::chrono::steady_clock;
+        const BenchmarkBody body = benchmark.setup();
+        auto time_s = [&](std::size_t iterations) {
+            const auto t0 = clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) body();
+            return std::chrono::duration<double>(clock::now() - t0).count();
+        };
+
+        // calibrate: grow the iteration count until one batch takes min_time_s
+        std::size_t iterations = 1;
+        double elapsed = time_s(iterations);
+        while (elapsed < options.min_time_s && iterations < (std::size_t{1} << 40)) {
+            const double factor = elapsed > 0 ? std::min(10.0, 1.4 * options.min_time_s / elapsed) : 10.0;
+            iterations = std::max(iterations + 1, static_cast<std::size_t>(static_cast<double>(iterations) * factor));
+            elapsed = time_s(iterations);
+        }
+
+        std::vector<double> ns;
+        for (int r = 0; r < std::max(1, options.repetitions); ++r) {
+            ns.push_back(time_s(iterations) * 1e9 / static_cast<double>(iterations));
+        }
+        std::sort(ns.begin(), ns.end());
+        return {benchmark.name, benchmark.size, iterations, ns[ns.size() / 2], ns.front(), ns.back()};
+    }
+
+    inline void WriteJson(const std::string& path, const std::vector<Result>& results, const Options& options) {
+        fmt::memory_buffer out;
+        auto it = fmt::appender(out);
+        fmt::format_to(it, "{{\n  \"context\": {{\n");
+        fmt::format_to(it, "    \"compiler\": \"{}\",\n",
+#if defined(__clang__)
+                       fmt::format("clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__)
+#elif defined(__GNUC__)
+                       fmt::format("gcc {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__)
+#elif defined(_MSC_VER)
+                       fmt::format("msvc {}", _MSC_VER)
+#else
+                       "unknown"
+#endif
+        );
+#if defined(NDEBUG)
+        fmt::format_to(it, "    \"assertions\": false,\n");
+#else
+        fmt::format_to(it, "    \"assertions\": true,\n");
+#endif
+        fmt::format_to(it, "    \"min_time_s\": {},\n    \"repetitions\": {}\n  }},\n", options.min_time_s,
+                       options.repetitions);
+        fmt::format_to(it, "  \"benchmarks\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            fmt::format_to(it,
+                           "    {{\"name\": \"{}\", \"size\": {}, \"iterations\": {}, \"ns_per_iteration\": {:.6g}, "
+                           "\"ns_min\": {:.6g}, \"ns_max\": {:.6g}, \"ns_per_element\": {:.6g}}}{}\n",
+                           FullName(r.name, r.size), r.size, r.iterations, r.ns_per_iteration, r.ns_min, r.ns_max,
+                           r.ns_per_iteration / static_cast<double>(std::max<std::size_t>(1, r.size)),
+                           i + 1 < results.size() ? "," : "");
+        }
+        fmt::format_to(it, "  ]\n}}\n");
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", path.c_str());
+            return;
+        }
+        std::fwrite(out.data(), 1, out.size(), file);
+        std::fclose(file);
+    }
+
+    // Run the selected benchmarks and print one line per benchmark; returns the results
+    inline std::vector<Result> RunAll(const Registry& registry, const Options& options) {
+        const std::regex filter(options.filter.empty() ? ".*" : options.filter);
+        std::vector<Result> results;
+        for (const Benchmark& b : registry.Benchmarks()) {
+            const std::string full = FullName(b.name, b.size);
+            if (!std::regex_search(full, filter)) continue;
+            if (options.list_only) {
+                std::printf("%s\n", full.c_str());
+                continue;
+            }
+            const Result r = Run(b, options);
+            std::printf("%-60s %14.1f ns %10.3f ns/elem %12zu it\n", full.c_str(), r.ns_per_iteration,
+                        r.ns_per_iteration / static_cast<double>(std::max<std::size_t>(1, r.size)), r.iterations);
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+        if (!options.json_path.empty() && !options.list_only) WriteJson(options.json_path, results, options);
+        return results;
+    }
+
+    // ---- suites, one per file of bench/suite
+    void RegisterParameterBenchmarks(Registry& registry); // construction, copy, move, Val, Vals, ValueAsString
+    void RegisterOperatorBenchmarks(Registry& registry);  // every enabled op_policy binary op
+    void RegisterUnitBenchmarks(Registry& registry);      // compile-time and run-time unit algebra
+
+} // namespace methodverse::bench
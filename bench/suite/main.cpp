@@ -0,0 +1,49 @@
+// main.cpp
+// methodverse_bench: runs the microbenchmark suite of the parameter library at 1, 1k and 1M elements.
+//
+//     methodverse_bench [--filter <regex>] [--json <file>] [--min-time <s>] [--repetitions <n>] [--list]
+//
+// Compare two JSON files with tools/compare_bench.py.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include "bench.h"
+
+using namespace methodverse::bench;
+
+namespace {
+
+    void print_usage() {
+        std::printf("usage: methodverse_bench [--filter <regex>] [--json <file>] [--min-time <s>] "
+                    "[--repetitions <n>] [--list]\n");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value) options.filter = argv[++i];
+        else if (arg == "--json" && has_value) options.json_path = argv[++i];
+        else if (arg == "--min-time" && has_value) options.min_time_s = std::atof(argv[++i]);
+        else if (arg == "--repetitions" && has_value) options.repetitions = std::atoi(argv[++i]);
+        else if (arg == "--list") options.list_only = true;
+        else {
+            print_usage();
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    Registry registry;
+    RegisterParameterBenchmarks(registry);
+    RegisterOperatorBenchmarks(registry);
+    RegisterUnitBenchmarks(registry);
+    RunAll(registry, options);
+    return 0;
+}
@@ -0,0 +1,51 @@
+// operator_suite.cpp
+// Every binary op of dispatch_ops on every pair of primitive_types whose op_policy is enabled (the entries
+// of the DynamicApply table), computed by EagerApply on two operands of the same size, so the time is one
+// materialized element-wise pass.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <boost/mp11/algorithm.hpp>
+#include <methodverse/parameter/dispatch.h>
+#include "bench.h"
+#include "values.h"
+
+namespace methodverse::bench {
+
+    using namespace methodverse::parameter;
+
+    // benchmark names of dispatch_ops; dispatch_op_names uses operator symbols that are awkward in --filter
+    inline constexpr std::array<std::string_view, dispatch_op_count> op_bench_names{
+        "add", "sub", "mul", "div", "coefw_mul", "coefw_div", "dot", "cross", "and", "or", "xor", "xnor"};
+
+    template<class Op, class T1, class T2>
+    void register_op(Registry& registry) {
+        using P1 = ParameterBase<T1, mp_units::one>;
+        using P2 = ParameterBase<T2, mp_units::one>;
+        const std::string name = "op/" + std::string(op_bench_names[dispatch_op_id_v<Op>]) + "/" +
+                                 std::string(primitive_type_names[primitive_type_id_v<T1>]) + "," +
+                                 std::string(primitive_type_names[primitive_type_id_v<T2>]);
+        registry.AddSizes(name, [](std::size_t n) -> BenchmarkBody {
+            auto lhs = std::make_shared<const P1>(MakeValues<T1>(n));
+            auto rhs = std::make_shared<const P2>(MakeValues<T2>(n));
+            return [lhs, rhs] { DoNotOptimize(EagerApply<Op>(*lhs, *rhs)); };
+        });
+    }
+
+    void RegisterOperatorBenchmarks(Registry& registry) {
+        using namespace boost::mp11;
+        mp_for_each<mp_product<mp_list, dispatch_ops, primitive_types, primitive_types>>([&](auto combination) {
+            using Op = mp_at_c<decltype(combination), 0>;
+            using T1 = mp_at_c<decltype(combination), 1>;
+            using T2 = mp_at_c<decltype(combination), 2>;
+            if constexpr (detail::dispatch_enabled<Op, T1, T2>) { // the filter of the DynamicApply table
+                register_op<Op, T1, T2>(registry);
+            }
+        });
+    }
+
+} // namespace methodverse::bench
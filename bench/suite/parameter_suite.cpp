@@ -0,0 +1,65 @@
+// parameter_suite.cpp
+// Construction, copy and move of ParameterBase<T, one> for every type of primitive_types, and the value
+// accessors Val(), Vals() and ValueAsString(). The move benchmark moves the parameter out and back in, so
+// one iteration is a move construction and a move assignment.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <memory>
+#include <string>
+#include <boost/mp11/algorithm.hpp>
+#include <methodverse/parameter/parameter.h>
+#include "bench.h"
+#include "values.h"
+
+namespace methodverse::bench {
+
+    using namespace methodverse::parameter;
+
+    template<class T>
+    void register_parameter_type(Registry& registry) {
+        using P = ParameterBase<T, mp_units::one>;
+        const std::string type(primitive_type_names[primitive_type_id_v<T>]);
+
+        registry.AddSizes("construct/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto values = std::make_shared<const std::vector<T>>(MakeValues<T>(n));
+            return [values] {
+                P p(*values);
+                DoNotOptimize(p);
+            };
+        });
+        registry.AddSizes("copy/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto source = std::make_shared<const P>(MakeValues<T>(n));
+            return [source] {
+                P p(*source);
+                DoNotOptimize(p);
+            };
+        });
+        registry.AddSizes("move/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto source = std::make_shared<P>(MakeValues<T>(n));
+            return [source] {
+                P moved(std::move(*source));
+                DoNotOptimize(moved);
+                *source = std::move(moved);
+            };
+        });
+        registry.AddSizes("Val/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto source = std::make_shared<const P>(MakeValues<T>(n));
+            return [source] { DoNotOptimize(source->Val()); };
+        });
+        registry.AddSizes("Vals/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto source = std::make_shared<const P>(MakeValues<T>(n));
+            return [source] { DoNotOptimize(source->Vals()); };
+        });
+        registry.AddSizes("ValueAsString/" + type, [](std::size_t n) -> BenchmarkBody {
+            auto source = std::make_shared<const P>(MakeValues<T>(n));
+            return [source] { DoNotOptimize(source->ValueAsString()); };
+        });
+    }
+
+    void RegisterParameterBenchmarks(Registry& registry) {
+        boost::mp11::mp_for_each<boost::mp11::mp_transform<std::type_identity, primitive_types>>(
+            [&](auto type) { register_parameter_type<typename decltype(type)::type>(registry); });
+    }
+
+} // namespace methodverse::bench
@@ -0,0 +1,83 @@
+// unit_suite.cpp
+// The unit-algebra paths: the phase gamma * G * t (Hz/T * mT * s) as a fused expression with the unit
+// computed at compile time and as two EagerApply steps, the same product through DynamicApply with the
+// RuntimeUnit carried by the type-erased operands, a unit-checked division, and the RuntimeUnit algebra
+// alone (GetRuntimeUnit(), *, / and ==), whose cost does not depend on the element count.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <memory>
+#include <stdexcept>
+#include <methodverse/parameter/dispatch.h>
+#include "bench.h"
+#include "values.h"
+
+namespace methodverse::bench {
+
+    using namespace methodverse::parameter;
+    using namespace mp_units;
+
+    namespace {
+
+        using Gyromagnetic = ParameterBase<double, si::hertz / si::tesla>;
+        using Gradient = ParameterBase<double, si::milli<si::tesla>>;
+        using Duration = ParameterBase<double, si::second>;
+        using Position = ParameterBase<Eigen::Vector3d, si::metre>;
+
+        struct phase_operands {
+            Gyromagnetic gamma;
+            Gradient gradient;
+            Duration duration;
+
+            explicit phase_operands(std::size_t n)
+                : gamma(std::vector<double>(n, 42.577e6)), gradient(MakeValues<double>(n)),
+                  duration(std::vector<double>(n, 1e-3)) {}
+        };
+
+    } // namespace
+
+    void RegisterUnitBenchmarks(Registry& registry) {
+        registry.AddSizes("units/fused_expr/phase", [](std::size_t n) -> BenchmarkBody {
+            auto x = std::make_shared<const phase_operands>(n);
+            return [x] { DoNotOptimize((x->gamma * x->gradient * x->duration).Eval()); };
+        });
+        registry.AddSizes("units/eager/phase", [](std::size_t n) -> BenchmarkBody {
+            auto x = std::make_shared<const phase_operands>(n);
+            return [x] {
+                DoNotOptimize(EagerApply<mul_op>(EagerApply<mul_op>(x->gamma, x->gradient), x->duration));
+            };
+        });
+        registry.AddSizes("units/dynamic_apply/phase", [](std::size_t n) -> BenchmarkBody {
+            auto x = std::make_shared<const phase_operands>(n);
+            return [x] {
+                const IParameter& gamma = x->gamma;
+                const IParameter& gradient = x->gradient;
+                const IParameter& duration = x->duration;
+                DoNotOptimize(DynamicApply<mul_op>(*DynamicApply<mul_op>(gamma, gradient), duration));
+            };
+        });
+        registry.AddSizes("units/dynamic_apply/velocity", [](std::size_t n) -> BenchmarkBody {
+            auto position = std::make_shared<const Position>(MakeValues<Eigen::Vector3d>(n));
+            auto duration = std::make_shared<const Duration>(MakeValues<double>(n));
+            return [position, duration] {
+                DoNotOptimize(DynamicApply<div_op>(static_cast<const IParameter&>(*position),
+                                                   static_cast<const IParameter&>(*duration)));
+            };
+        });
+        registry.AddSizes("units/runtime_unit/phase", [](std::size_t n) -> BenchmarkBody {
+            auto x = std::make_shared<const phase_operands>(n);
+            return [x] {
+                const IParameter& gamma = x->gamma;
+                const IParameter& gradient = x->gradient;
+                const IParameter& duration = x->duration;
+                const RuntimeUnit unit = gamma.GetRuntimeUnit() * gradient.GetRuntimeUnit() * duration.GetRuntimeUnit();
+                const bool same = unit == runtime_unit_of<si::hertz * si::milli<si::tesla> / si::tesla * si::second>;
+                if (!same || unit == gamma.GetRuntimeUnit() / duration.GetRuntimeUnit()) {
+                    throw std::logic_error("units/runtime_unit/phase: unexpected unit");
+                }
+                DoNotOptimize(unit);
+            };
+        });
+    }
+
+} // namespace methodverse::bench
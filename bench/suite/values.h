@@ -0,0 +1,47 @@
+// values.h
+// Deterministic test values of the primitive types for the methodverse_bench suites. Values are non-zero
+// (division), bounded (integer multiplication does not overflow), matrices are invertible and quaternions
+// are normalized, so every enabled op works on them. Waveforms are non-zero ramps of the same length.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fmt/format.h>
+#include <methodverse/parameter/waveform.h>
+
+namespace methodverse::bench {
+
+    // samples per waveform value (VectorXd, ArrayXd, ...), a short gradient ramp
+    inline constexpr Eigen::Index waveform_samples = 64;
+
+    template<class T>
+    [[nodiscard]] T MakeValue(std::size_t i) {
+        const double x = 1.0 + static_cast<double>(i % 997) * 1e-3;
+        if constexpr (std::is_same_v<T, bool>) return i % 2 == 0;
+        else if constexpr (std::is_same_v<T, std::string>) return fmt::format("v{}", i % 997);
+        else if constexpr (std::is_same_v<T, int>) return static_cast<int>(i % 997) + 1;
+        else if constexpr (std::is_same_v<T, double>) return x;
+        else if constexpr (std::is_same_v<T, Eigen::Vector3d> || std::is_same_v<T, Eigen::RowVector3d>) return T(x, 2 * x, 3 * x);
+        else if constexpr (std::is_same_v<T, Eigen::Matrix3d>) return Eigen::Matrix3d::Constant(0.1 * x) + Eigen::Matrix3d::Identity();
+        else if constexpr (std::is_same_v<T, Eigen::Quaterniond>) return Eigen::Quaterniond(x, 0.1, 0.2, 0.3).normalized();
+        else if constexpr (parameter::waveform_type<T>) {
+            using S = typename T::Scalar; // a ramp of waveform_samples samples
+            return T::LinSpaced(waveform_samples, static_cast<S>(x), static_cast<S>(2 * x));
+        }
+        else static_assert(parameter::always_false<T>, "MakeValue: not a primitive type");
+    }
+
+    template<class T>
+    [[nodiscard]] std::vector<T> MakeValues(std::size_t n) {
+        std::vector<T> values;
+        values.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) values.push_back(MakeValue<T>(i));
+        return values;
+    }
+
+} // namespace methodverse::bench
@@ -0,0 +1,109 @@
+// sweep_bench.cpp
+// Throughput of Sweep over TE x TR x flip angle x matrix size (480000 points) with a timing check and a
+// signal model evaluated at each point, results streamed to a sink that keeps the best point. Compares the
+// sequential ForEach with Run on 1, 2, 4, ... threads up to the number of hardware threads (at least 4).
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <methodverse/parameter/sweep.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct EchoTime : Parameter<double, EchoTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TE";
+};
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct FlipAngle : Parameter<double, FlipAngle, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "FlipAngle";
+};
+
+struct MatrixSize : Parameter<int, MatrixSize, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "MatrixSize";
+};
+
+struct Evaluation {
+    bool feasible;
+    double signal;
+};
+
+// timing check (echo and readout fit in TR) and spoiled gradient echo signal for T1 = 1 s, T2* = 50 ms
+Evaluation evaluate(const EchoTime& te, const RepetitionTime& tr, const FlipAngle& fa, const MatrixSize& matrix) {
+    constexpr double dwell = 5e-6;
+    const double readout = matrix.Val() * dwell;
+    const bool feasible = te.Val() + readout / 2 + 1e-3 <= tr.Val() && te.Val() >= readout / 2;
+    const double e1 = std::exp(-tr.Val() / 1.0);
+    const double alpha = fa.Val() * 3.141592653589793 / 180.0;
+    const double signal = std::sin(alpha) * (1 - e1) / (1 - std::cos(alpha) * e1) * std::exp(-te.Val() / 0.05) *
+                          std::sqrt(tr.Val() / matrix.Val());
+    return {feasible, feasible ? signal : 0.0};
+}
+
+std::vector<double> linspace(double first, double last, std::size_t n) {
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = first + (last - first) * static_cast<double>(i) / static_cast<double>(n - 1);
+    }
+    return v;
+}
+
+template<class F>
+double time_ms(F&& body) {
+    const auto t0 = std::chrono::steady_clock::now();
+    body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main() {
+    const Sweep sweep{EchoTime(linspace(1e-3, 20e-3, 40)), RepetitionTime(linspace(5e-3, 100e-3, 40)),
+                      FlipAngle(linspace(2.0, 60.0, 30)),
+                      MatrixSize(std::vector<int>{64, 96, 128, 160, 192, 224, 256, 320, 384, 512})};
+    std::printf("%zu points\n", sweep.Size());
+
+    double best_sequential = 0.0;
+    const double sequential = time_ms([&] {
+        sweep.ForEach([&](const EchoTime& te, const RepetitionTime& tr, const FlipAngle& fa, const MatrixSize& m) {
+            const Evaluation e = evaluate(te, tr, fa, m);
+            if (e.signal > best_sequential) best_sequential = e.signal;
+        });
+    });
+    std::printf("ForEach (sequential)  %8.2f ms  %6.1f Mpoints/s\n", sequential,
+                static_cast<double>(sweep.Size()) / sequential / 1e3);
+
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    double single = 0.0;
+    for (std::size_t threads = 1; threads <= std::max<std::size_t>(hardware, 4); threads *= 2) {
+        double best = 0.0;
+        std::size_t best_index = 0;
+        const double ms = time_ms([&] {
+            sweep.Run(evaluate,
+                      [&](std::size_t index, const Evaluation& e) {
+                          if (e.signal > best) {
+                              best = e.signal;
+                              best_index = index;
+                          }
+                      },
+                      SweepOptions{.threads = threads, .grain = 256});
+        });
+        if (threads == 1) single = ms;
+        std::printf("Run %3zu threads        %8.2f ms  %6.1f Mpoints/s  speedup %5.2f  (best %.4g at %zu%s)\n", threads,
+                    ms, static_cast<double>(sweep.Size()) / ms / 1e3, single / ms, best, best_index,
+                    best == best_sequential ? "" : ", MISMATCH");
+    }
+    return 0;
+}
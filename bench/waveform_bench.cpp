@@ -0,0 +1,73 @@
+// waveform_bench.cpp
+// Gradient waveform workload: 64 waveforms of 1024 samples combined as (shape + offset) * gain - baseline.
+// Compares hand-written Eigen on std::vector<Eigen::VectorXd> with the fused ParameterExpr of the same formula,
+// which nests the lazy() expressions of the waveform policies, and with one EagerApply per operator, which
+// materializes a temporary waveform per step.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+template<class F>
+double time_ns(std::size_t repetitions, F&& body) {
+    body(); // warm up
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < repetitions; ++i) body();
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(repetitions);
+}
+
+int main() {
+    constexpr std::size_t waveforms = 64;
+    constexpr Eigen::Index samples = 1024;
+    constexpr std::size_t repetitions = 2000;
+
+    std::vector<Eigen::VectorXd> shapes, offsets, baselines;
+    for (std::size_t i = 0; i < waveforms; ++i) {
+        shapes.push_back(Eigen::VectorXd::LinSpaced(samples, 0.0, 1.0 + static_cast<double>(i)));
+        offsets.push_back(Eigen::VectorXd::Constant(samples, 0.01 * static_cast<double>(i)));
+        baselines.push_back(Eigen::VectorXd::LinSpaced(samples, 1e-3, 2e-3));
+    }
+    const double gain_value = 0.8;
+
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> shape(shapes);
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> offset(offsets);
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> baseline(baselines);
+    const ParameterBase<double, one> gain(gain_value);
+
+    double sink = 0.0;
+    std::vector<Eigen::VectorXd> raw(waveforms);
+    const double t_eigen = time_ns(repetitions, [&] {
+        for (std::size_t i = 0; i < waveforms; ++i) {
+            raw[i] = ((shapes[i].array() + offsets[i].array()) * gain_value - baselines[i].array()).matrix();
+        }
+        sink += raw[waveforms - 1][samples - 1];
+    });
+
+    ParameterBase<Eigen::VectorXd, si::tesla / si::metre> fused;
+    const double t_fused = time_ns(repetitions, [&] {
+        fused = (shape + offset) * gain - baseline;
+        sink += fused[waveforms - 1][samples - 1];
+    });
+
+    const double t_eager = time_ns(repetitions, [&] {
+        const auto sum = EagerApply<add_op>(shape, offset);
+        const auto scaled = EagerApply<mul_op>(sum, gain);
+        const auto result = EagerApply<sub_op>(scaled, baseline);
+        sink += result[waveforms - 1][samples - 1];
+    });
+
+    if (!raw[7].isApprox(fused[7])) std::printf("mismatch\n");
+    std::printf("%zu waveforms x %ld samples, (shape + offset) * gain - baseline\n", waveforms, static_cast<long>(samples));
+    std::printf("  raw Eigen on std::vector<VectorXd>  %10.0f ns\n", t_eigen);
+    std::printf("  fused ParameterExpr                 %10.0f ns  (%.2fx raw Eigen)\n", t_fused, t_fused / t_eigen);
+    std::printf("  EagerApply per operator             %10.0f ns  (%.2fx raw Eigen)\n", t_eager, t_eager / t_eigen);
+    std::printf("(sink %g)\n", sink);
+    return 0;
+}
@@ -0,0 +1,259 @@
+// any_parameter.h
+// This file defines ParameterValue and AnyParameter, a closed-set alternative to IParameter for type-erased
+// code. primitive_types is a closed list, so the values of any parameter fit in a std::variant generated from
+// it: ParameterValue has one alternative per primitive type, the same storage as ParameterBase, in the order of
+// primitive_types (index() == TypeId()). AnyParameter holds the id, name, unit and ParameterValue by value, so
+// a std::vector<AnyParameter> stores a protocol contiguously with no allocation per scalar parameter, and
+// Visit() dispatches through std::visit, a switch over the alternatives the compiler can inline into, instead
+// of virtual calls.
+// Protocol-wide passes work on spans of AnyParameter: FindNonFinite (validation), FormatParametersTo
+// (serialization as "name = value unit" lines) and DiffParameters.
+//     std::vector<AnyParameter> state{AnyParameter(te), AnyParameter(tr)};
+//     auto changes = DiffParameters(before, state);
+// AnyParameter owns a copy of the name, so it outlives its source (e.g. a snapshot parameter); names that do not
+// fit the small-string buffer of std::string allocate.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+namespace detail {
+
+    template<class T>
+    using value_storage_t = small_vector<T, inline_capacity_v<T>>;
+
+} // namespace detail
+
+    // ---- values of any primitive type; the alternative index is the TypeId() of the value type
+    using ParameterValue =
+        boost::mp11::mp_rename<boost::mp11::mp_transform<detail::value_storage_t, primitive_types>, std::variant>;
+
+    static_assert(std::variant_size_v<ParameterValue> == primitive_type_count);
+
+    // ======== AnyParameter: a parameter of any primitive type, by value ========
+    class AnyParameter {
+    public:
+        AnyParameter() = default;
+
+        AnyParameter(ParameterId id, std::string name, RuntimeUnit unit, ParameterValue value)
+            : id_(id), name_(std::move(name)), unit_(unit), value_(std::move(value)) {}
+
+        // From a ParameterBase or Parameter of a primitive type; copies the values
+        template<class P>
+        requires (parameter_like<P> && is_allowed_primitive<typename P::value_type>)
+        explicit AnyParameter(const P& p)
+            : id_(p.Id()), name_(p.NameView()), unit_(p.GetRuntimeUnit()),
+              value_(std::in_place_index<primitive_type_id_v<typename P::value_type>>, p.Get()) {}
+
+        // From a type-erased parameter through TypeId() and ViewAs<T>(); throws std::invalid_argument if its
+        // values are not stored as an array of a primitive type
+        [[nodiscard]] static AnyParameter From(const IParameter& p) {
+            const std::size_t type = p.TypeId();
+            if (type >= primitive_type_count) {
+                throw std::invalid_argument("AnyParameter::From: " + p.Name() + " does not store a primitive value type");
+            }
+            return boost::mp11::mp_with_index<primitive_type_count>(type, [&](auto I) {
+                using T = boost::mp11::mp_at_c<primitive_types, I>;
+                const auto values = p.UncheckedViewAs<T>();
+                return AnyParameter(p.Id(), std::string(p.NameView()), p.GetRuntimeUnit(),
+                                    ParameterValue(std::in_place_index<I>, values.begin(), values.end()));
+            });
+        }
+
+        // ---- same accessors as IParameter
+        [[nodiscard]] ParameterId Id() const noexcept { return id_; }
+        [[nodiscard]] std::string_view NameView() const noexcept { return name_; }
+        [[nodiscard]] RuntimeUnit GetRuntimeUnit() const noexcept { return unit_; }
+        [[nodiscard]] std::size_t TypeId() const noexcept { return value_.index(); }
+        [[nodiscard]] std::size_t Size() const noexcept {
+            return std::visit([](const auto& values) { return values.size(); }, value_);
+        }
+
+        [[nodiscard]] const ParameterValue& Value() const noexcept { return value_; }
+        [[nodiscard]] ParameterValue& Value() noexcept { return value_; }
+
+        // Zero-copy view of the values as T; throws std::bad_cast if T is not the value type (as IParameter)
+        template<class T>
+        [[nodiscard]] std::span<const T> ViewAs() const {
+            const auto* values = std::get_if<detail::value_storage_t<T>>(&value_);
+            if (values == nullptr) throw std::bad_cast();
+            return {values->data(), values->size()};
+        }
+
+        // f(std::span<const T>) for the value type T
+        template<class F>
+        decltype(auto) Visit(F&& f) const {
+            return std::visit([&](const auto& values) -> decltype(auto) {
+                using T = typename std::remove_cvref_t<decltype(values)>::value_type;
+                return f(std::span<const T>(values.data(), values.size()));
+            }, value_);
+        }
+
+        [[nodiscard]] std::string ValueAsString() const {
+            return Visit([](auto values) { return detail::values_to_string(values); });
+        }
+
+        void FormatValueTo(fmt::memory_buffer& out) const {
+            Visit([&](auto values) { detail::format_values_to(out, values); });
+        }
+
+        // Copy the values into a parameter of the same value type and unit; throws std::invalid_argument otherwise
+        template<class P>
+        requires parameter_like<P>
+        void AssignTo(P& p) const {
+            using T = typename P::value_type;
+            const auto* values = std::get_if<detail::value_storage_t<T>>(&value_);
+            if (values == nullptr || unit_ != runtime_unit_of<P::GetUnit()>) {
+                throw std::invalid_argument("AnyParameter::AssignTo: " + std::string(name_) +
+                                            " has a different value type or unit than " + std::string(p.NameView()));
+            }
+            p.Set(*values);
+        }
+
+        // Same id, unit and values
+        [[nodiscard]] friend bool operator==(const AnyParameter& lhs, const AnyParameter& rhs) {
+            return lhs.id_ == rhs.id_ && lhs.unit_ == rhs.unit_ && lhs.value_.index() == rhs.value_.index() &&
+                   std::visit([](const auto& a, const auto& b) {
+                       if constexpr (std::is_same_v<decltype(a), decltype(b)>) return detail::values_equal(a, b);
+                       else return false; // not reached, the indices are equal
+                   }, lhs.value_, rhs.value_);
+        }
+
+    private:
+        ParameterId id_;
+        std::string name_;
+        RuntimeUnit unit_;
+        ParameterValue value_;
+    };
+
+namespace detail {
+
+    template<class T>
+    bool finite_value(const T& v) {
+        if constexpr (std::is_floating_point_v<T>) return std::isfinite(v);
+        else if constexpr (std::is_same_v<T, Eigen::Quaterniond>) return v.coeffs().allFinite();
+        else if constexpr (std::is_base_of_v<Eigen::DenseBase<T>, T>) return v.allFinite();
+        else return true;
+    }
+
+    // equality for change detection: NaN equals NaN, so a parameter holding NaN is not reported as changed on
+    // every pass
+    template<class T>
+    bool same_value(const T& a, const T& b) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return a == b || (std::isnan(a) && std::isnan(b));
+        } else if constexpr (std::is_same_v<T, Eigen::Quaterniond>) {
+            return same_value(Eigen::Vector4d(a.coeffs()), Eigen::Vector4d(b.coeffs()));
+        } else if constexpr (std::is_base_of_v<Eigen::DenseBase<T>, T>) {
+            return a.rows() == b.rows() && a.cols() == b.cols() &&
+                   ((a.array() == b.array()) || (a.array().isNaN() && b.array().isNaN())).all();
+        } else {
+            return a == b;
+        }
+    }
+
+    inline bool same_values(const AnyParameter& lhs, const AnyParameter& rhs) {
+        return lhs.Id() == rhs.Id() && lhs.GetRuntimeUnit() == rhs.GetRuntimeUnit() && lhs.TypeId() == rhs.TypeId() &&
+               std::visit([](const auto& a, const auto& b) {
+                   if constexpr (std::is_same_v<decltype(a), decltype(b)>) {
+                       return std::ranges::equal(a, b, [](const auto& x, const auto& y) { return same_value(x, y); });
+                   } else {
+                       return false; // not reached, the indices are equal
+                   }
+               }, lhs.Value(), rhs.Value());
+    }
+
+    // indices of parameters sorted by id
+    inline std::vector<std::size_t> order_by_id(std::span<const AnyParameter> parameters) {
+        std::vector<std::size_t> order(parameters.size());
+        for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return parameters[a].Id().value < parameters[b].Id().value;
+        });
+        return order;
+    }
+
+} // namespace detail
+
+    // ---- validation: ids of the parameters with a NaN or infinite value, in order
+    [[nodiscard]] inline std::vector<ParameterId> FindNonFinite(std::span<const AnyParameter> parameters) {
+        std::vector<ParameterId> invalid;
+        for (const AnyParameter& p : parameters) {
+            const bool finite = p.Visit([](auto values) {
+                return std::all_of(values.begin(), values.end(), [](const auto& v) { return detail::finite_value(v); });
+            });
+            if (!finite) invalid.push_back(p.Id());
+        }
+        return invalid;
+    }
+
+    // ---- serialization: one "name = value unit" line per parameter (the value as ValueAsString(), the unit as
+    // RuntimeUnit::ToString(), omitted for dimensionless parameters)
+    inline void FormatParametersTo(fmt::memory_buffer& out, std::span<const AnyParameter> parameters) {
+        for (const AnyParameter& p : parameters) {
+            out.append(p.NameView());
+            out.append(std::string_view(" = "));
+            p.FormatValueTo(out);
+            const RuntimeUnit unit = p.GetRuntimeUnit();
+            if (!unit.IsDimensionless() || unit.magnitude != 1.0) {
+                out.push_back(' ');
+                out.append(unit.ToString());
+            }
+            out.push_back('\n');
+        }
+    }
+
+    // ---- diffing by id
+    struct ParameterDiff {
+        enum class Kind { added, removed, changed };
+        ParameterId id;
+        std::string_view name;
+        Kind kind;
+    };
+
+    // Parameters of after that are not in before (added), of before that are not in after (removed), and in
+    // both with a different unit, type or values (changed), in the order of their ids. NaN values compare equal
+    // here. The names are views of the names of before and after.
+    [[nodiscard]] inline std::vector<ParameterDiff> DiffParameters(std::span<const AnyParameter> before,
+                                                                   std::span<const AnyParameter> after) {
+        const auto b = detail::order_by_id(before);
+        const auto a = detail::order_by_id(after);
+        std::vector<ParameterDiff> diff;
+        std::size_t i = 0, j = 0;
+        while (i < b.size() || j < a.size()) {
+            const AnyParameter* x = i < b.size() ? &before[b[i]] : nullptr;
+            const AnyParameter* y = j < a.size() ? &after[a[j]] : nullptr;
+            if (y == nullptr || (x != nullptr && x->Id().value < y->Id().value)) {
+                diff.push_back({x->Id(), x->NameView(), ParameterDiff::Kind::removed});
+                ++i;
+            } else if (x == nullptr || y->Id().value < x->Id().value) {
+                diff.push_back({y->Id(), y->NameView(), ParameterDiff::Kind::added});
+                ++j;
+            } else {
+                if (!detail::same_values(*x, *y)) diff.push_back({y->Id(), y->NameView(), ParameterDiff::Kind::changed});
+                ++i;
+                ++j;
+            }
+        }
+        return diff;
+    }
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,272 @@
+// arena.h
+// This file defines ParameterArena, a bump allocator, and Protocol, a container that constructs all the
+// parameters of a protocol back to back in the arena's blocks instead of one heap allocation each.
+// Because the values of ParameterBase are stored inline (small_vector, see inline_capacity), a parameter
+// object and its values form one contiguous record, so iterating a protocol walks memory linearly.
+// Copying a protocol allocates a single block for all the parameters and copy-constructs each of them at the
+// offset it has in the source, so the copy has the same layout and its registry is copied instead of rebuilt.
+// For values stored inline the copy constructor of a parameter is a vtable pointer and a copy of the values.
+// Values larger than the inline capacity are still allocated on the heap by small_vector.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parameter.h"
+#include "registry.h"
+
+namespace methodverse::parameter {
+
+    // ======== ParameterArena: monotonic bump allocator ========
+    // Memory is only released all at once (Release() or destruction). It is also a std::pmr::memory_resource,
+    // so pmr containers of a protocol can share it.
+    class ParameterArena : public std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t block_alignment = 64;
+        static constexpr std::size_t default_block_size = 64 * 1024;
+
+        explicit ParameterArena(std::size_t block_size = default_block_size) : block_size_(block_size) {}
+
+        ParameterArena(const ParameterArena&) = delete;
+        ParameterArena& operator=(const ParameterArena&) = delete;
+
+        ParameterArena(ParameterArena&& other) noexcept
+            : blocks_(std::move(other.blocks_)), block_size_(other.block_size_) { other.blocks_.clear(); }
+
+        ParameterArena& operator=(ParameterArena&& other) noexcept {
+            if (this != &other) {
+                Release();
+                blocks_ = std::move(other.blocks_);
+                other.blocks_.clear();
+                block_size_ = other.block_size_;
+            }
+            return *this;
+        }
+
+        ~ParameterArena() override { Release(); }
+
+        [[nodiscard]] void* Allocate(std::size_t bytes, std::size_t alignment) {
+            if (!blocks_.empty()) {
+                block& b = blocks_.back();
+                const std::size_t offset = align_up(b.used, alignment);
+                if (offset + bytes <= b.capacity) {
+                    b.used = offset + bytes;
+                    return b.data + offset;
+                }
+            }
+            block& b = add_block(std::max(block_size_, align_up(bytes, block_alignment)));
+            b.used = bytes;
+            return b.data;
+        }
+
+        // Add an empty block of at least bytes, the next allocations are served from it
+        void ReserveBlock(std::size_t bytes) { add_block(std::max(block_size_, align_up(bytes, block_alignment))); }
+
+        // Free all blocks
+        void Release() noexcept {
+            for (const block& b : blocks_) ::operator delete(b.data, std::align_val_t{block_alignment});
+            blocks_.clear();
+        }
+
+        [[nodiscard]] std::size_t BlockCount() const noexcept { return blocks_.size(); }
+        [[nodiscard]] std::size_t BlockSize() const noexcept { return block_size_; }
+
+        [[nodiscard]] std::size_t BytesUsed() const noexcept {
+            std::size_t n = 0;
+            for (const block& b : blocks_) n += b.used;
+            return n;
+        }
+
+        // Used bytes of block i, for the bulk copy of Protocol
+        [[nodiscard]] std::span<const std::byte> UsedBytes(std::size_t i) const noexcept {
+            return {blocks_[i].data, blocks_[i].used};
+        }
+
+        [[nodiscard]] static constexpr std::size_t align_up(std::size_t n, std::size_t alignment) noexcept {
+            return (n + alignment - 1) / alignment * alignment;
+        }
+
+    protected:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override { return Allocate(bytes, alignment); }
+        void do_deallocate(void*, std::size_t, std::size_t) override {}
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        struct block {
+            std::byte* data;
+            std::size_t capacity;
+            std::size_t used;
+        };
+
+        std::vector<block> blocks_;
+        std::size_t block_size_;
+
+        block& add_block(std::size_t capacity) {
+            auto* data = static_cast<std::byte*>(::operator new(capacity, std::align_val_t{block_alignment}));
+            blocks_.push_back({data, capacity, 0});
+            return blocks_.back();
+        }
+    };
+
+namespace detail {
+
+    // ---- what Protocol needs to know about a parameter class it stores
+    struct arena_type_info {
+        void (*copy_construct)(void* dst, const void* src);
+        void (*destroy)(void*) noexcept;
+    };
+
+    template<class P>
+    inline constexpr arena_type_info arena_type_info_v{
+        [](void* dst, const void* src) { ::new (dst) P(*static_cast<const P*>(src)); },
+        [](void* p) noexcept { static_cast<P*>(p)->~P(); }};
+
+} // namespace detail
+
+    // ======== Protocol: parameters stored contiguously in a ParameterArena ========
+    class Protocol {
+    public:
+        explicit Protocol(std::size_t block_size = ParameterArena::default_block_size) : arena_(block_size) {}
+
+        // Copy: copy construction of every parameter into one block, at the offsets of the source blocks.
+        // The registry is copied, not rebuilt.
+        Protocol(const Protocol& other) : arena_(other.arena_.BlockSize()) {
+            std::size_t total = 0;
+            for (std::size_t b = 0; b < other.arena_.BlockCount(); ++b) {
+                total += ParameterArena::align_up(other.arena_.UsedBytes(b).size(), ParameterArena::block_alignment);
+            }
+            entries_.reserve(other.entries_.size());
+            if (total == 0) return;
+
+            // every block starts 64-byte aligned, so placing each at a 64-byte aligned offset keeps alignment
+            auto* dst = static_cast<std::byte*>(arena_.Allocate(total, ParameterArena::block_alignment));
+            std::vector<std::byte*> block_dst(other.arena_.BlockCount());
+            std::size_t offset = 0;
+            for (std::size_t b = 0; b < other.arena_.BlockCount(); ++b) {
+                block_dst[b] = dst + offset;
+                offset += ParameterArena::align_up(other.arena_.UsedBytes(b).size(), ParameterArena::block_alignment);
+            }
+
+            try {
+                for (const entry& e : other.entries_) {
+                    const auto* src_block = other.arena_.UsedBytes(e.block).data();
+                    std::byte* object = block_dst[e.block] + (static_cast<const std::byte*>(e.object) - src_block);
+                    e.type->copy_construct(object, e.object);
+                    // the IParameter subobject is at the same offset in the copy
+                    auto* param = reinterpret_cast<IParameter*>(object + (reinterpret_cast<std::byte*>(e.param) -
+                                                                          static_cast<std::byte*>(e.object)));
+                    entries_.push_back({param, object, e.type, 0});
+                }
+                // the table layout only depends on the ids, so the registry is copied and its pointers moved
+                registry_ = other.registry_;
+            } catch (...) {
+                destroy_all(); // the parameters copied so far; the arena frees the bytes
+                throw;
+            }
+            registry_.Rebind([&](IParameter* p) {
+                const auto* bytes = reinterpret_cast<const std::byte*>(p);
+                const auto in_block = [&](std::size_t b) {
+                    const auto used = other.arena_.UsedBytes(b);
+                    return bytes >= used.data() && bytes < used.data() + used.size();
+                };
+                std::size_t b = 0;
+                while (b < block_dst.size() && !in_block(b)) ++b;
+                // only Emplace() registers parameters, and it constructs them in the arena
+                assert(b < block_dst.size() && "Protocol: registered parameter outside the arena");
+                if (b == block_dst.size()) return p;
+                return reinterpret_cast<IParameter*>(block_dst[b] + (bytes - other.arena_.UsedBytes(b).data()));
+            });
+        }
+
+        Protocol(Protocol&& other) noexcept = default;
+
+        Protocol& operator=(const Protocol& other) {
+            if (this != &other) {
+                Protocol copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        Protocol& operator=(Protocol&& other) noexcept {
+            if (this != &other) {
+                destroy_all();
+                arena_ = std::move(other.arena_);
+                entries_ = std::move(other.entries_);
+                registry_ = std::move(other.registry_);
+            }
+            return *this;
+        }
+
+        ~Protocol() { destroy_all(); }
+
+        void swap(Protocol& other) noexcept {
+            std::swap(arena_, other.arena_);
+            entries_.swap(other.entries_);
+            std::swap(registry_, other.registry_);
+        }
+
+        // Construct a parameter of class P in the arena; it is registered under its Id().
+        // Throws std::invalid_argument if the protocol already has a parameter with the same id.
+        template<class P, class... Args>
+        P& Emplace(Args&&... args) {
+            static_assert(std::is_base_of_v<IParameter, P>, "Protocol::Emplace: P must derive from IParameter");
+            void* memory = arena_.Allocate(sizeof(P), alignof(P));
+            P* p = ::new (memory) P(std::forward<Args>(args)...);
+            try {
+                registry_.Insert(*p);
+            } catch (...) {
+                p->~P();
+                throw;
+            }
+            entries_.push_back({p, p, &detail::arena_type_info_v<P>, arena_.BlockCount() - 1});
+            return *p;
+        }
+
+        // ---- access
+        [[nodiscard]] std::size_t Size() const noexcept { return entries_.size(); }
+        [[nodiscard]] IParameter& operator[](std::size_t i) noexcept { return *entries_[i].param; }
+        [[nodiscard]] const IParameter& operator[](std::size_t i) const noexcept { return *entries_[i].param; }
+
+        [[nodiscard]] IParameter* Find(ParameterId id) const noexcept { return registry_.Find(id); }
+
+        template<class P>
+        [[nodiscard]] P* Find() const noexcept { return registry_.Find<P>(); }
+
+        // Visit the parameters in construction order, i.e. in memory order
+        template<class F>
+        void ForEach(F&& f) const {
+            for (const entry& e : entries_) f(static_cast<const IParameter&>(*e.param));
+        }
+
+        [[nodiscard]] const ParameterArena& Arena() const noexcept { return arena_; }
+
+    private:
+        struct entry {
+            IParameter* param;
+            void* object;
+            const detail::arena_type_info* type;
+            std::size_t block; // index of the arena block holding the object
+        };
+
+        ParameterArena arena_;
+        std::vector<entry> entries_;
+        ParameterRegistry registry_;
+
+        void destroy_all() noexcept {
+            for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) it->type->destroy(it->object);
+            entries_.clear();
+            registry_.Clear();
+        }
+    };
+
+}; // namespace methodverse::parameter
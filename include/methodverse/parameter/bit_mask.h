@@ -0,0 +1,256 @@
+// bit_mask.h
+// This file defines BitMask, a boolean mask packed 64 bits per word, for the large masks of a protocol
+// (slice, echo and segment enables, per-line acquisition masks in compressed sensing). ParameterBase<bool>
+// stores one bool per byte so that its values can be viewed as std::span<const bool> like any other primitive
+// type, and its logical operators still process one bool per element. A packed mask is a separate value type,
+// held as a single value of a ParameterBase<BitMask, one>, whose logical operators run one word at a time:
+//     auto lines = BitMask::Filled(256, false);
+//     lines.Set(0, 64, true);                       // bits [0, 64)
+//     const BitMask acquired = lines | (BitMask(sampled) & ~skipped);
+//     for (std::size_t i = acquired.FindFirst(); i != BitMask::npos; i = acquired.FindNext(i)) ...
+// The word loops have no dependency between iterations, so the compiler vectorizes them to 128-512 bits per
+// instruction when the target allows (e.g. -march=native).
+// The bits past Size() in the last word are always zero: Count(), == and the word operators need no tail
+// handling, only ~ clears them again.
+// The op policies of bitmask_tag (and, or, xor, xnor, not) are defined in operation_policy.h, so masks are
+// combined through the same op tags as bool parameters, e.g. EagerApply<and_op>(a, b).
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <fmt/format.h>
+#include "small_vector.h"
+
+namespace methodverse::parameter {
+
+    // ======== BitMask: a packed, fixed-size sequence of bits ========
+    class BitMask {
+    public:
+        using word_type = std::uint64_t;
+        static constexpr std::size_t word_bits = 64;
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        BitMask() = default;
+
+        // size bits, all equal to value. A factory rather than a (size, value) constructor: BitMask{64, true}
+        // would select the initializer_list constructor and give the two bits 1, 1.
+        [[nodiscard]] static BitMask Filled(std::size_t size, bool value) {
+            BitMask mask;
+            mask.words_.assign(word_count(size), value ? ~word_type{0} : word_type{0});
+            mask.size_ = size;
+            mask.clear_tail();
+            return mask;
+        }
+
+        // From unpacked bools, e.g. the values of a ParameterBase<bool>
+        explicit BitMask(std::span<const bool> bits) : words_(word_count(bits.size()), word_type{0}), size_(bits.size()) {
+            for (std::size_t w = 0; w < words_.size(); ++w) {
+                const std::size_t first = w * word_bits;
+                const std::size_t n = std::min(word_bits, size_ - first);
+                word_type word = 0;
+                for (std::size_t b = 0; b < n; ++b) word |= word_type{bits[first + b]} << b;
+                words_[w] = word;
+            }
+        }
+
+        BitMask(std::initializer_list<bool> bits) : BitMask(std::span<const bool>(bits.begin(), bits.size())) {}
+
+        // ---- size and raw words
+        [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+        [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] std::span<const word_type> Words() const noexcept { return {words_.data(), words_.size()}; }
+
+        // ---- single bits; throw std::out_of_range if i >= Size()
+        [[nodiscard]] bool Test(std::size_t i) const {
+            check_index(i);
+            return (words_[i / word_bits] >> (i % word_bits)) & 1u;
+        }
+
+        void Set(std::size_t i, bool value = true) {
+            check_index(i);
+            const word_type bit = word_type{1} << (i % word_bits);
+            if (value) words_[i / word_bits] |= bit;
+            else words_[i / word_bits] &= ~bit;
+        }
+
+        void Reset(std::size_t i) { Set(i, false); }
+
+        // ---- bits [first, last) at once, whole words are written directly
+        void Set(std::size_t first, std::size_t last, bool value) {
+            if (first > last || last > size_) {
+                throw std::out_of_range("BitMask::Set: range [" + std::to_string(first) + ", " + std::to_string(last) +
+                                        ") out of a mask of size " + std::to_string(size_));
+            }
+            while (first < last) {
+                const std::size_t w = first / word_bits;
+                const std::size_t lo = first % word_bits;
+                const std::size_t hi = std::min(word_bits, lo + (last - first));
+                const word_type bits = (hi == word_bits ? ~word_type{0} : (word_type{1} << hi) - 1) & (~word_type{0} << lo);
+                if (value) words_[w] |= bits;
+                else words_[w] &= ~bits;
+                first += hi - lo;
+            }
+        }
+
+        void SetAll(bool value = true) {
+            for (word_type& word : words_) word = value ? ~word_type{0} : word_type{0};
+            clear_tail();
+        }
+
+        // ---- queries
+        // number of set bits
+        [[nodiscard]] std::size_t Count() const noexcept {
+            std::size_t count = 0;
+            for (const word_type word : words_) count += static_cast<std::size_t>(std::popcount(word));
+            return count;
+        }
+
+        [[nodiscard]] bool Any() const noexcept {
+            for (const word_type word : words_) {
+                if (word != 0) return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool None() const noexcept { return !Any(); }
+        [[nodiscard]] bool All() const noexcept { return Count() == size_; }
+
+        // index of the first set bit, npos if there is none
+        [[nodiscard]] std::size_t FindFirst() const noexcept { return find_from(0); }
+
+        // index of the first set bit after i, npos if there is none
+        [[nodiscard]] std::size_t FindNext(std::size_t i) const noexcept {
+            return i + 1 >= size_ ? npos : find_from(i + 1);
+        }
+
+        // f(index) for every set bit in increasing order, one countr_zero per set bit
+        template<class F>
+        void ForEachSet(F&& f) const {
+            for (std::size_t w = 0; w < words_.size(); ++w) {
+                for (word_type word = words_[w]; word != 0; word &= word - 1) {
+                    f(w * word_bits + static_cast<std::size_t>(std::countr_zero(word)));
+                }
+            }
+        }
+
+        // ---- unpacking; out must hold Size() bools
+        void CopyTo(std::span<bool> out) const {
+            if (out.size() != size_) {
+                throw std::invalid_argument("BitMask::CopyTo: " + std::to_string(out.size()) +
+                                            " bools for a mask of size " + std::to_string(size_));
+            }
+            for (std::size_t i = 0; i < size_; ++i) out[i] = (words_[i / word_bits] >> (i % word_bits)) & 1u;
+        }
+
+        // ---- word-parallel logical operators; the operands must have the same size (std::invalid_argument)
+        BitMask& operator&=(const BitMask& rhs) {
+            check_size(rhs, "&");
+            for (std::size_t w = 0; w < words_.size(); ++w) words_[w] &= rhs.words_[w];
+            return *this;
+        }
+
+        BitMask& operator|=(const BitMask& rhs) {
+            check_size(rhs, "|");
+            for (std::size_t w = 0; w < words_.size(); ++w) words_[w] |= rhs.words_[w];
+            return *this;
+        }
+
+        BitMask& operator^=(const BitMask& rhs) {
+            check_size(rhs, "^");
+            for (std::size_t w = 0; w < words_.size(); ++w) words_[w] ^= rhs.words_[w];
+            return *this;
+        }
+
+        [[nodiscard]] friend BitMask operator&(BitMask lhs, const BitMask& rhs) {
+            lhs &= rhs;
+            return lhs;
+        }
+        [[nodiscard]] friend BitMask operator|(BitMask lhs, const BitMask& rhs) {
+            lhs |= rhs;
+            return lhs;
+        }
+        [[nodiscard]] friend BitMask operator^(BitMask lhs, const BitMask& rhs) {
+            lhs ^= rhs;
+            return lhs;
+        }
+
+        [[nodiscard]] friend BitMask operator~(BitMask mask) {
+            for (word_type& word : mask.words_) word = ~word;
+            mask.clear_tail();
+            return mask;
+        }
+
+        // bits that are equal in both masks
+        [[nodiscard]] friend BitMask Xnor(BitMask lhs, const BitMask& rhs) {
+            lhs.check_size(rhs, "xnor");
+            for (std::size_t w = 0; w < lhs.words_.size(); ++w) lhs.words_[w] = ~(lhs.words_[w] ^ rhs.words_[w]);
+            lhs.clear_tail();
+            return lhs;
+        }
+
+        [[nodiscard]] friend bool operator==(const BitMask& lhs, const BitMask& rhs) noexcept {
+            return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+        }
+
+    private:
+        static constexpr std::size_t word_count(std::size_t size) noexcept { return (size + word_bits - 1) / word_bits; }
+
+        void clear_tail() noexcept {
+            if (const std::size_t tail = size_ % word_bits; tail != 0) words_[words_.size() - 1] &= (word_type{1} << tail) - 1;
+        }
+
+        void check_index(std::size_t i) const {
+            if (i >= size_) {
+                throw std::out_of_range("BitMask: bit " + std::to_string(i) + " out of a mask of size " + std::to_string(size_));
+            }
+        }
+
+        void check_size(const BitMask& rhs, const char* op) const {
+            if (size_ != rhs.size_) {
+                throw std::invalid_argument(std::string("BitMask: operator") + op + " on masks of size " +
+                                            std::to_string(size_) + " and " + std::to_string(rhs.size_));
+            }
+        }
+
+        std::size_t find_from(std::size_t i) const noexcept {
+            std::size_t w = i / word_bits;
+            if (w >= words_.size()) return npos;
+            word_type word = words_[w] & (~word_type{0} << (i % word_bits));
+            while (word == 0) {
+                if (++w == words_.size()) return npos;
+                word = words_[w];
+            }
+            return w * word_bits + static_cast<std::size_t>(std::countr_zero(word));
+        }
+
+        // masks of up to 128 bits stay inline
+        small_vector<word_type, 2> words_;
+        std::size_t size_ = 0;
+    };
+
+}; // namespace methodverse::parameter
+
+// ---- one character per bit, bit 0 first: "10110"
+template<>
+struct fmt::formatter<methodverse::parameter::BitMask> {
+    constexpr auto parse(fmt::format_parse_context& ctx) { return ctx.begin(); }
+
+    template<class FormatContext>
+    auto format(const methodverse::parameter::BitMask& mask, FormatContext& ctx) const {
+        auto out = ctx.out();
+        const auto words = mask.Words();
+        for (std::size_t i = 0; i < mask.Size(); ++i) {
+            *out++ = ((words[i / 64] >> (i % 64)) & 1u) ? '1' : '0';
+        }
+        return out;
+    }
+};
@@ -0,0 +1,235 @@
+// change_log.h
+// This file defines the change notifications of parameters. ParameterBase::Set() and Parameter::operator=
+// report every change here; when nobody is subscribed that costs one relaxed atomic load and a branch that
+// is predicted not taken. With subscribers, changes are appended to a per-thread change log. Inside a
+// ChangeTransaction they are collected and delivered once, deduplicated by parameter id, when the outermost
+// transaction ends; outside a transaction every change is delivered right away as a batch of one.
+// Subscribers are called on the thread that made the changes, after the transaction, without locks held;
+// they should not throw. An exception propagates to the write that delivered the batch (std::terminate in
+// the noexcept move assignment and in a ChangeTransaction destructor) and leaves the log ready for the next
+// changes.
+//     auto subscription = SubscribeChanges([&](std::span<const ParameterChange> batch) { ... });
+//     { ChangeTransaction tx; te = 0.01; tr = 2.0; te = 0.02; } // one call: TE, TR
+// Writes through Get() or Unchecked() are not seen; call NotifyChanged() after them. ParseInto(),
+// Snapshot::LoadInto() and Formula::EvaluateInto() notify like Set().
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+#include "parameter_id.h"
+
+namespace methodverse::parameter {
+
+    class IParameter;
+
+    // ---- one entry of a notification batch
+    // parameter is the object that was changed last under id. It is only valid while that object lives, so
+    // subscribers that outlive the changed parameters should use id.
+    struct ParameterChange {
+        ParameterId id;
+        const IParameter* parameter = nullptr;
+    };
+
+    using ChangeCallback = std::function<void(std::span<const ParameterChange>)>;
+
+namespace detail {
+
+    // number of subscribers, a constant-initialized global so the hot-path check needs no guard of a local static
+    inline constinit std::atomic<std::size_t> change_subscriber_count{0};
+
+    class change_hub {
+    public:
+        static change_hub& instance() {
+            static change_hub hub;
+            return hub;
+        }
+
+        std::uint64_t subscribe(ChangeCallback callback) {
+            std::lock_guard lock(mutex_);
+            const std::uint64_t token = ++last_token_;
+            subscribers_.push_back({token, std::make_shared<const ChangeCallback>(std::move(callback))});
+            change_subscriber_count.store(subscribers_.size(), std::memory_order_relaxed);
+            return token;
+        }
+
+        void unsubscribe(std::uint64_t token) {
+            std::lock_guard lock(mutex_);
+            std::erase_if(subscribers_, [&](const auto& s) { return s.first == token; });
+            change_subscriber_count.store(subscribers_.size(), std::memory_order_relaxed);
+        }
+
+        void deliver(std::span<const ParameterChange> batch) {
+            std::vector<std::shared_ptr<const ChangeCallback>> callbacks;
+            {
+                std::lock_guard lock(mutex_);
+                callbacks.reserve(subscribers_.size());
+                for (const auto& s : subscribers_) callbacks.push_back(s.second);
+            }
+            for (const auto& callback : callbacks) (*callback)(batch);
+        }
+
+    private:
+        std::mutex mutex_;
+        std::uint64_t last_token_ = 0;
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<const ChangeCallback>>> subscribers_;
+    };
+
+    // ---- per-thread log of the changes of the current transaction
+    class change_log {
+    public:
+        static change_log& this_thread() {
+            thread_local change_log log;
+            return log;
+        }
+
+        void record(ParameterId id, const IParameter* parameter) {
+            if (muted_ != 0) return;
+            // a loop writing the same parameter keeps one entry
+            if (!changes_.empty() && changes_.back().id == id) changes_.back().parameter = parameter;
+            else changes_.push_back({id, parameter});
+            if (depth_ == 0) flush();
+        }
+
+        void begin() noexcept { ++depth_; }
+
+        // changes recorded between mute() and unmute() are dropped, see muted_changes
+        void mute() noexcept { ++muted_; }
+        void unmute() noexcept { --muted_; }
+
+        void commit() {
+            if (--depth_ == 0) flush();
+        }
+
+    private:
+        std::vector<ParameterChange> changes_;
+        std::vector<ParameterChange> batch_;
+        int depth_ = 0;
+        int muted_ = 0;
+
+        // resets the nesting depth and empties the delivery batch at the end of a scope, also when it is left
+        // by an exception of a subscriber, so later changes of the thread are still delivered
+        struct restore_on_exit {
+            change_log& log;
+            int depth;
+            ~restore_on_exit() {
+                log.depth_ = depth;
+                log.batch_.clear();
+            }
+        };
+
+        // Deliver the collected changes, the last change of each id in order of first change. Changes made by
+        // subscribers during delivery are collected and delivered in a following batch.
+        void flush() {
+            const restore_on_exit restore{*this, depth_};
+            ++depth_;
+            while (!changes_.empty()) {
+                batch_.swap(changes_);
+                changes_.clear();
+                deduplicate(batch_);
+                change_hub::instance().deliver(batch_);
+            }
+        }
+
+        static void deduplicate(std::vector<ParameterChange>& changes) {
+            if (changes.size() < 2) return;
+            // sort by id keeping the order of changes, keep the last change of each id at the place of its first
+            std::vector<std::size_t> order(changes.size());
+            for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+            std::stable_sort(order.begin(), order.end(),
+                             [&](std::size_t a, std::size_t b) { return changes[a].id < changes[b].id; });
+            std::vector<std::pair<std::size_t, ParameterChange>> unique;
+            for (std::size_t k = 0; k < order.size();) {
+                std::size_t last = k;
+                while (last + 1 < order.size() && changes[order[last + 1]].id == changes[order[k]].id) ++last;
+                unique.emplace_back(order[k], changes[order[last]]);
+                k = last + 1;
+            }
+            std::sort(unique.begin(), unique.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            changes.clear();
+            for (const auto& u : unique) changes.push_back(u.second);
+        }
+    };
+
+    // ---- scope whose changes on this thread are not reported, for writers that report one change themselves
+    // (ConcurrentParameter updates two instances per write)
+    struct muted_changes {
+        muted_changes() noexcept { change_log::this_thread().mute(); }
+        ~muted_changes() { change_log::this_thread().unmute(); }
+        muted_changes(const muted_changes&) = delete;
+        muted_changes& operator=(const muted_changes&) = delete;
+    };
+
+    [[gnu::noinline, gnu::cold]] inline void record_change(ParameterId id, const IParameter* parameter) {
+        change_log::this_thread().record(id, parameter);
+    }
+
+    // the hot-path check of Set() / operator=
+    [[nodiscard]] inline bool change_notifications_active() noexcept {
+        return change_subscriber_count.load(std::memory_order_relaxed) != 0;
+    }
+
+} // namespace detail
+
+    // ======== Subscription ========
+    // Keeps a callback subscribed while it lives
+    class ChangeSubscription {
+    public:
+        ChangeSubscription() = default;
+        explicit ChangeSubscription(std::uint64_t token) noexcept : token_(token) {}
+        ChangeSubscription(ChangeSubscription&& other) noexcept : token_(std::exchange(other.token_, 0)) {}
+        ChangeSubscription& operator=(ChangeSubscription&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                token_ = std::exchange(other.token_, 0);
+            }
+            return *this;
+        }
+        ~ChangeSubscription() { Reset(); }
+
+        void Reset() {
+            if (token_ != 0) detail::change_hub::instance().unsubscribe(std::exchange(token_, 0));
+        }
+
+    private:
+        std::uint64_t token_ = 0;
+    };
+
+    // Subscribe to the changes of all parameters, see the top of this file
+    [[nodiscard]] inline ChangeSubscription SubscribeChanges(ChangeCallback callback) {
+        return ChangeSubscription(detail::change_hub::instance().subscribe(std::move(callback)));
+    }
+
+    // ======== ChangeTransaction ========
+    // Collects the changes made by this thread while it lives; the outermost transaction delivers them in one
+    // batch when it ends (also when it ends by an exception, the values have changed anyway).
+    class ChangeTransaction {
+    public:
+        ChangeTransaction() { detail::change_log::this_thread().begin(); }
+        ChangeTransaction(const ChangeTransaction&) = delete;
+        ChangeTransaction& operator=(const ChangeTransaction&) = delete;
+        ~ChangeTransaction() { Commit(); }
+
+        // End the transaction before the end of the scope
+        void Commit() {
+            if (open_) {
+                open_ = false;
+                detail::change_log::this_thread().commit();
+            }
+        }
+
+    private:
+        bool open_ = true;
+    };
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,143 @@
+// concurrent.h
+// This file defines ConcurrentParameter<P>, a parameter shared between a thread that edits it (UI) and
+// threads that read it (sequence preparation) without a global mutex. It implements the Left-Right
+// technique: two instances of P are kept, readers always read the instance that writers are not modifying,
+// and a writer publishes its change by switching the readers to the updated instance, then waits until no
+// reader is left on the old instance before applying the change there too.
+// Reads are wait-free (an increment and a decrement of a read indicator and two loads) and never see a partially
+// written value, also for values that spill to the heap. Writers are serialized by a mutex and wait for the
+// readers that are already inside Read(), readers never wait for writers.
+// Read indicators are striped over cache lines, a reader thread always uses the same stripe, so readers on
+// different cores rarely write to the same cache line.
+// A write is reported to the change subscribers (change_log.h) as one change of the instance that readers see,
+// after the writer lock is released, so a subscriber may itself call Write().
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "change_log.h"
+
+namespace methodverse::parameter {
+
+namespace detail {
+
+    // ---- count of readers inside a critical section, striped over cache lines
+    class read_indicator {
+    public:
+        static constexpr std::size_t stripes = 16;
+
+        void arrive(std::size_t stripe) noexcept { counters_[stripe].value.fetch_add(1); }
+        void depart(std::size_t stripe) noexcept { counters_[stripe].value.fetch_sub(1); }
+
+        [[nodiscard]] bool empty() const noexcept {
+            for (const auto& c : counters_) {
+                if (c.value.load() != 0) return false;
+            }
+            return true;
+        }
+
+        // stripe of the calling thread, fixed for the lifetime of the thread
+        [[nodiscard]] static std::size_t thread_stripe() noexcept {
+            thread_local const std::size_t stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % stripes;
+            return stripe;
+        }
+
+    private:
+        struct alignas(64) counter {
+            std::atomic<std::int64_t> value{0};
+        };
+        std::array<counter, stripes> counters_;
+    };
+
+} // namespace detail
+
+    // ======== ConcurrentParameter ========
+    template<class P>
+    class ConcurrentParameter {
+    public:
+        template<class... Args>
+        explicit ConcurrentParameter(const Args&... args) : instances_{P(args...), P(args...)} {}
+
+        ConcurrentParameter(const ConcurrentParameter&) = delete;
+        ConcurrentParameter& operator=(const ConcurrentParameter&) = delete;
+
+        // ---- readers
+        // Call f(const P&) on a consistent value; returns what f returns. f must not call Write() on the same
+        // parameter. References to the value must not escape f.
+        template<class F>
+        decltype(auto) Read(F&& f) const {
+            const std::size_t stripe = detail::read_indicator::thread_stripe();
+            const int version = version_index_.load();
+            indicators_[version].arrive(stripe);
+            struct departure {
+                detail::read_indicator& indicator;
+                std::size_t stripe;
+                ~departure() { indicator.depart(stripe); }
+            } guard{indicators_[version], stripe};
+            return std::invoke(std::forward<F>(f), std::as_const(instances_[left_right_.load()]));
+        }
+
+        // Copy of the current value
+        [[nodiscard]] P Load() const {
+            return Read([](const P& p) { return p; });
+        }
+
+        // Number of writes so far, e.g. for a reader to detect that the value changed since it last read it
+        [[nodiscard]] std::uint64_t Version() const noexcept { return writes_.load(); }
+
+        // ---- writers
+        // Apply f(P&) to the value and publish the result. f is called twice, once on each instance, so it must
+        // make the same change both times (assign values, not increment them based on a side channel).
+        template<class F>
+        void Write(F&& f) {
+            const P* published = nullptr;
+            {
+                std::lock_guard lock(writer_);
+                // the two applications of f are one change, reported below
+                const detail::muted_changes muted;
+                const int current = left_right_.load();
+                std::invoke(f, instances_[1 - current]);
+                left_right_.store(1 - current); // new readers see the updated instance
+                toggle_version_and_wait();
+                std::invoke(f, instances_[current]); // no reader is left on the old instance
+                writes_.fetch_add(1);
+                published = &instances_[1 - current];
+            }
+            if constexpr (requires { published->NotifyChanged(); }) published->NotifyChanged();
+        }
+
+        // Replace the value
+        void Store(const P& value) {
+            Write([&](P& p) { p = value; });
+        }
+
+    private:
+        std::array<P, 2> instances_;
+        mutable std::array<detail::read_indicator, 2> indicators_;
+        std::atomic<int> left_right_{0};    // instance read by new readers
+        std::atomic<int> version_index_{0}; // read indicator used by new readers
+        std::atomic<std::uint64_t> writes_{0};
+        std::mutex writer_;
+
+        // Wait until the readers that may still read the old instance have left
+        void toggle_version_and_wait() {
+            const int previous = version_index_.load();
+            const int next = 1 - previous;
+            // readers of an earlier write may still be registered on next
+            while (!indicators_[next].empty()) std::this_thread::yield();
+            version_index_.store(next);
+            while (!indicators_[previous].empty()) std::this_thread::yield();
+        }
+    };
+
+}; // namespace methodverse::parameter
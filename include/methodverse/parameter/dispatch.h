@@ -0,0 +1,263 @@
+// dispatch.h
+// This file defines the runtime operator dispatch for type-erased parameters.
+// The UI and scripting layer only hold IParameter pointers. Instead of trying dynamic_cast over every
+// primitive type and unit, DynamicApply looks up a function in a table generated at compile time from
+// primitive_types and the op_policy specializations, indexed by (op id, lhs TypeId(), rhs TypeId()),
+// and makes a single indirect call. Units are checked and combined at run time (RuntimeUnit), following
+// the unit_of rule of the same policy. Combinations whose policy is disabled map to an entry that throws
+// std::invalid_argument. Results are returned as DynamicParameter<T>, which can be used as an operand again.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/list.hpp>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+    // ======== DynamicParameter: values of a primitive type with a unit known at run time ========
+    template<class T>
+    class DynamicParameter : public IParameter {
+    public:
+        using value_type = T;
+        using storage_type = small_vector<T, inline_capacity_v<T>>;
+
+        DynamicParameter() = default;
+        explicit DynamicParameter(RuntimeUnit unit) : unit_(unit) {}
+        DynamicParameter(storage_type values, RuntimeUnit unit) : value_(std::move(values)), unit_(unit) {}
+
+        [[nodiscard]] T Val() const { return value_.empty() ? T{} : value_[0]; }
+        [[nodiscard]] std::vector<T> Vals() const { return value_.to_vector(); }
+        [[nodiscard]] std::span<const T> View() const noexcept { return {value_.data(), value_.size()}; }
+        decltype(auto) operator[](size_t i) const { return value_.at(i); }
+
+        [[nodiscard]] storage_type& Get() noexcept { return value_; }
+        [[nodiscard]] const storage_type& Get() const noexcept { return value_; }
+        std::size_t Size() const noexcept { return value_.size(); }
+
+        std::string_view NameView() const noexcept override { return "DynamicParameter"; }
+        [[nodiscard]] std::string ValueAsString() const override { return detail::values_to_string(View()); }
+        void FormatValueTo(fmt::memory_buffer& out) const override { detail::format_values_to(out, View()); }
+        std::size_t TypeId() const noexcept override { return primitive_type_id_v<T>; }
+        RuntimeUnit GetRuntimeUnit() const noexcept override { return unit_; }
+
+    protected:
+        std::span<const std::byte> ValueBytes() const noexcept override { return std::as_bytes(View()); }
+
+    private:
+        storage_type value_;
+        RuntimeUnit unit_;
+    };
+
+    // ---- binary ops reachable through the runtime dispatch, the position in the list is the op id
+    using dispatch_ops = boost::mp11::mp_list<add_op, sub_op, mul_op, div_op, coefw_mul_op, coefw_div_op,
+                                              dot_op, cross_op, and_op, or_op, xor_op, xnor_op>;
+
+    inline constexpr std::size_t dispatch_op_count = boost::mp11::mp_size<dispatch_ops>::value;
+
+    template<class Op>
+    inline constexpr std::size_t dispatch_op_id_v = boost::mp11::mp_find<dispatch_ops, Op>::value;
+
+    // names used by the scripting layer and in error messages, in the order of dispatch_ops
+    inline constexpr std::array<std::string_view, dispatch_op_count> dispatch_op_names{
+        "+", "-", "*", "/", ".*", "./", "dot", "cross", "and", "or", "xor", "xnor"};
+
+    // Op id of an operator name, e.g. "*" -> dispatch_op_id_v<mul_op>
+    [[nodiscard]] inline std::optional<std::size_t> FindDispatchOp(std::string_view name) noexcept {
+        for (std::size_t i = 0; i < dispatch_op_count; ++i) {
+            if (dispatch_op_names[i] == name) return i;
+        }
+        return std::nullopt;
+    }
+
+namespace detail {
+
+    // ---- run-time form of policy::unit_of
+    // The rule is read from the policy itself by probing unit_of with metre and second:
+    // unit_of<m, s> ill-formed -> units must be equal; unit_of<m, m> gives m, m^2 or one.
+    enum class unit_rule { none, same, product, quotient };
+
+    struct runtime_unit_rule {
+        unit_rule rule = unit_rule::none;
+        bool same_required = false;
+    };
+
+    template<class Policy>
+    consteval runtime_unit_rule runtime_unit_rule_of() {
+        using mp_units::si::metre;
+        using mp_units::si::second;
+        if constexpr (!requires { Policy::template unit_of<metre, metre>(); }) {
+            return {unit_rule::none, false}; // string and bool policies are unitless
+        } else {
+            constexpr bool same_required = !requires { Policy::template unit_of<metre, second>(); };
+            constexpr auto u = Policy::template unit_of<metre, metre>();
+            if constexpr (u == metre) return {unit_rule::same, true};
+            else if constexpr (u == metre * metre) return {unit_rule::product, same_required};
+            else if constexpr (u == mp_units::one) return {unit_rule::quotient, same_required};
+            else static_assert(always_false<Policy>, "runtime_unit_rule_of: unsupported unit_of rule");
+        }
+    }
+
+    [[nodiscard]] inline bool unit_rule_accepts(runtime_unit_rule r, const RuntimeUnit& lhs, const RuntimeUnit& rhs) noexcept {
+        return !r.same_required || lhs == rhs;
+    }
+
+    [[nodiscard]] inline RuntimeUnit unit_rule_result(runtime_unit_rule r, const RuntimeUnit& lhs, const RuntimeUnit& rhs) noexcept {
+        switch (r.rule) {
+            case unit_rule::same: return lhs;
+            case unit_rule::product: return lhs * rhs;
+            case unit_rule::quotient: return lhs / rhs;
+            default: return {};
+        }
+    }
+
+    // ---- error messages shared with the formula compiler
+    inline std::string unit_mismatch_message(std::size_t op_id, const RuntimeUnit& lhs, const RuntimeUnit& rhs) {
+        return "operator " + std::string(dispatch_op_names[op_id]) + " requires equal units, got " + lhs.ToString() +
+               " and " + rhs.ToString();
+    }
+
+    inline std::string undefined_op_message(std::size_t op_id, std::size_t lhs_type, std::size_t rhs_type) {
+        return "operator " + std::string(dispatch_op_names[op_id]) + " is not defined for " +
+               std::string(primitive_type_names[lhs_type]) + " and " + std::string(primitive_type_names[rhs_type]);
+    }
+
+    // ---- table entries
+    // apply allocates the result, apply_into writes into an existing DynamicParameter of result_type_id
+    // whose unit is already set (used by the formula bytecode, see formula.h)
+    using dispatch_fn = std::unique_ptr<IParameter> (*)(const IParameter&, const IParameter&);
+    using dispatch_into_fn = void (*)(const IParameter&, const IParameter&, IParameter&);
+
+    struct dispatch_entry {
+        dispatch_fn apply = nullptr;
+        dispatch_into_fn apply_into = nullptr; // nullptr when the op is not defined for the types
+        std::size_t result_type_id = no_type_id;
+        runtime_unit_rule unit_rule{};
+    };
+
+    template<class Op, class T1, class T2, class Policy = op_policy<category_t<T1>, category_t<T2>, Op>>
+    concept dispatch_enabled = Policy::enabled && requires(const T1& a, const T2& b) {
+        Policy::template impl<T1, T2>(a, b); // op_return_t is a hard error when impl is not viable
+    };
+
+    template<class Op, class T1, class T2>
+    void dispatch_apply_into(const IParameter& lhs, const IParameter& rhs, IParameter& result) {
+        using policy = op_policy<category_t<T1>, category_t<T2>, Op>;
+        using T3 = op_return_t<policy, T1, T2>;
+
+        const auto a = lhs.UncheckedViewAs<T1>();
+        const auto b = rhs.UncheckedViewAs<T2>();
+        auto& out = static_cast<DynamicParameter<T3>&>(result).Get();
+        out.resize_for_overwrite(broadcast_size(a.size(), b.size()));
+        elementwise<policy>(a.data(), a.size(), b.data(), b.size(), out.data());
+    }
+
+    template<class Op, class T1, class T2>
+    std::unique_ptr<IParameter> dispatch_apply(const IParameter& lhs, const IParameter& rhs) {
+        using policy = op_policy<category_t<T1>, category_t<T2>, Op>;
+        using T3 = op_return_t<policy, T1, T2>;
+        static constexpr runtime_unit_rule rule = runtime_unit_rule_of<policy>();
+
+        const RuntimeUnit lu = lhs.GetRuntimeUnit();
+        const RuntimeUnit ru = rhs.GetRuntimeUnit();
+        if (!unit_rule_accepts(rule, lu, ru)) {
+            throw std::invalid_argument("DynamicApply: " + unit_mismatch_message(dispatch_op_id_v<Op>, lu, ru));
+        }
+        auto result = std::make_unique<DynamicParameter<T3>>(unit_rule_result(rule, lu, ru));
+        dispatch_apply_into<Op, T1, T2>(lhs, rhs, *result);
+        return result;
+    }
+
+    template<class Op, class T1, class T2>
+    [[noreturn]] std::unique_ptr<IParameter> dispatch_disabled(const IParameter&, const IParameter&) {
+        throw std::invalid_argument("DynamicApply: " + undefined_op_message(dispatch_op_id_v<Op>, primitive_type_id_v<T1>,
+                                                                             primitive_type_id_v<T2>));
+    }
+
+    template<class Op, class T1, class T2>
+    consteval dispatch_entry make_dispatch_entry() {
+        if constexpr (dispatch_enabled<Op, T1, T2>) {
+            using policy = op_policy<category_t<T1>, category_t<T2>, Op>;
+            return {&dispatch_apply<Op, T1, T2>, &dispatch_apply_into<Op, T1, T2>,
+                    primitive_type_id_v<op_return_t<policy, T1, T2>>, runtime_unit_rule_of<policy>()};
+        } else {
+            return {&dispatch_disabled<Op, T1, T2>};
+        }
+    }
+
+    // ---- the table: one row of primitive_type_count^2 entries per op, entry lhs_id * count + rhs_id
+    template<class Op, std::size_t... I>
+    consteval auto make_dispatch_row(std::index_sequence<I...>) {
+        constexpr std::size_t n = primitive_type_count;
+        return std::array<dispatch_entry, sizeof...(I)>{
+            make_dispatch_entry<Op, boost::mp11::mp_at_c<primitive_types, I / n>,
+                                boost::mp11::mp_at_c<primitive_types, I % n>>()...};
+    }
+
+    template<class... Ops>
+    consteval auto make_dispatch_table(boost::mp11::mp_list<Ops...>) {
+        return std::array{make_dispatch_row<Ops>(std::make_index_sequence<primitive_type_count * primitive_type_count>{})...};
+    }
+
+    inline constexpr auto dispatch_table = make_dispatch_table(dispatch_ops{});
+
+} // namespace detail
+
+    // ---- DynamicApply
+    // lhs op rhs on type-erased parameters, element-wise with the same broadcasting rules as the
+    // compile-time operators. Throws std::invalid_argument if the op is not defined for the value types,
+    // the units are incompatible or the sizes cannot be broadcast, and std::out_of_range for an unknown op id.
+    [[nodiscard]] inline std::unique_ptr<IParameter> DynamicApply(std::size_t op_id, const IParameter& lhs,
+                                                                  const IParameter& rhs) {
+        if (op_id >= dispatch_op_count) throw std::out_of_range("DynamicApply: unknown op id");
+        const std::size_t l = lhs.TypeId();
+        const std::size_t r = rhs.TypeId();
+        if (l >= primitive_type_count || r >= primitive_type_count) {
+            throw std::invalid_argument("DynamicApply: operand " + (l >= primitive_type_count ? lhs.Name() : rhs.Name()) +
+                                        " does not store a primitive value type");
+        }
+        return detail::dispatch_table[op_id][l * primitive_type_count + r].apply(lhs, rhs);
+    }
+
+    template<class Op>
+    [[nodiscard]] std::unique_ptr<IParameter> DynamicApply(const IParameter& lhs, const IParameter& rhs) {
+        return DynamicApply(dispatch_op_id_v<Op>, lhs, rhs);
+    }
+
+namespace detail {
+
+    using dynamic_factory_fn = std::unique_ptr<IParameter> (*)(RuntimeUnit);
+
+    template<class T>
+    std::unique_ptr<IParameter> make_dynamic_parameter(RuntimeUnit unit) {
+        return std::make_unique<DynamicParameter<T>>(unit);
+    }
+
+    template<class... Ts>
+    consteval auto make_dynamic_factories(boost::mp11::mp_list<Ts...>) {
+        return std::array<dynamic_factory_fn, sizeof...(Ts)>{&make_dynamic_parameter<Ts>...};
+    }
+
+    inline constexpr auto dynamic_factories = make_dynamic_factories(primitive_types{});
+
+} // namespace detail
+
+    // ---- empty DynamicParameter of the primitive type with the given id
+    [[nodiscard]] inline std::unique_ptr<IParameter> MakeDynamicParameter(std::size_t type_id, RuntimeUnit unit) {
+        if (type_id >= primitive_type_count) throw std::out_of_range("MakeDynamicParameter: unknown type id");
+        return detail::dynamic_factories[type_id](unit);
+    }
+
+}; // namespace methodverse::parameter
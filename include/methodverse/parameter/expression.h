@@ -0,0 +1,389 @@
+// expression.h
+// This file defines the lazy expression nodes returned by the binary operators of ParameterBase.
+// An expression like gamma * grad_str * dt does not compute anything when it is built: it records the
+// operands and the op_policy of every step, and derives the resulting value type and unit at compile time
+// (through op_return_t and policy::unit_of). The values are computed in a single fused pass over all
+// elements when the expression is assigned to a ParameterBase/Parameter or when Val()/Vals() is called,
+// so a chain of N operators needs one result buffer instead of N.
+// Operands that are lvalue parameters are captured by reference, rvalue parameters are moved into the
+// node; as with Eigen expressions, an expression must not outlive the parameters it references.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <mp-units/core.h>
+#include "instrumentation.h"
+#include "inverse_cache.h"
+#include "operation_policy.h"
+
+namespace methodverse::parameter {
+
+    template<typename T, mp_units::Reference auto Unit>
+    class ParameterBase;
+
+    template<class Op, class L, class R>
+    class ParameterExpr;
+
+namespace detail {
+
+    // ---- broadcasting rules of the element-wise operators
+    // Operands of equal size are combined element by element; an operand holding a single value is
+    // broadcast against every value of the other operand. Any other size combination is an error.
+    inline std::size_t broadcast_size(std::size_t n1, std::size_t n2) {
+        if (n1 == n2 || n2 == 1) return n1;
+        if (n1 == 1) return n2;
+        throw std::invalid_argument("ParameterBase: cannot broadcast operands of size " +
+                                    std::to_string(n1) + " and " + std::to_string(n2));
+    }
+
+    // ---- element-wise kernel
+    // Applies Policy::impl to every (broadcast) pair of values and writes into out, which must hold
+    // broadcast_size(n1, n2) elements. Each case is a plain loop over contiguous memory, so the scalar
+    // policies are auto-vectorized by the compiler.
+    template<class Policy, class T1, class T2, class T3>
+    void elementwise(const T1* a, std::size_t n1, const T2* b, std::size_t n2, T3* out) {
+        if (n1 == n2) {
+            for (std::size_t i = 0; i < n1; ++i) out[i] = Policy::template impl<T1, T2>(a[i], b[i]);
+        } else if (n1 == 1) {
+            const T1 s = a[0];
+            for (std::size_t i = 0; i < n2; ++i) out[i] = Policy::template impl<T1, T2>(s, b[i]);
+        } else {
+            const T2 s = b[0];
+            for (std::size_t i = 0; i < n1; ++i) out[i] = Policy::template impl<T1, T2>(a[i], s);
+        }
+    }
+
+    // ---- operand detection
+    // Matches ParameterBase<T, Unit> and every class derived from it (Parameter, user CRTP classes).
+    template<class T, auto Unit>
+    ParameterBase<T, Unit> parameter_base_of(const ParameterBase<T, Unit>*);
+
+    template<class E>
+    struct is_parameter_expr : std::false_type {};
+
+    template<class Op, class L, class R>
+    struct is_parameter_expr<ParameterExpr<Op, L, R>> : std::true_type {};
+
+} // namespace detail
+
+    template<class P>
+    concept parameter_like = requires(const P* p) { detail::parameter_base_of(p); };
+
+    template<class E>
+    concept parameter_expression = detail::is_parameter_expr<E>::value;
+
+    template<class X>
+    concept parameter_operand = parameter_like<X> || parameter_expression<X>;
+
+namespace detail {
+
+    // ---- how an operand is held inside an expression node
+    // lvalue parameters by const reference to their ParameterBase, rvalue parameters and nested
+    // expressions by value
+    template<class X, class D = std::remove_cvref_t<X>>
+    struct operand_holder { using type = D; };
+
+    template<class X, class D>
+    requires parameter_like<D>
+    struct operand_holder<X, D> {
+        using base = decltype(parameter_base_of(std::declval<const D*>()));
+        using type = std::conditional_t<std::is_lvalue_reference_v<X>, const base&, base>;
+    };
+
+    template<class X>
+    using operand_holder_t = typename operand_holder<X>::type;
+
+    // ---- value type and unit of an operand (parameter or expression)
+    template<class X>
+    struct operand_traits {
+        using type = std::remove_cvref_t<X>;
+        using value_type = typename type::value_type;
+        static constexpr auto unit = type::GetUnit();
+    };
+
+    // ---- evaluators
+    // Before the fused loop runs, the expression tree is flattened into evaluators that only hold raw data
+    // pointers, so the loop body does not re-read container members through references.
+    template<class T>
+    struct leaf_evaluator {
+        const T* data;
+        std::size_t size;
+
+        // Dense: every leaf has the size of the result, so no broadcast check is needed
+        template<bool Dense>
+        const T& at(std::size_t i) const noexcept {
+            if constexpr (Dense) return data[i];
+            else return data[size == 1 ? 0 : i];
+        }
+        bool dense(std::size_t n) const noexcept { return size == n; }
+    };
+
+    // Policies with a lazy() (the waveform policies, see waveform.h) return an Eigen expression instead of a
+    // value; the enclosing node nests it and only the assignment in Eval() evaluates the samples.
+    template<class Policy, class TL, class TR, class A, class B>
+    concept lazy_policy = requires(const A& a, const B& b) { Policy::template lazy<TL, TR>(a, b); };
+
+    template<class Policy, class LE, class RE, class TL, class TR>
+    struct node_evaluator {
+        LE lhs;
+        RE rhs;
+
+        template<bool Dense>
+        auto at(std::size_t i) const {
+            using A = decltype(lhs.template at<Dense>(i));
+            using B = decltype(rhs.template at<Dense>(i));
+            if constexpr (lazy_policy<Policy, TL, TR, A, B>) {
+                return Policy::template lazy<TL, TR>(lhs.template at<Dense>(i), rhs.template at<Dense>(i));
+            } else {
+                return Policy::template impl<TL, TR>(lhs.template at<Dense>(i), rhs.template at<Dense>(i));
+            }
+        }
+        bool dense(std::size_t n) const noexcept { return lhs.dense(n) && rhs.dense(n); }
+    };
+
+    template<class T, auto Unit>
+    leaf_evaluator<T> make_evaluator(const ParameterBase<T, Unit>& p) {
+        const auto values = p.View();
+        return {values.data(), values.size()};
+    }
+
+    template<class Op, class L, class R>
+    auto make_evaluator(const ParameterExpr<Op, L, R>& e) { return e.Evaluator(); }
+
+} // namespace detail
+
+    // ---- op_allowed for two operands of a binary operator
+    template<class Op, class L, class R,
+             class TL = typename detail::operand_traits<L>::value_type,
+             class TR = typename detail::operand_traits<R>::value_type>
+    concept operand_op_allowed = op_allowed<op_policy<category_t<TL>, category_t<TR>, Op>, TL, TR>;
+
+    // ======== ParameterExpr: lazy binary expression node ========
+    template<class Op, class L, class R>
+    class ParameterExpr {
+        using lhs_value_type = typename detail::operand_traits<L>::value_type;
+        using rhs_value_type = typename detail::operand_traits<R>::value_type;
+
+    public:
+        using policy = op_policy<category_t<lhs_value_type>, category_t<rhs_value_type>, Op>;
+        using value_type = op_return_t<policy, lhs_value_type, rhs_value_type>;
+        static constexpr auto unit_ =
+            policy::template unit_of<detail::operand_traits<L>::unit, detail::operand_traits<R>::unit>();
+        using result_type = ParameterBase<value_type, unit_>;
+
+        template<class LA, class RA>
+        ParameterExpr(LA&& lhs, RA&& rhs) : lhs_(std::forward<LA>(lhs)), rhs_(std::forward<RA>(rhs)) {
+            (void)Size(); // report incompatible sizes where the expression is written
+        }
+
+        static constexpr auto GetUnit() noexcept { return unit_; }
+
+        // Number of values of the result, following the broadcasting rules
+        [[nodiscard]] std::size_t Size() const { return detail::broadcast_size(lhs_.Size(), rhs_.Size()); }
+
+        // Evaluate all values in a single fused pass
+        [[nodiscard]] result_type Eval() const {
+            const std::size_t n = Size();
+            const auto ev = Evaluator();
+            result_type result;
+            auto& values = result.Get();
+            values.resize_for_overwrite(n);
+            detail::instrument_temporary<value_type, unit_>(values);
+            write(ev, values.data(), n);
+            return result;
+        }
+
+        // Evaluate into the storage of a parameter (the assignment operators). Waveform values are written into
+        // the existing sample buffers when the storage already holds Size() values: element i only reads element i
+        // (or 0) of every operand, so the target may itself be an operand. The lengths are checked by building the
+        // expression of every element first, so an error leaves the storage unchanged. Otherwise the storage is
+        // replaced by Eval().
+        template<class Storage>
+        void EvalInto(Storage& values) const {
+            if constexpr (waveform_type<value_type>) {
+                const std::size_t n = Size();
+                if (values.size() == n) {
+                    const auto ev = Evaluator();
+                    for (std::size_t i = 0; i < n; ++i) (void)ev.template at<false>(i);
+                    write(ev, values.data(), n);
+                    return;
+                }
+            }
+            values = std::move(Eval().Get());
+        }
+
+        operator result_type() const { return Eval(); }
+
+        // First value; only that element is computed. Returned by value, an expression owns no storage
+        [[nodiscard]] value_type Val() const {
+            return Size() == 0 ? value_type{} : value_type(Evaluator().template at<false>(0));
+        }
+
+        [[nodiscard]] std::vector<value_type> Vals() const { return Eval().Vals(); }
+
+        // Value at index i (bounds-checked); only that element is computed
+        [[nodiscard]] value_type operator[](std::size_t i) const {
+            if (i >= Size()) throw std::out_of_range("ParameterExpr: index out of range");
+            return Evaluator().template at<false>(i);
+        }
+
+        // Flattened evaluator of this node, see detail::node_evaluator
+        auto Evaluator() const {
+            using LE = decltype(detail::make_evaluator(lhs_));
+            using RE = decltype(detail::make_evaluator(rhs_));
+            return detail::node_evaluator<policy, LE, RE, lhs_value_type, rhs_value_type>{
+                detail::make_evaluator(lhs_), detail::make_evaluator(rhs_)};
+        }
+
+    private:
+        L lhs_;
+        R rhs_;
+
+        template<class Ev>
+        static void write(const Ev& ev, value_type* out, std::size_t n) {
+            if (ev.dense(n)) {
+                for (std::size_t i = 0; i < n; ++i) out[i] = ev.template at<true>(i);
+            } else {
+                for (std::size_t i = 0; i < n; ++i) out[i] = ev.template at<false>(i);
+            }
+        }
+    };
+
+namespace detail {
+
+    template<class Op, class L, class R>
+    using make_expr_t = ParameterExpr<Op, operand_holder_t<L>, operand_holder_t<R>>;
+
+} // namespace detail
+
+    // ----------------
+    // Binary operators, element-wise over all values with NumPy-style broadcasting of size-1 operands.
+    // They return lazy ParameterExpr nodes, see the top of this file.
+    // ----------------
+    // ---- Operator +
+    template<class L, class R>
+    requires (parameter_operand<std::remove_cvref_t<L>> && parameter_operand<std::remove_cvref_t<R>> &&
+              operand_op_allowed<add_op, L, R>)
+    auto operator+(L&& lhs, R&& rhs) {
+        return detail::make_expr_t<add_op, L, R>(std::forward<L>(lhs), std::forward<R>(rhs));
+    }
+
+    // ---- Operator -
+    template<class L, class R>
+    requires (parameter_operand<std::remove_cvref_t<L>> && parameter_operand<std::remove_cvref_t<R>> &&
+              operand_op_allowed<sub_op, L, R>)
+    auto operator-(L&& lhs, R&& rhs) {
+        return detail::make_expr_t<sub_op, L, R>(std::forward<L>(lhs), std::forward<R>(rhs));
+    }
+
+    // ---- Operator *
+    template<class L, class R>
+    requires (parameter_operand<std::remove_cvref_t<L>> && parameter_operand<std::remove_cvref_t<R>> &&
+              operand_op_allowed<mul_op, L, R>)
+    auto operator*(L&& lhs, R&& rhs) {
+        return detail::make_expr_t<mul_op, L, R>(std::forward<L>(lhs), std::forward<R>(rhs));
+    }
+
+    // ---- Operator /
+    template<class L, class R>
+    requires (parameter_operand<std::remove_cvref_t<L>> && parameter_operand<std::remove_cvref_t<R>> &&
+              operand_op_allowed<div_op, L, R>)
+    auto operator/(L&& lhs, R&& rhs) {
+        return detail::make_expr_t<div_op, L, R>(std::forward<L>(lhs), std::forward<R>(rhs));
+    }
+
+namespace detail {
+
+    // ---- unit of an applied step
+    // string and bool policies have no unit_of: their operands are unitless and so is the result. A policy
+    // with a unit_of that rejects the operand units (e.g. s + m) rejects the step.
+    template<class Policy, auto Unit1, auto Unit2>
+    concept unit_rule_allowed = requires { Policy::template unit_of<Unit1, Unit2>(); } ||
+                                !requires { Policy::template unit_of<Unit1, Unit1>(); };
+
+    template<class Policy, auto Unit1, auto Unit2>
+    consteval auto applied_unit_of() {
+        if constexpr (requires { Policy::template unit_of<Unit1, Unit2>(); }) return Policy::template unit_of<Unit1, Unit2>();
+        else return Unit1;
+    }
+
+    template<class Policy, auto Unit1>
+    consteval auto applied_unit_of() {
+        if constexpr (requires { Policy::template unit_of<Unit1>(); }) return Policy::template unit_of<Unit1>();
+        else return Unit1;
+    }
+
+} // namespace detail
+
+    // ---- Eager evaluation of a single binary step
+    // Computes lhs Op rhs into a new ParameterBase right away. This is what every operator did before the
+    // expression templates; it is kept for callers that need a materialized result per step and as the
+    // reference for the fused path in the benchmarks.
+    template<class Op, class T1, auto Unit1, class T2, auto Unit2>
+    requires (op_allowed<op_policy<category_t<T1>, category_t<T2>, Op>, T1, T2> &&
+              detail::unit_rule_allowed<op_policy<category_t<T1>, category_t<T2>, Op>, Unit1, Unit2>)
+    auto EagerApply(const ParameterBase<T1, Unit1>& lhs, const ParameterBase<T2, Unit2>& rhs) {
+        using policy = op_policy<category_t<T1>, category_t<T2>, Op>;
+        using T3 = op_return_t<policy, T1, T2>;
+        constexpr auto Unit3 = detail::applied_unit_of<policy, Unit1, Unit2>();
+
+        const auto lhs_values = lhs.View();
+        const auto rhs_values = rhs.View();
+        ParameterBase<T3, Unit3> result;
+        auto& out = result.Get();
+        out.resize_for_overwrite(detail::broadcast_size(lhs_values.size(), rhs_values.size()));
+        detail::instrument_temporary<T3, Unit3>(out);
+        if constexpr (std::is_same_v<Op, div_op> && std::is_same_v<T2, Eigen::Matrix3d> &&
+                      (is_category_of<T1, eigen_rowvec_tag> || is_category_of<T1, eigen_mat_tag>)) {
+            // x / M = x * M^-1: the inverses come from the cache of rhs (see inverse_cache.h) or are computed
+            // once per value of rhs, not once per element when rhs is broadcast
+            using mul_policy = op_policy<category_t<T1>, eigen_mat_tag, mul_op>;
+            const auto* inverses = rhs.CachedInverse();
+            typename ParameterBase<T2, Unit2>::storage_type computed;
+            if (inverses == nullptr) {
+                computed.resize_for_overwrite(rhs_values.size());
+                InvertMatrices(rhs_values, {computed.data(), computed.size()});
+                inverses = &computed;
+            }
+            detail::elementwise<mul_policy>(lhs_values.data(), lhs_values.size(),
+                                            inverses->data(), inverses->size(), out.data());
+        } else {
+            detail::elementwise<policy>(lhs_values.data(), lhs_values.size(),
+                                        rhs_values.data(), rhs_values.size(), out.data());
+        }
+        return result;
+    }
+
+    // ---- Eager evaluation of a unary step (not_op, transpose_op, inverse_op), value by value
+    template<class Op, class T1, auto Unit1>
+    requires (op_policy<category_t<T1>, void, Op>::enabled &&
+              requires(const T1& v) { op_policy<category_t<T1>, void, Op>::template impl<T1>(v); })
+    auto EagerApply(const ParameterBase<T1, Unit1>& operand) {
+        using policy = op_policy<category_t<T1>, void, Op>;
+        using T3 = decltype(policy::template impl<T1>(std::declval<const T1&>()));
+        constexpr auto Unit3 = detail::applied_unit_of<policy, Unit1>();
+
+        const auto values = operand.View();
+        ParameterBase<T3, Unit3> result;
+        auto& out = result.Get();
+        out.resize_for_overwrite(values.size());
+        detail::instrument_temporary<T3, Unit3>(out);
+        if constexpr (std::is_same_v<Op, inverse_op> && std::is_same_v<T1, Eigen::Matrix3d>) {
+            // batched, or a copy of the cached inverses (see inverse_cache.h)
+            if (const auto* cached = operand.CachedInverse()) std::copy(cached->begin(), cached->end(), out.begin());
+            else InvertMatrices(values, {out.data(), out.size()});
+        } else {
+            for (std::size_t i = 0; i < values.size(); ++i) out[i] = policy::template impl<T1>(values[i]);
+        }
+        return result;
+    }
+
+}; // namespace methodverse::parameter
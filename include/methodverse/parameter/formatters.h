@@ -0,0 +1,95 @@
+// formatters.h
+// This file defines fmt::formatter specializations for the Eigen types of primitive_types (bool, int, double
+// and std::string are formatted by fmt itself). Eigen objects are written on a single line:
+//     Vector3d, RowVector3d  (1, 2, 3)
+//     Matrix3d               ((1, 0, 0), (0, 1, 0), (0, 0, 1))   row by row
+//     Quaterniond            (w, x, y, z)
+//     VectorXd, ArrayXd, ... (s0, s1, ..., sN-1)                 all samples of a waveform
+// The format spec applies to every coefficient, e.g. fmt::format("{:.3f}", v).
+// The formatter of ParameterBase is defined at the end of parameter.h.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <fmt/format.h>
+
+namespace methodverse::parameter::detail {
+
+    // Formats the coefficients of an Eigen object with the spec of the scalar formatter
+    template<class Scalar>
+    struct eigen_formatter_base : fmt::formatter<Scalar> {
+        template<class FormatContext>
+        auto format_list(const Scalar* values, int n, FormatContext& ctx) const {
+            auto out = ctx.out();
+            *out++ = '(';
+            for (int i = 0; i < n; ++i) {
+                if (i > 0) {
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                ctx.advance_to(out);
+                out = fmt::formatter<Scalar>::format(values[i], ctx);
+            }
+            *out++ = ')';
+            return out;
+        }
+    };
+
+} // namespace methodverse::parameter::detail
+
+// ---- fixed-size vectors and matrices
+template<class S, int R, int C, int O, int MR, int MC>
+    requires(R != Eigen::Dynamic && C != Eigen::Dynamic)
+struct fmt::formatter<Eigen::Matrix<S, R, C, O, MR, MC>> : methodverse::parameter::detail::eigen_formatter_base<S> {
+    template<class FormatContext>
+    auto format(const Eigen::Matrix<S, R, C, O, MR, MC>& m, FormatContext& ctx) const {
+        if constexpr (R == 1 || C == 1) {
+            return this->format_list(m.data(), R * C, ctx);
+        } else {
+            auto out = ctx.out();
+            *out++ = '(';
+            for (int r = 0; r < R; ++r) {
+                if (r > 0) {
+                    *out++ = ',';
+                    *out++ = ' ';
+                }
+                S row[C];
+                for (int c = 0; c < C; ++c) row[c] = m(r, c);
+                ctx.advance_to(out);
+                out = this->format_list(row, C, ctx);
+            }
+            *out++ = ')';
+            return out;
+        }
+    }
+};
+
+// ---- dynamic-size column vectors and arrays (waveforms)
+template<class S, int O, int MR, int MC>
+struct fmt::formatter<Eigen::Matrix<S, Eigen::Dynamic, 1, O, MR, MC>> : methodverse::parameter::detail::eigen_formatter_base<S> {
+    template<class FormatContext>
+    auto format(const Eigen::Matrix<S, Eigen::Dynamic, 1, O, MR, MC>& v, FormatContext& ctx) const {
+        return this->format_list(v.data(), static_cast<int>(v.size()), ctx);
+    }
+};
+
+template<class S, int O, int MR, int MC>
+struct fmt::formatter<Eigen::Array<S, Eigen::Dynamic, 1, O, MR, MC>> : methodverse::parameter::detail::eigen_formatter_base<S> {
+    template<class FormatContext>
+    auto format(const Eigen::Array<S, Eigen::Dynamic, 1, O, MR, MC>& a, FormatContext& ctx) const {
+        return this->format_list(a.data(), static_cast<int>(a.size()), ctx);
+    }
+};
+
+// ---- quaternions, scalar part first
+template<class S, int O>
+struct fmt::formatter<Eigen::Quaternion<S, O>> : methodverse::parameter::detail::eigen_formatter_base<S> {
+    template<class FormatContext>
+    auto format(const Eigen::Quaternion<S, O>& q, FormatContext& ctx) const {
+        const S values[4] = {q.w(), q.x(), q.y(), q.z()};
+        return this->format_list(values, 4, ctx);
+    }
+};
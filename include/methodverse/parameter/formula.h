@@ -0,0 +1,278 @@
+// formula.h
+// This file defines Formula, a compiled expression over named parameters, e.g.
+//     TE_min = t_exc/2 + t_ref + t_adc/2
+// The text is parsed once into a register bytecode. Every instruction is a kernel of the runtime dispatch
+// table (dispatch.h), i.e. an op_policy implementation, that writes into a register preallocated at compile
+// time, so re-evaluating a formula performs no parsing, no lookup and, for values that fit the inline
+// storage, no allocation. Value types and units are resolved at compile time from the bound parameters
+// (TypeId(), GetRuntimeUnit()), so type and unit errors are reported when the formula is compiled.
+// Sub-expressions over literals only are folded into constants.
+//
+// Grammar:
+//     formula := [name '='] expr
+//     expr    := term (('+' | '-') term)*
+//     term    := unary (('*' | '/') unary)*
+//     unary   := '-' unary | primary
+//     primary := number | name | name '(' expr ',' expr ')' | '(' expr ')'
+// name(a, b) calls a dispatch op by name (dot, cross, and, or, xor, xnor). Number literals are
+// dimensionless doubles.
+// The bound parameters are referenced, not copied: they must outlive the formula and keep their value
+// type, but their values (and sizes) may change between evaluations.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "dispatch.h"
+
+namespace methodverse::parameter {
+
+    // ---- parameters a formula may refer to, by name
+    using FormulaSymbols = std::unordered_map<std::string, const IParameter*>;
+
+    // ======== Formula ========
+    class Formula {
+    public:
+        // Compile text; throws std::invalid_argument for syntax errors, unknown names, undefined operators and
+        // incompatible units, with the position in the text
+        Formula(std::string_view text, const FormulaSymbols& symbols) : text_(text) {
+            parser p{*this, text_, symbols};
+            result_ = p.parse();
+        }
+
+        Formula(Formula&&) noexcept = default;
+        Formula& operator=(Formula&&) noexcept = default;
+
+        // Run the bytecode and return the result
+        const IParameter& Evaluate() {
+            for (const auto& ins : code_) ins.fn(*ins.lhs, *ins.rhs, *ins.out);
+            return *result_.param;
+        }
+
+        // Evaluate into a typed parameter; throws std::invalid_argument if the value type or unit differ
+        template<class T, auto Unit>
+        void EvaluateInto(ParameterBase<T, Unit>& target) {
+            if (result_.param->TypeId() != primitive_type_id_v<T>) {
+                throw std::invalid_argument("Formula: '" + text_ + "' does not evaluate to the value type of the target");
+            }
+            if (!(result_.param->GetRuntimeUnit() == runtime_unit_of<Unit>)) {
+                throw std::invalid_argument("Formula: '" + text_ + "' has unit " + GetRuntimeUnit().ToString() +
+                                            ", target has " + runtime_unit_of<Unit>.ToString());
+            }
+            const auto values = Evaluate().UncheckedViewAs<T>();
+            target.Get().assign(values.begin(), values.end());
+            target.NotifyChanged();
+        }
+
+        // The result register, up to date after Evaluate(). It can be bound as a symbol of other formulas.
+        [[nodiscard]] const IParameter& Result() const noexcept { return *result_.param; }
+
+        [[nodiscard]] RuntimeUnit GetRuntimeUnit() const noexcept { return result_.param->GetRuntimeUnit(); }
+        [[nodiscard]] std::size_t TypeId() const noexcept { return result_.param->TypeId(); }
+        [[nodiscard]] const std::string& Text() const noexcept { return text_; }
+
+        // The bound parameters the formula reads, each once, in order of first use
+        [[nodiscard]] const std::vector<const IParameter*>& Inputs() const noexcept { return inputs_; }
+
+        // Name before '=' in the text, empty if the formula has none
+        [[nodiscard]] const std::string& Target() const noexcept { return target_; }
+
+        // Number of bytecode instructions (0 when the formula is a single name or a constant)
+        [[nodiscard]] std::size_t InstructionCount() const noexcept { return code_.size(); }
+
+    private:
+        // out = lhs op rhs
+        struct instruction {
+            detail::dispatch_into_fn fn;
+            const IParameter* lhs;
+            const IParameter* rhs;
+            IParameter* out;
+        };
+
+        // an operand during compilation: a bound parameter, a constant or a register
+        struct operand {
+            const IParameter* param = nullptr;
+            bool constant = false;
+        };
+
+        class parser {
+        public:
+            parser(Formula& f, std::string_view text, const FormulaSymbols& symbols)
+                : f_(f), text_(text), symbols_(symbols) {}
+
+            operand parse() {
+                // optional "name =" naming the parameter the formula defines
+                skip_space();
+                const std::size_t start = pos_;
+                while (pos_ < text_.size() &&
+                       (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) ++pos_;
+                const std::size_t name_end = pos_;
+                if (name_end > start && !std::isdigit(static_cast<unsigned char>(text_[start])) && accept('=')) {
+                    f_.target_ = std::string(text_.substr(start, name_end - start));
+                } else {
+                    pos_ = start;
+                }
+
+                const operand r = expr();
+                skip_space();
+                if (pos_ != text_.size()) fail("unexpected '" + std::string(1, text_[pos_]) + "'");
+                return r;
+            }
+
+        private:
+            Formula& f_;
+            std::string_view text_;
+            const FormulaSymbols& symbols_;
+            std::size_t pos_ = 0;
+
+            [[noreturn]] void fail(const std::string& what, std::size_t at) const {
+                throw std::invalid_argument("Formula: " + what + " at position " + std::to_string(at) + " in '" +
+                                            std::string(text_) + "'");
+            }
+            [[noreturn]] void fail(const std::string& what) const { fail(what, pos_); }
+
+            void skip_space() {
+                while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) ++pos_;
+            }
+
+            bool accept(char c) {
+                skip_space();
+                if (pos_ < text_.size() && text_[pos_] == c) {
+                    ++pos_;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(char c) {
+                if (!accept(c)) fail(std::string("expected '") + c + "'");
+            }
+
+            operand expr() {
+                operand lhs = term();
+                for (;;) {
+                    const std::size_t at = (skip_space(), pos_);
+                    if (accept('+')) lhs = f_.emit(dispatch_op_id_v<add_op>, lhs, term(), *this, at);
+                    else if (accept('-')) lhs = f_.emit(dispatch_op_id_v<sub_op>, lhs, term(), *this, at);
+                    else return lhs;
+                }
+            }
+
+            operand term() {
+                operand lhs = unary();
+                for (;;) {
+                    const std::size_t at = (skip_space(), pos_);
+                    if (accept('*')) lhs = f_.emit(dispatch_op_id_v<mul_op>, lhs, unary(), *this, at);
+                    else if (accept('/')) lhs = f_.emit(dispatch_op_id_v<div_op>, lhs, unary(), *this, at);
+                    else return lhs;
+                }
+            }
+
+            operand unary() {
+                const std::size_t at = (skip_space(), pos_);
+                if (accept('-')) return f_.emit(dispatch_op_id_v<mul_op>, f_.constant(-1.0), unary(), *this, at);
+                return primary();
+            }
+
+            operand primary() {
+                skip_space();
+                if (pos_ == text_.size()) fail("unexpected end of formula");
+                const char c = text_[pos_];
+                if (c == '(') {
+                    ++pos_;
+                    const operand r = expr();
+                    expect(')');
+                    return r;
+                }
+                if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') return number();
+                if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') return name();
+                fail("unexpected '" + std::string(1, c) + "'");
+            }
+
+            operand number() {
+                double value = 0.0;
+                const auto [end, ec] = std::from_chars(text_.data() + pos_, text_.data() + text_.size(), value);
+                if (ec != std::errc{}) fail("invalid number");
+                pos_ = static_cast<std::size_t>(end - text_.data());
+                return f_.constant(value);
+            }
+
+            operand name() {
+                const std::size_t at = pos_;
+                while (pos_ < text_.size() &&
+                       (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_')) ++pos_;
+                const std::string id(text_.substr(at, pos_ - at));
+
+                if (accept('(')) {
+                    const auto op = FindDispatchOp(id);
+                    if (!op) fail("unknown function '" + id + "'", at);
+                    const operand lhs = expr();
+                    expect(',');
+                    const operand rhs = expr();
+                    expect(')');
+                    return f_.emit(*op, lhs, rhs, *this, at);
+                }
+
+                const auto it = symbols_.find(id);
+                if (it == symbols_.end() || it->second == nullptr) fail("unknown parameter '" + id + "'", at);
+                if (it->second->TypeId() >= primitive_type_count) {
+                    fail("parameter '" + id + "' does not store a primitive value type", at);
+                }
+                if (std::find(f_.inputs_.begin(), f_.inputs_.end(), it->second) == f_.inputs_.end()) {
+                    f_.inputs_.push_back(it->second);
+                }
+                return {it->second, false};
+            }
+
+            friend class Formula;
+        };
+
+        std::string text_;
+        std::string target_;
+        std::vector<const IParameter*> inputs_;
+        std::vector<instruction> code_;
+        std::vector<std::unique_ptr<IParameter>> registers_; // results of instructions and constants
+        operand result_;
+
+        operand constant(double value) {
+            auto c = std::make_unique<DynamicParameter<double>>(RuntimeUnit{});
+            c->Get().assign(1, value);
+            registers_.push_back(std::move(c));
+            return {registers_.back().get(), true};
+        }
+
+        // Compile lhs op rhs: fold it if both operands are constants, otherwise append an instruction
+        operand emit(std::size_t op_id, operand lhs, operand rhs, const parser& p, std::size_t at) {
+            const std::size_t l = lhs.param->TypeId();
+            const std::size_t r = rhs.param->TypeId();
+            const auto& entry = detail::dispatch_table[op_id][l * primitive_type_count + r];
+            if (entry.apply_into == nullptr) p.fail(detail::undefined_op_message(op_id, l, r), at);
+
+            const RuntimeUnit lu = lhs.param->GetRuntimeUnit();
+            const RuntimeUnit ru = rhs.param->GetRuntimeUnit();
+            if (!detail::unit_rule_accepts(entry.unit_rule, lu, ru)) p.fail(detail::unit_mismatch_message(op_id, lu, ru), at);
+            const RuntimeUnit unit = detail::unit_rule_result(entry.unit_rule, lu, ru);
+
+            registers_.push_back(MakeDynamicParameter(entry.result_type_id, unit));
+            IParameter* out = registers_.back().get();
+            if (lhs.constant && rhs.constant) {
+                entry.apply_into(*lhs.param, *rhs.param, *out);
+                return {out, true};
+            }
+            code_.push_back({entry.apply_into, lhs.param, rhs.param, out});
+            return {out, false};
+        }
+    };
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,184 @@
+// graph.h
+// This file defines ParameterGraph, the dependency graph between the parameters of a protocol.
+// A derived parameter is registered with the parameters it reads and a function that recomputes it
+// (for a Formula, both come from the compiled formula). When a parameter changes, only its transitive
+// dependents are marked dirty; they are recomputed lazily, inputs first, when they are read through
+// Refresh() or when RefreshAll() is called, so a single edit only recomputes the affected cone.
+// Registrations that would create a cycle are rejected.
+// The graph does not own the parameters, they must outlive it.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "formula.h"
+
+namespace methodverse::parameter {
+
+    class ParameterGraph {
+    public:
+        using node_id = std::size_t;
+
+        // ---- registration
+        // Register p as an input parameter (done implicitly for the inputs of derived parameters)
+        node_id AddSource(const IParameter& p) {
+            if (const auto it = index_.find(&p); it != index_.end()) return it->second;
+            const node_id id = nodes_.size();
+            nodes_.emplace_back(&p);
+            index_.emplace(&p, id);
+            return id;
+        }
+
+        // Register p as computed by compute() from inputs. p starts dirty.
+        // Throws std::invalid_argument if p is already derived or if p is (transitively) one of its inputs.
+        node_id AddDerived(const IParameter& p, std::span<const IParameter* const> inputs, std::function<void()> compute) {
+            const auto existing = index_.find(&p);
+            if (existing != index_.end() && nodes_[existing->second].compute) {
+                throw std::invalid_argument("ParameterGraph: " + p.Name() + " is already a derived parameter");
+            }
+            for (const IParameter* in : inputs) {
+                // a new node has no dependents yet, so only a direct self reference can close a cycle
+                if (in == &p || (existing != index_.end() && depends_on(index_.find(in), existing->second))) {
+                    throw std::invalid_argument("ParameterGraph: adding " + p.Name() + " would create a cycle");
+                }
+            }
+
+            const node_id id = AddSource(p);
+            for (const IParameter* in : inputs) {
+                const node_id in_id = AddSource(*in);
+                nodes_[id].inputs.push_back(in_id);
+                nodes_[in_id].dependents.push_back(id);
+            }
+            nodes_[id].compute = std::move(compute);
+            mark_dirty(id);
+            return id;
+        }
+
+        node_id AddDerived(const IParameter& p, std::initializer_list<const IParameter*> inputs, std::function<void()> compute) {
+            return AddDerived(p, std::span<const IParameter* const>(inputs.begin(), inputs.size()), std::move(compute));
+        }
+
+        // Register a compiled formula: its Result() is computed from its Inputs()
+        node_id AddFormula(Formula& f) {
+            return AddDerived(f.Result(), f.Inputs(), [&f] { (void)f.Evaluate(); });
+        }
+
+        // ---- change propagation
+        // Mark every parameter that depends on p dirty; p itself is taken as up to date
+        void MarkChanged(const IParameter& p) {
+            const auto it = index_.find(&p);
+            if (it == index_.end()) return;
+            for (node_id d : nodes_[it->second].dependents) mark_dirty(d);
+        }
+
+        // Assign a value and propagate the change, e.g. graph.Set(matrix_size, 256)
+        template<class P, class V>
+        void Set(P& p, V&& value) {
+            p = std::forward<V>(value);
+            MarkChanged(p);
+        }
+
+        // Bring p up to date, recomputing its dirty inputs first
+        const IParameter& Refresh(const IParameter& p) {
+            if (const auto it = index_.find(&p); it != index_.end()) refresh(it->second);
+            return p;
+        }
+
+        // Recompute every dirty parameter
+        void RefreshAll() {
+            // refresh() removes nodes from dirty_ while it runs, so work on a snapshot
+            std::vector<node_id> pending;
+            pending.swap(dirty_);
+            for (node_id id : pending) refresh(id);
+        }
+
+        // ---- inspection
+        [[nodiscard]] bool IsDirty(const IParameter& p) const {
+            const auto it = index_.find(&p);
+            return it != index_.end() && nodes_[it->second].dirty;
+        }
+        [[nodiscard]] std::size_t DirtyCount() const noexcept { return dirty_count_; }
+        [[nodiscard]] std::size_t Size() const noexcept { return nodes_.size(); }
+
+        // Number of compute() calls since construction, to check that only the affected cone is recomputed
+        [[nodiscard]] std::size_t RecomputeCount() const noexcept { return recompute_count_; }
+
+    private:
+        struct node {
+            explicit node(const IParameter* p) noexcept : param(p) {}
+
+            const IParameter* param = nullptr;
+            std::vector<node_id> inputs;
+            std::vector<node_id> dependents;
+            std::function<void()> compute; // empty for sources
+            bool dirty = false;
+        };
+
+        std::vector<node> nodes_;
+        std::unordered_map<const IParameter*, node_id> index_;
+        std::vector<node_id> dirty_; // may hold nodes that were refreshed since, see RefreshAll()
+        std::size_t dirty_count_ = 0;
+        std::size_t recompute_count_ = 0;
+
+        // true if the node at it (transitively) depends on target; it may be index_.end()
+        bool depends_on(std::unordered_map<const IParameter*, node_id>::const_iterator it, node_id target) const {
+            if (it == index_.end()) return false;
+            std::vector<node_id> stack{it->second};
+            std::vector<bool> seen(nodes_.size(), false);
+            while (!stack.empty()) {
+                const node_id id = stack.back();
+                stack.pop_back();
+                if (id == target) return true;
+                if (seen[id]) continue;
+                seen[id] = true;
+                for (node_id in : nodes_[id].inputs) stack.push_back(in);
+            }
+            return false;
+        }
+
+        // A dirty node has only dirty dependents, so the walk stops at nodes that are already dirty
+        void mark_dirty(node_id id) {
+            std::vector<node_id> stack{id};
+            while (!stack.empty()) {
+                const node_id n = stack.back();
+                stack.pop_back();
+                if (nodes_[n].dirty) continue;
+                nodes_[n].dirty = true;
+                ++dirty_count_;
+                push_dirty(n);
+                for (node_id d : nodes_[n].dependents) stack.push_back(d);
+            }
+        }
+
+        // nodes refreshed through Refresh() stay in dirty_ until RefreshAll(); drop them if the list grows
+        void push_dirty(node_id id) {
+            if (dirty_.size() >= 2 * nodes_.size()) {
+                std::erase_if(dirty_, [this](node_id d) { return !nodes_[d].dirty; });
+            }
+            dirty_.push_back(id);
+        }
+
+        // Depth-first: inputs are recomputed before the node, i.e. in topological order
+        void refresh(node_id id) {
+            node& n = nodes_[id];
+            if (!n.dirty) return;
+            for (node_id in : n.inputs) refresh(in);
+            if (n.compute) {
+                n.compute();
+                ++recompute_count_;
+            }
+            n.dirty = false;
+            --dirty_count_;
+        }
+    };
+
+}; // namespace methodverse::parameter
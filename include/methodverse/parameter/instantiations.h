@@ -0,0 +1,34 @@
+// instantiations.h
+// This file lists the ParameterBase<T, Unit> specializations that the methodverse-parameter-impl library
+// compiles once, so the translation units that use them do not instantiate their virtual functions (the
+// fmt formatting of ValueAsString() and FormatValueTo(), ValueBytes(), ...) and vtables again.
+// Linking methodverse-parameter-impl defines METHODVERSE_PARAMETER_EXTERN_TEMPLATES, and parameter.h then
+// declares the specializations below extern; src/parameter/instantiations.cpp defines them. Other
+// specializations are still instantiated implicitly where they are used.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+// X(T, Unit) for each compiled specialization
+#define METHODVERSE_PARAMETER_INSTANTIATIONS(X)                                                                     \
+    X(bool, mp_units::one)                                                                                          \
+    X(std::string, mp_units::one)                                                                                   \
+    X(int, mp_units::one)                                                                                           \
+    X(double, mp_units::one)                                                                                        \
+    X(double, mp_units::si::second)                                                                                 \
+    X(double, mp_units::si::milli<mp_units::si::second>)                                                            \
+    X(double, mp_units::si::metre)                                                                                  \
+    X(double, mp_units::si::milli<mp_units::si::metre>)                                                             \
+    X(double, mp_units::si::hertz)                                                                                  \
+    X(double, mp_units::si::radian)                                                                                 \
+    X(double, mp_units::si::tesla)                                                                                  \
+    X(Eigen::Vector3d, mp_units::one)                                                                               \
+    X(Eigen::Vector3d, mp_units::si::metre)                                                                         \
+    X(Eigen::Vector3d, mp_units::si::milli<mp_units::si::metre>)                                                    \
+    X(Eigen::RowVector3d, mp_units::one)                                                                            \
+    X(Eigen::Matrix3d, mp_units::one)                                                                               \
+    X(Eigen::Quaterniond, mp_units::one)
+
+#define METHODVERSE_PARAMETER_EXTERN_INSTANTIATION(T, Unit) extern template class ParameterBase<T, Unit>;
+#define METHODVERSE_PARAMETER_INSTANTIATION(T, Unit) template class ParameterBase<T, Unit>;
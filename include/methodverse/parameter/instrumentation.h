@@ -0,0 +1,353 @@
+// instrumentation.h
+// This file defines the opt-in instrumentation of ParameterBase: counts of constructions, copies, moves,
+// value assignments, operator temporaries (EagerApply and ParameterExpr::Eval results), Vals() calls, heap
+// allocations and allocated bytes, per (T, Unit) specialization and per parameter name.
+// It is compiled out unless METHODVERSE_PARAMETER_INSTRUMENTATION is defined (CMake option of the same name);
+// the hooks are then empty and the report is empty. The macro changes the layout of Parameter, so it must be
+// the same for every translation unit of a program.
+//     auto report = CollectInstrumentation(); std::puts(report.ToText().c_str());
+//     METHODVERSE_PARAMETER_INSTRUMENTATION_REPORT=prepare.json ./app   // written at exit, "-" for stderr
+// Constructions, copies and moves of a Parameter<T, Derived, Unit> are attributed to Derived::name; the other
+// events to NameView() of the object. Plain ParameterBase objects and temporaries only count per type.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include <fmt/format.h>
+#include <mp-units/core.h>
+#include "tags.h"
+
+namespace methodverse::parameter {
+
+#if defined(METHODVERSE_PARAMETER_INSTRUMENTATION)
+    inline constexpr bool instrumentation_enabled = true;
+#else
+    inline constexpr bool instrumentation_enabled = false;
+#endif
+
+    // ---- counters of one (T, Unit) specialization or one parameter name
+    struct InstrumentationCounters {
+        std::uint64_t constructions = 0; // default, from values or from an expression
+        std::uint64_t copies = 0;        // copy construction and copy assignment
+        std::uint64_t moves = 0;         // move construction and move assignment
+        std::uint64_t assignments = 0;   // Set() and value/expression assignments
+        std::uint64_t temporaries = 0;   // results materialized by EagerApply and ParameterExpr::Eval
+        std::uint64_t vals = 0;          // Vals() calls, each copies the values into a std::vector
+        std::uint64_t allocations = 0;   // heap buffers acquired by the events above
+        std::uint64_t bytes = 0;         // bytes of those buffers
+    };
+
+    struct InstrumentationEntry {
+        std::string key; // "double [s]" for a specialization, the parameter name otherwise
+        InstrumentationCounters counters;
+    };
+
+    struct InstrumentationReport {
+        std::vector<InstrumentationEntry> types; // sorted by allocated bytes, then allocations
+        std::vector<InstrumentationEntry> names;
+
+        [[nodiscard]] std::string ToText() const;
+        [[nodiscard]] std::string ToJson() const;
+    };
+
+namespace detail {
+
+    enum class instrument_event { construction, copy, move, assignment, temporary, vals };
+
+    // counters of one key; blocks are created once and never freed, so they outlive the static objects
+    // whose destructors may still copy parameters, and the report written at exit can read them
+    struct instrument_block {
+        std::string key;
+        std::array<std::atomic<std::uint64_t>, 8> counts{};
+
+        void add(instrument_event event, std::uint64_t heap_bytes) noexcept {
+            counts[static_cast<std::size_t>(event)].fetch_add(1, std::memory_order_relaxed);
+            if (heap_bytes > 0) {
+                counts[6].fetch_add(1, std::memory_order_relaxed);
+                counts[7].fetch_add(heap_bytes, std::memory_order_relaxed);
+            }
+        }
+
+        [[nodiscard]] InstrumentationCounters load() const noexcept {
+            auto at = [&](std::size_t i) { return counts[i].load(std::memory_order_relaxed); };
+            return {at(0), at(1), at(2), at(3), at(4), at(5), at(6), at(7)};
+        }
+    };
+
+    inline void write_instrumentation_at_exit();
+
+    class instrument_registry {
+    public:
+        static instrument_registry& Instance() {
+            static instrument_registry* registry = new instrument_registry; // never destroyed, see instrument_block
+            return *registry;
+        }
+
+        instrument_block& Type(std::string key) { return Find(types_, std::move(key)); }
+        instrument_block& Name(std::string_view key) { return Find(names_, std::string(key)); }
+
+        InstrumentationReport Collect() {
+            const std::lock_guard lock(mutex_);
+            InstrumentationReport report;
+            for (const auto& [key, block] : types_) report.types.push_back({key, block->load()});
+            for (const auto& [key, block] : names_) report.names.push_back({key, block->load()});
+            auto heaviest_first = [](const InstrumentationEntry& a, const InstrumentationEntry& b) {
+                if (a.counters.bytes != b.counters.bytes) return a.counters.bytes > b.counters.bytes;
+                return a.counters.allocations > b.counters.allocations;
+            };
+            std::stable_sort(report.types.begin(), report.types.end(), heaviest_first);
+            std::stable_sort(report.names.begin(), report.names.end(), heaviest_first);
+            return report;
+        }
+
+        void Reset() {
+            const std::lock_guard lock(mutex_);
+            for (auto* blocks : {&types_, &names_}) {
+                for (auto& [key, block] : *blocks) {
+                    for (auto& c : block->counts) c.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void SetReportPath(std::string path) {
+            const std::lock_guard lock(mutex_);
+            if (report_path_.empty() && !path.empty()) std::atexit(write_instrumentation_at_exit);
+            report_path_ = std::move(path);
+        }
+
+        std::string ReportPath() {
+            const std::lock_guard lock(mutex_);
+            return report_path_;
+        }
+
+    private:
+        instrument_registry() {
+            if (const char* path = std::getenv("METHODVERSE_PARAMETER_INSTRUMENTATION_REPORT")) SetReportPath(path);
+        }
+
+        instrument_block& Find(std::map<std::string, instrument_block*>& blocks, std::string key) {
+            const std::lock_guard lock(mutex_);
+            auto [it, inserted] = blocks.try_emplace(std::move(key), nullptr);
+            if (inserted) {
+                it->second = new instrument_block;
+                it->second->key = it->first;
+            }
+            return *it->second;
+        }
+
+        std::mutex mutex_;
+        std::map<std::string, instrument_block*> types_;
+        std::map<std::string, instrument_block*> names_;
+        std::string report_path_;
+    };
+
+    // ---- block of a (T, Unit) specialization, labelled "double [s]"
+    template<class T, auto Unit>
+    instrument_block& instrument_type_block() {
+        static instrument_block& block = []() -> instrument_block& {
+            std::string label;
+            if constexpr (is_allowed_primitive<T>) label = primitive_type_names[primitive_type_id_v<T>];
+            else label = typeid(T).name();
+            constexpr std::string_view symbol = mp_units::unit_symbol(mp_units::get_unit(Unit));
+            if (!symbol.empty()) label += fmt::format(" [{}]", symbol);
+            return instrument_registry::Instance().Type(std::move(label));
+        }();
+        return block;
+    }
+
+    // ---- block of a parameter name. The per-thread cache keys on the text, not on the address: NameView() of a
+    // snapshot or of a run-time named parameter points into memory that is freed and reused.
+    struct instrument_name_hash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    inline instrument_block& instrument_name_block(std::string_view name) {
+        thread_local std::unordered_map<std::string, instrument_block*, instrument_name_hash, std::equal_to<>> cache;
+        if (const auto it = cache.find(name); it != cache.end()) return *it->second;
+        instrument_block& block = instrument_registry::Instance().Name(name);
+        cache.emplace(name, &block);
+        return block;
+    }
+
+    // ---- the last ParameterBase construction on this thread, taken by instrument_name_tag right after
+    struct instrument_pending {
+        instrument_event event = instrument_event::construction;
+        std::uint64_t heap_bytes = 0;
+        bool set = false;
+    };
+
+    inline thread_local instrument_pending pending_construction;
+
+    template<class T, auto Unit>
+    void instrument_construction(instrument_event event, std::uint64_t heap_bytes) noexcept {
+        if constexpr (instrumentation_enabled) {
+            instrument_type_block<T, Unit>().add(event, heap_bytes);
+            pending_construction = {event, heap_bytes, true};
+        }
+    }
+
+    // name is NameView() of a fully constructed object; "ParameterBase" means unnamed
+    template<class T, auto Unit>
+    void instrument_update(instrument_event event, std::string_view name, std::uint64_t heap_bytes) noexcept {
+        if constexpr (instrumentation_enabled) {
+            instrument_type_block<T, Unit>().add(event, heap_bytes);
+            if (name != "ParameterBase") instrument_name_block(name).add(event, heap_bytes);
+        }
+    }
+
+    // result of an operator, after its storage was sized
+    template<class T, auto Unit, class Storage>
+    void instrument_temporary(const Storage& values) noexcept {
+        if constexpr (instrumentation_enabled) {
+            instrument_type_block<T, Unit>().add(instrument_event::temporary,
+                                                 values.is_inline() ? 0 : values.capacity() * sizeof(T));
+        }
+    }
+
+    // ---- member of Parameter<T, Derived, Unit> (only with instrumentation): its constructors run right after
+    // those of the ParameterBase subobject and attribute that construction to Derived::name
+    template<class Derived>
+    struct instrument_name_tag {
+        instrument_name_tag() noexcept { take(); }
+        instrument_name_tag(const instrument_name_tag&) noexcept { take(); }
+        instrument_name_tag(instrument_name_tag&&) noexcept { take(); }
+        instrument_name_tag& operator=(const instrument_name_tag&) noexcept = default;
+        instrument_name_tag& operator=(instrument_name_tag&&) noexcept = default;
+
+    private:
+        static void take() noexcept {
+            if (pending_construction.set) {
+                instrument_name_block(Derived::name).add(pending_construction.event, pending_construction.heap_bytes);
+                pending_construction.set = false;
+            }
+        }
+    };
+
+    // a JSON string literal: type keys and parameter names are arbitrary text
+    inline void format_json_string(fmt::memory_buffer& out, std::string_view s) {
+        out.push_back('"');
+        for (const char c : s) {
+            switch (c) {
+                case '"': fmt::format_to(fmt::appender(out), "\\\""); break;
+                case '\\': fmt::format_to(fmt::appender(out), "\\\\"); break;
+                case '\n': fmt::format_to(fmt::appender(out), "\\n"); break;
+                case '\r': fmt::format_to(fmt::appender(out), "\\r"); break;
+                case '\t': fmt::format_to(fmt::appender(out), "\\t"); break;
+                default:
+                    if (static_cast<unsigned char>(c) >= 0x20) out.push_back(c);
+                    else fmt::format_to(fmt::appender(out), "\\u{:04x}", static_cast<int>(c));
+            }
+        }
+        out.push_back('"');
+    }
+
+    inline void format_counters_json(fmt::memory_buffer& out, const std::vector<InstrumentationEntry>& entries) {
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            const InstrumentationCounters& c = entries[i].counters;
+            fmt::format_to(fmt::appender(out), "    {{\"key\": ");
+            format_json_string(out, entries[i].key);
+            fmt::format_to(fmt::appender(out),
+                           ", \"constructions\": {}, \"copies\": {}, \"moves\": {}, "
+                           "\"assignments\": {}, \"temporaries\": {}, \"vals\": {}, \"allocations\": {}, "
+                           "\"bytes\": {}}}{}\n",
+                           c.constructions, c.copies, c.moves, c.assignments, c.temporaries, c.vals,
+                           c.allocations, c.bytes, i + 1 < entries.size() ? "," : "");
+        }
+    }
+
+    inline void format_counters_text(fmt::memory_buffer& out, std::string_view title,
+                                     const std::vector<InstrumentationEntry>& entries) {
+        fmt::format_to(fmt::appender(out), "{:<32} {:>13} {:>10} {:>10} {:>11} {:>11} {:>8} {:>11} {:>14}\n", title,
+                       "constructions", "copies", "moves", "assignments", "temporaries", "vals", "allocations",
+                       "bytes");
+        for (const InstrumentationEntry& e : entries) {
+            const InstrumentationCounters& c = e.counters;
+            fmt::format_to(fmt::appender(out), "{:<32} {:>13} {:>10} {:>10} {:>11} {:>11} {:>8} {:>11} {:>14}\n",
+                           e.key, c.constructions, c.copies, c.moves, c.assignments, c.temporaries, c.vals,
+                           c.allocations, c.bytes);
+        }
+    }
+
+} // namespace detail
+
+    inline std::string InstrumentationReport::ToText() const {
+        fmt::memory_buffer out;
+        detail::format_counters_text(out, "by type", types);
+        fmt::format_to(fmt::appender(out), "\n");
+        detail::format_counters_text(out, "by name", names);
+        return fmt::to_string(out);
+    }
+
+    inline std::string InstrumentationReport::ToJson() const {
+        fmt::memory_buffer out;
+        fmt::format_to(fmt::appender(out), "{{\n  \"types\": [\n");
+        detail::format_counters_json(out, types);
+        fmt::format_to(fmt::appender(out), "  ],\n  \"names\": [\n");
+        detail::format_counters_json(out, names);
+        fmt::format_to(fmt::appender(out), "  ]\n}}\n");
+        return fmt::to_string(out);
+    }
+
+    // ---- snapshot of all counters; empty without METHODVERSE_PARAMETER_INSTRUMENTATION
+    [[nodiscard]] inline InstrumentationReport CollectInstrumentation() {
+        if constexpr (instrumentation_enabled) return detail::instrument_registry::Instance().Collect();
+        else return {};
+    }
+
+    // ---- zero all counters, e.g. before the section of interest
+    inline void ResetInstrumentation() {
+        if constexpr (instrumentation_enabled) detail::instrument_registry::Instance().Reset();
+    }
+
+    // ---- write the report to path: JSON if it ends with ".json", text otherwise, stderr for "-".
+    // Throws std::runtime_error if the file cannot be written.
+    inline void WriteInstrumentationReport(const std::string& path) {
+        const InstrumentationReport report = CollectInstrumentation();
+        const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+        const std::string text = json ? report.ToJson() : report.ToText();
+        if (path == "-") {
+            std::fputs(text.c_str(), stderr);
+            return;
+        }
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) throw std::runtime_error("WriteInstrumentationReport: cannot write " + path);
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fclose(file);
+    }
+
+    // ---- write the report at process exit (as WriteInstrumentationReport); the environment variable
+    // METHODVERSE_PARAMETER_INSTRUMENTATION_REPORT sets the same path without code changes
+    inline void ReportInstrumentationAtExit(std::string path) {
+        if constexpr (instrumentation_enabled) detail::instrument_registry::Instance().SetReportPath(std::move(path));
+    }
+
+namespace detail {
+
+    inline void write_instrumentation_at_exit() {
+        try {
+            WriteInstrumentationReport(instrument_registry::Instance().ReportPath());
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "%s\n", e.what());
+        }
+    }
+
+} // namespace detail
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,136 @@
+// inverse_cache.h
+// This file defines batched inversion of 3x3 matrices and the inverse cache of ParameterBase<Eigen::Matrix3d>.
+// Slice orientation code inverts and divides by the same rotation matrices many times per prepare, and the
+// matrix policies of inverse_op and div_op invert their operand on every call. A Matrix3d parameter can keep
+// the inverses of its values instead:
+//     orientation.DeclareOrthonormal();            // rotations: the inverse is the transpose
+//     const auto& inverse = orientation.Inverse(); // computed once, until the next Set() or assignment
+//     auto local = EagerApply<div_op>(positions, orientation); // uses the cached inverses
+// For a 3x3 matrix the closed-form (cofactor) inverse is cheaper than an LU factorization followed by solves,
+// so the cache stores the inverses themselves. Orthonormal matrices (M^T M = I) are inverted by a transpose;
+// they are either declared with DeclareOrthonormal() or detected per matrix when the cache is filled.
+// The cache is allocated on first use only, so Matrix3d parameters that are never inverted grow by a pointer and
+// two flags. It is filled by the non-const Inverse(), so const (possibly shared) parameters are never written
+// behind the caller's back; const code reads it through CachedInverse(). The cache keeps a copy of the values it
+// was computed from and is only used while they are unchanged, so writes through references (operator[],
+// Unchecked(), Get()) made at any time never leave a stale inverse.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <Eigen/Core>
+#include <Eigen/LU>
+#include "small_vector.h"
+
+namespace methodverse::parameter {
+
+    // ---- how InvertMatrices inverts each matrix
+    enum class MatrixStructure {
+        general,     // closed-form inverse
+        orthonormal, // transpose, the caller guarantees M^T M = I
+        detect       // transpose for the matrices that are orthonormal within 1e-12, closed-form inverse otherwise
+    };
+
+    // M^T M = I within tolerance (max. absolute deviation per coefficient)
+    [[nodiscard]] inline bool IsOrthonormal(const Eigen::Matrix3d& m, double tolerance = 1e-12) noexcept {
+        return ((m.transpose() * m - Eigen::Matrix3d::Identity()).cwiseAbs().maxCoeff()) <= tolerance;
+    }
+
+    // ---- batched inversion: out[i] = in[i]^-1; throws std::invalid_argument if the sizes differ.
+    // Singular matrices give non-finite inverses, like Eigen's inverse().
+    inline void InvertMatrices(std::span<const Eigen::Matrix3d> in, std::span<Eigen::Matrix3d> out,
+                               MatrixStructure structure = MatrixStructure::general) {
+        if (in.size() != out.size()) {
+            throw std::invalid_argument("InvertMatrices: " + std::to_string(in.size()) + " matrices into " +
+                                        std::to_string(out.size()));
+        }
+        switch (structure) {
+            case MatrixStructure::orthonormal:
+                for (std::size_t i = 0; i < in.size(); ++i) out[i] = in[i].transpose();
+                break;
+            case MatrixStructure::detect:
+                for (std::size_t i = 0; i < in.size(); ++i) {
+                    out[i] = IsOrthonormal(in[i]) ? Eigen::Matrix3d(in[i].transpose()) : Eigen::Matrix3d(in[i].inverse());
+                }
+                break;
+            case MatrixStructure::general:
+                for (std::size_t i = 0; i < in.size(); ++i) out[i] = in[i].inverse();
+                break;
+        }
+    }
+
+namespace detail {
+
+    // ---- inverse cache of the values of a ParameterBase, empty for every value type but Matrix3d
+    template<class T>
+    struct inverse_cache {
+        void Invalidate() noexcept {}
+        [[nodiscard]] bool IsEmpty() const noexcept { return true; }
+    };
+
+    template<>
+    struct inverse_cache<Eigen::Matrix3d> {
+        using storage_type = small_vector<Eigen::Matrix3d, inline_capacity_v<Eigen::Matrix3d>>;
+
+        inverse_cache() = default;
+        // a copy keeps the declaration but not the inverses, which are recomputed on demand
+        inverse_cache(const inverse_cache& other) : orthonormal(other.orthonormal) {}
+        inverse_cache(inverse_cache&&) noexcept = default;
+        // assignments replace the values, the declaration belongs to the assigned-to parameter
+        inverse_cache& operator=(const inverse_cache&) noexcept {
+            Invalidate();
+            return *this;
+        }
+        inverse_cache& operator=(inverse_cache&&) noexcept {
+            Invalidate();
+            return *this;
+        }
+
+        void Invalidate() noexcept { valid = false; }
+        [[nodiscard]] bool IsEmpty() const noexcept { return entry == nullptr; }
+
+        // the inverses if they were computed from exactly these values, nullptr otherwise
+        [[nodiscard]] const storage_type* Get(std::span<const Eigen::Matrix3d> values) const noexcept {
+            return valid && entry->computed_from(values) ? &entry->inverses : nullptr;
+        }
+
+        const storage_type& Refresh(std::span<const Eigen::Matrix3d> values) {
+            if (const storage_type* current = Get(values)) return *current;
+            if (!entry) entry = std::make_unique<cache_entry>();
+            valid = false; // stays stale if InvertMatrices throws
+            entry->sources.assign(values.begin(), values.end());
+            entry->inverses.resize_for_overwrite(values.size());
+            InvertMatrices(values, {entry->inverses.data(), entry->inverses.size()},
+                           orthonormal ? MatrixStructure::orthonormal : MatrixStructure::detect);
+            valid = true;
+            return entry->inverses;
+        }
+
+        // The inverses together with the values they were computed from. Writes through a reference from
+        // operator[], Unchecked() or Get() bypass Invalidate(), so a hit also compares the values bitwise; for
+        // 3x3 matrices that is a fraction of the cost of inverting them.
+        struct cache_entry {
+            storage_type sources;
+            storage_type inverses;
+
+            [[nodiscard]] bool computed_from(std::span<const Eigen::Matrix3d> values) const noexcept {
+                return values.size() == sources.size() &&
+                       (values.empty() || std::memcmp(values.data(), sources.data(), values.size_bytes()) == 0);
+            }
+        };
+
+        std::unique_ptr<cache_entry> entry; // allocated on first Refresh()
+        bool valid = false;                 // false after Invalidate(), skips the comparison
+        bool orthonormal = false;           // declared by DeclareOrthonormal()
+    };
+
+} // namespace detail
+
+}; // namespace methodverse::parameter
@@ -8,7 +8,8 @@
 // dot product (.): eigen . eigen (only for eigen_colvec_tag, eigen_rowvec_tag)
 // transpose (.T): eigen only
 // inverse (.inv()): eigen_mat_tag only
-// boolean ops (&&, ||, !, xor, xnor): bool only
+// boolean ops (&&, ||, !, xor, xnor): bool, and BitMask word by word (bit_mask.h)
+// waveforms (+, -, *, /, .*, ./): sample by sample on VectorXd/ArrayXd/VectorXf/ArrayXf and scalars (waveform.h)
 // Author: Chenguang Zhao
 // Date: 2025-08-29
 
@@ -19,7 +20,10 @@
 #include <cmath>
 #include <type_traits>
 #include <concepts> 
+#include <mp-units/core.h>
+#include "bit_mask.h"
 #include "tags.h"
+#include "waveform.h"
 
 namespace methodverse::parameter {
 
@@ -32,7 +36,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions        
         template <class U1, class U2>
         requires (is_category_of<U1, scalar_tag> && is_category_of<U2, scalar_tag>)
-        static std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { 
+        static constexpr std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { 
             using C = std::common_type_t<U1,U2>;
             return static_cast<C>(s1) + static_cast<C>(s2); 
         }
@@ -88,7 +92,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_base_of_v<eigen_vecmat_tag, category_t<U1>> && std::is_base_of_v<eigen_vecmat_tag, category_t<U2>> && std::is_same_v<U1, U2>)
-        static auto impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() + vm2.array()).eval(); }
+        static U1 impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() + vm2.array()).matrix(); }
         // Units of two parameters must be the same for addition operation
         template <auto Ux, auto Uy>
         requires ( Ux == Uy ) // units must be the same
@@ -131,7 +135,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (is_category_of<U1, scalar_tag> && is_category_of<U2, scalar_tag>)
-        static std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) - static_cast<double>(s2); }
+        static constexpr std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) - static_cast<double>(s2); }
 
         // Units of two parameters must be the same for addition operation
         template <auto Ux, auto Uy>
@@ -182,7 +186,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_base_of_v<eigen_vecmat_tag, category_t<U1>> && std::is_base_of_v<eigen_vecmat_tag, category_t<U2>> && std::is_same_v<U1, U2>)
-        static auto impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() - vm2.array()).eval(); }
+        static U1 impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() - vm2.array()).matrix(); }
         // Units of two parameters must be the same for addition operation
         template <auto Ux, auto Uy>
         requires ( Ux == Uy ) // units must be the same
@@ -216,7 +220,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (is_category_of<U1, scalar_tag> && is_category_of<U2, scalar_tag>)
-        static std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) * static_cast<double>(s2); }
+        static constexpr std::common_type_t<U1,U2> impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) * static_cast<double>(s2); }
 
         template <auto Ux, auto Uy>
         static consteval auto unit_of() { return Ux * Uy; }
@@ -339,7 +343,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (is_category_of<U1, scalar_tag> && is_category_of<U2, scalar_tag>)
-        static double impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) / static_cast<double>(s2); }
+        static constexpr double impl(U1 const &s1, U2 const &s2) { return static_cast<double>(s1) / static_cast<double>(s2); }
 
         template <auto Ux, auto Uy>
         static consteval auto unit_of() { return Ux / Uy; }
@@ -427,7 +431,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_base_of_v<eigen_vecmat_tag, category_t<U1>> && std::is_base_of_v<eigen_vecmat_tag, category_t<U2>> && std::is_same_v<U1, U2>)
-        static auto impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() * vm2.array()).eval(); }
+        static U1 impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() * vm2.array()).matrix(); }
         // Units of two parameters must be the same for addition operation
         template <auto Ux, auto Uy>
         static consteval auto unit_of() { return Ux * Uy; } // multiplication of units
@@ -445,7 +449,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_base_of_v<eigen_vecmat_tag, category_t<U1>> && std::is_base_of_v<eigen_vecmat_tag, category_t<U2>> && std::is_same_v<U1, U2>)
-        static auto impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() / vm2.array()).eval(); }
+        static U1 impl(U1 const &vm1, U2 const &vm2) { return (vm1.array() / vm2.array()).matrix(); }
         // Units of two parameters must be the same for addition operation
         template <auto Ux, auto Uy>
         static consteval auto unit_of() { return Ux / Uy; } // multiplication of units
@@ -491,7 +495,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_same_v<U1, bool> && std::is_same_v<U2, bool>)
-        static bool impl(U1 const &b1, U2 const &b2) { return b1 && b2; }
+        static constexpr bool impl(U1 const &b1, U2 const &b2) { return b1 && b2; }
     };
 
     // ---- bool || bool -> bool
@@ -501,7 +505,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_same_v<U1, bool> && std::is_same_v<U2, bool>)
-        static bool impl(U1 const &b1, U2 const &b2) { return b1 || b2; }
+        static constexpr bool impl(U1 const &b1, U2 const &b2) { return b1 || b2; }
     };
 
     // ---- bool xor bool -> bool
@@ -511,7 +515,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_same_v<U1, bool> && std::is_same_v<U2, bool>)
-        static bool impl(U1 const &b1, U2 const &b2) { return b1 != b2; }
+        static constexpr bool impl(U1 const &b1, U2 const &b2) { return b1 != b2; }
     };
 
     // ---- bool xnor bool -> bool
@@ -521,7 +525,7 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1, class U2>
         requires (std::is_same_v<U1, bool> && std::is_same_v<U2, bool>)
-        static bool impl(U1 const &b1, U2 const &b2) { return b1 == b2; }
+        static constexpr bool impl(U1 const &b1, U2 const &b2) { return b1 == b2; }
     };
 
     // ---- not bool -> bool
@@ -531,9 +535,127 @@ namespace methodverse::parameter {
         // Implementation body as templated free/static functions
         template <class U1>
         requires (std::is_same_v<U1, bool>)
-        static bool impl(U1 const &b) { return !b; }
+        static constexpr bool impl(U1 const &b) { return !b; }
     };
 
+    ///////////////////////////// policies for bit masks only //////////////////////////
+    // One BitMask value holds a whole mask, so these run a word (64 bits) per step instead of a bool per step.
+    // The masks of the two operands must have the same size. Like bool, masks are unitless.
+    // ---- mask && mask -> mask
+    template<>
+    struct op_policy<bitmask_tag, bitmask_tag, and_op> {
+        static constexpr bool enabled = true;
+        template <class U1, class U2>
+        requires (std::is_same_v<U1, BitMask> && std::is_same_v<U2, BitMask>)
+        static BitMask impl(U1 const &m1, U2 const &m2) { return m1 & m2; }
+    };
+
+    // ---- mask || mask -> mask
+    template<>
+    struct op_policy<bitmask_tag, bitmask_tag, or_op> {
+        static constexpr bool enabled = true;
+        template <class U1, class U2>
+        requires (std::is_same_v<U1, BitMask> && std::is_same_v<U2, BitMask>)
+        static BitMask impl(U1 const &m1, U2 const &m2) { return m1 | m2; }
+    };
+
+    // ---- mask xor mask -> mask
+    template<>
+    struct op_policy<bitmask_tag, bitmask_tag, xor_op> {
+        static constexpr bool enabled = true;
+        template <class U1, class U2>
+        requires (std::is_same_v<U1, BitMask> && std::is_same_v<U2, BitMask>)
+        static BitMask impl(U1 const &m1, U2 const &m2) { return m1 ^ m2; }
+    };
+
+    // ---- mask xnor mask -> mask
+    template<>
+    struct op_policy<bitmask_tag, bitmask_tag, xnor_op> {
+        static constexpr bool enabled = true;
+        template <class U1, class U2>
+        requires (std::is_same_v<U1, BitMask> && std::is_same_v<U2, BitMask>)
+        static BitMask impl(U1 const &m1, U2 const &m2) { return Xnor(m1, m2); }
+    };
+
+    // ---- not mask -> mask
+    template<>
+    struct op_policy<bitmask_tag, void, not_op> {
+        static constexpr bool enabled = true;
+        template <class U1>
+        requires (std::is_same_v<U1, BitMask>)
+        static BitMask impl(U1 const &m) { return ~m; }
+    };
+
+    ///////////////////////////// policies for waveforms //////////////////////////
+    // Sample by sample on two waveforms of the same type and length, or on a waveform and a scalar broadcast over
+    // the samples (waveform.h); * and / are coefficient-wise. lazy() returns the Eigen expression, which the fused
+    // evaluator of ParameterExpr nests into the enclosing step; impl() evaluates it into a waveform.
+namespace detail {
+
+    template<class Op>
+    struct waveform_policy {
+        static constexpr bool enabled = true;
+        static constexpr bool additive = std::is_same_v<Op, add_op> || std::is_same_v<Op, sub_op>;
+        static constexpr bool quotient = std::is_same_v<Op, div_op> || std::is_same_v<Op, coefw_div_op>;
+
+        // A and B are U1 and U2, or Eigen expressions of them returned by a nested lazy()
+        template <class U1, class U2, class A, class B>
+        requires waveform_operands<U1, U2>
+        static auto lazy(A const &a, B const &b) {
+            using W = waveform_result_t<U1, U2>;
+            const auto& x = waveform_array<W>(a);
+            const auto& y = waveform_array<W>(b);
+            if constexpr (std::is_same_v<Op, add_op>) {
+                check_waveform_sizes(a, b, "+");
+                return as_waveform<W>(x + y);
+            } else if constexpr (std::is_same_v<Op, sub_op>) {
+                check_waveform_sizes(a, b, "-");
+                return as_waveform<W>(x - y);
+            } else if constexpr (quotient) {
+                check_waveform_sizes(a, b, "/");
+                return as_waveform<W>(x / y);
+            } else {
+                check_waveform_sizes(a, b, "*");
+                return as_waveform<W>(x * y);
+            }
+        }
+
+        template <class U1, class U2>
+        requires waveform_operands<U1, U2>
+        static waveform_result_t<U1, U2> impl(U1 const &a, U2 const &b) { return lazy<U1, U2>(a, b); }
+
+        // + and - require equal units, * and / multiply and divide them
+        template <auto Ux, auto Uy>
+        requires (!additive || Ux == Uy)
+        static consteval auto unit_of() {
+            if constexpr (additive) return Ux;
+            else if constexpr (quotient) return Ux / Uy;
+            else return Ux * Uy;
+        }
+    };
+
+} // namespace detail
+
+    // ---- waveform +-*/ waveform -> waveform
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, add_op> : public detail::waveform_policy<add_op> {};
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, sub_op> : public detail::waveform_policy<sub_op> {};
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, mul_op> : public detail::waveform_policy<mul_op> {};
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, div_op> : public detail::waveform_policy<div_op> {};
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, coefw_mul_op> : public detail::waveform_policy<coefw_mul_op> {};
+    template<> struct op_policy<eigen_waveform_tag, eigen_waveform_tag, coefw_div_op> : public detail::waveform_policy<coefw_div_op> {};
+
+    // ---- waveform +-*/ scalar -> waveform
+    template<> struct op_policy<eigen_waveform_tag, scalar_tag, add_op> : public detail::waveform_policy<add_op> {};
+    template<> struct op_policy<eigen_waveform_tag, scalar_tag, sub_op> : public detail::waveform_policy<sub_op> {};
+    template<> struct op_policy<eigen_waveform_tag, scalar_tag, mul_op> : public detail::waveform_policy<mul_op> {};
+    template<> struct op_policy<eigen_waveform_tag, scalar_tag, div_op> : public detail::waveform_policy<div_op> {};
+
+    // ---- scalar +-*/ waveform -> waveform
+    template<> struct op_policy<scalar_tag, eigen_waveform_tag, add_op> : public detail::waveform_policy<add_op> {};
+    template<> struct op_policy<scalar_tag, eigen_waveform_tag, sub_op> : public detail::waveform_policy<sub_op> {};
+    template<> struct op_policy<scalar_tag, eigen_waveform_tag, mul_op> : public detail::waveform_policy<mul_op> {};
+    template<> struct op_policy<scalar_tag, eigen_waveform_tag, div_op> : public detail::waveform_policy<div_op> {};
+
     ///////////////////////////// dot operation //////////////////////////
     // ---- dot of two vectors -> scalar
     template<>
@@ -576,7 +698,7 @@ namespace methodverse::parameter {
         requires (is_category_of<U1, eigen_mat_tag>)
         static auto impl(U1 const &m) { return m.inverse().eval(); }
         template <auto Ux>
-        static consteval auto unit_of() { return 1 / Ux; } // inverse of unit
+        static consteval auto unit_of() { return mp_units::one / Ux; } // inverse of unit
     };
 
     // ---- return type deduction helper
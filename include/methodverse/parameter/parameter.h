@@ -1,29 +1,38 @@
 // parameter.h
 // This file defines ParameterBase and Parameter classes.
+// To keep the cost of including it low, only the SI units and prefixes of mp-units are included; include
+// <mp-units/systems/si.h> for unit symbols, constants and std::chrono support. Linking methodverse-parameter-impl
+// instead of methodverse-parameter compiles the common ParameterBase specializations once (instantiations.h).
 // Author: Chenguang Zhao
 // Date: 2025-08-29
 
 #pragma once
 
-#include <iostream>
-#include <functional>
-#include <memory>
-#include <sstream>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
-#include <cassert>
+#include <span>
 #include <typeinfo>
-#include <iomanip>
-#include <typeindex>
 #include <initializer_list>
 #include <type_traits>
 #include <concepts>
-#include <Eigen/Dense>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <limits>
+#include <stdexcept>
 #include <mp-units/core.h>
-#include <mp-units/systems/si.h>
+#include <mp-units/systems/si/units.h>
+#include <mp-units/systems/si/prefixes.h>
+#include "change_log.h"
+#include "instrumentation.h"
+#include "inverse_cache.h"
 #include "operation_policy.h"
+#include "parameter_id.h"
+#include "runtime_unit.h"
+#include "small_vector.h"
+#include "expression.h"
+#include "formatters.h"
+#include "instantiations.h"
 
 using namespace mp_units;
 inline constexpr double eps = std::numeric_limits<double>::epsilon();
@@ -37,38 +46,183 @@ class IParameter {
 public:
     virtual ~IParameter() = default;
 
-    // Return the parameter name, e.g., "TE" or "TR".
-    virtual std::string Name() const = 0;
+    // Return the parameter name, e.g., "TE" or "TR", without allocating. The view stays valid as long as
+    // the parameter (names of Parameter<T, Derived, Unit> are string literals).
+    virtual std::string_view NameView() const noexcept = 0;
+
+    // Return the parameter name as a std::string; prefer NameView() on hot paths. Not virtual: subclasses
+    // rename a parameter by overriding NameView(), so Name(), Id() and the registry always agree.
+    std::string Name() const { return std::string(NameView()); }
+
+    // Return the id of the name, see parameter_id.h. Parameter<T, Derived, Unit> returns a compile-time constant.
+    virtual ParameterId Id() const noexcept { return ParameterId(NameView()); }
 
     // Return the value as a string for UI, logging, or serialization.
     virtual std::string ValueAsString() const = 0;
+
+    // Append the value to a caller-owned buffer, the same text as ValueAsString(). Reusing one buffer for many
+    // parameters avoids a string allocation per parameter.
+    virtual void FormatValueTo(fmt::memory_buffer& out) const {
+        const std::string s = ValueAsString();
+        out.append(s.data(), s.data() + s.size());
+    }
+
+    // Index of the value type in primitive_types, or no_type_id if the values are not stored as a
+    // contiguous array of a primitive type. Used with ViewAs<T>() by type-erased code.
+    virtual std::size_t TypeId() const noexcept { return no_type_id; }
+
+    // The unit, decoded for run-time use (see runtime_unit.h)
+    virtual RuntimeUnit GetRuntimeUnit() const noexcept { return {}; }
+
+    // Zero-copy view of the values as T; throws std::bad_cast if T is not the value type.
+    template<class T>
+    [[nodiscard]] std::span<const T> ViewAs() const {
+        if (TypeId() == no_type_id || TypeId() != primitive_type_id_v<T>) throw std::bad_cast();
+        return UncheckedViewAs<T>();
+    }
+
+    // Same as ViewAs<T>() without the type check, for callers that already dispatched on TypeId()
+    template<class T>
+    [[nodiscard]] std::span<const T> UncheckedViewAs() const noexcept {
+        const auto bytes = ValueBytes();
+        return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+    }
+
+protected:
+    // Raw memory of the values, only meaningful when TypeId() != no_type_id
+    virtual std::span<const std::byte> ValueBytes() const noexcept { return {}; }
 };
 
+namespace detail {
+
+    // ---- string form of a list of values: "v" for one value, "[v1, v2, ...]" otherwise (see formatters.h)
+    template<class T, class Out, class F>
+    Out format_values(Out out, std::size_t n, F&& format_one) {
+        if (n == 1) return format_one(out, 0);
+        *out++ = '[';
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i > 0) {
+                *out++ = ',';
+                *out++ = ' ';
+            }
+            out = format_one(out, i);
+        }
+        *out++ = ']';
+        return out;
+    }
+
+    // true if a string value written as it is would not parse back as itself (see parse.h): a single value is
+    // read to the end of the text, a value in a list up to the next ',' or ']' with the spaces around it dropped
+    inline bool string_needs_quotes(std::string_view s, bool in_list) noexcept {
+        constexpr std::string_view space = " \t\n\r";
+        if (s.empty()) return false;
+        if (s.front() == '"' || space.contains(s.front())) return true;
+        if (!in_list) return s.front() == '[';
+        return space.contains(s.back()) || s.find_first_of(",]") != std::string_view::npos;
+    }
+
+    inline fmt::appender format_quoted(fmt::appender out, std::string_view s) {
+        *out++ = '"';
+        for (const char c : s) {
+            if (c == '"' || c == '\\') *out++ = '\\';
+            *out++ = c;
+        }
+        *out++ = '"';
+        return out;
+    }
+
+    template<class T>
+    void format_values_to(fmt::memory_buffer& buffer, std::span<const T> values) {
+        format_values<T>(fmt::appender(buffer), values.size(), [&](fmt::appender out, std::size_t i) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                if (string_needs_quotes(values[i], values.size() != 1)) return format_quoted(out, values[i]);
+            }
+            return fmt::format_to(out, "{}", values[i]);
+        });
+    }
+
+    template<class T>
+    std::string values_to_string(std::span<const T> values) {
+        fmt::memory_buffer buffer;
+        format_values_to(buffer, values);
+        return fmt::to_string(buffer);
+    }
+
+} // namespace detail
+
 template<typename T, mp_units::Reference auto Unit = mp_units::one>
 class ParameterBase : public IParameter {
+public:
+    using value_type = T;
+    // values are kept inline up to inline_capacity_v<T> (1 by default), so scalar parameters never allocate
+    using storage_type = small_vector<T, inline_capacity_v<T>>;
+
 protected:
-    std::vector<T> value_;
+    storage_type value_;
+    // inverses of Matrix3d values (see inverse_cache.h), an empty member for the other value types
+    [[no_unique_address]] detail::inverse_cache<T> inverse_cache_;
     static constexpr auto unit_ = Unit;
 
 public:
-    using value_type = T;
 
     // Constructors
-    ParameterBase() = default;
+    // The Instrument*() calls count constructions, copies and allocations when METHODVERSE_PARAMETER_INSTRUMENTATION
+    // is defined and compile to nothing otherwise, see instrumentation.h.
+    ParameterBase() noexcept { InstrumentConstruction(detail::instrument_event::construction); }
 
-    ParameterBase(const ParameterBase &) = default;
+    ParameterBase(const ParameterBase &other) : value_(other.value_), inverse_cache_(other.inverse_cache_) {
+        InstrumentConstruction(detail::instrument_event::copy);
+    }
 
-    ParameterBase(ParameterBase &&) noexcept = default;
+    ParameterBase(ParameterBase &&other) noexcept
+        : value_(std::move(other.value_)), inverse_cache_(std::move(other.inverse_cache_)) {
+        InstrumentConstruction(detail::instrument_event::move);
+    }
 
-    ParameterBase &operator=(const ParameterBase &) = default;
+    // Assignments report the change (see change_log.h); the derived classes' implicit assignments, used by
+    // te = 0.01 through the converting constructor, go through these.
+    ParameterBase &operator=(const ParameterBase &other) {
+        const T* before = value_.data();
+        value_ = other.value_;
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::copy, before);
+        NotifyChanged();
+        return *this;
+    }
+
+    // noexcept like the other moves: the notification only throws if a subscriber does, which change_log.h forbids
+    ParameterBase &operator=(ParameterBase &&other) noexcept {
+        value_ = std::move(other.value_);
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::move, value_.data()); // takes over the buffer, no allocation
+        NotifyChanged();
+        return *this;
+    }
 
-    ParameterBase &operator=(ParameterBase &&) noexcept = default;
+    ParameterBase(const T& value) : value_{value} { InstrumentConstruction(detail::instrument_event::construction); }
 
-    ParameterBase(const T& value) : value_{value} {}
+    ParameterBase(const std::vector<T>& values) : value_(values) {
+        InstrumentConstruction(detail::instrument_event::construction);
+    }
 
-    ParameterBase(const std::vector<T>& values) : value_(values) {}
+    ParameterBase(std::initializer_list<T> values) : value_(values) {
+        InstrumentConstruction(detail::instrument_event::construction);
+    }
 
-    ParameterBase(std::initializer_list<T> values) : value_(values) {}
+    // Construct from a lazy expression of the same value type and unit, evaluated in a single pass
+    template<parameter_expression E>
+    requires (std::is_same_v<typename E::value_type, T> && (E::GetUnit() == Unit))
+    ParameterBase(const E& expr) : ParameterBase(expr.Eval()) {}
+
+    template<parameter_expression E>
+    requires (std::is_same_v<typename E::value_type, T> && (E::GetUnit() == Unit))
+    ParameterBase& operator=(const E& expr) {
+        expr.EvalInto(value_);
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::assignment, value_.data());
+        NotifyChanged();
+        return *this;
+    }
 
     // Conversion to T
     [[nodiscard]] T Val() const noexcept {
@@ -76,15 +230,29 @@ public:
     }
 
     // Conversion to vector
-    [[nodiscard]] std::vector<T> Vals() const noexcept {
-        return value_;
+    [[nodiscard]] std::vector<T> Vals() const {
+        if constexpr (instrumentation_enabled) {
+            detail::instrument_update<T, Unit>(detail::instrument_event::vals, NameView(), value_.size() * sizeof(T));
+        }
+        return value_.to_vector();
+    }
+
+    // Zero-copy read access: first value by reference (a value-initialized T when empty), and a view of all values.
+    // The references stay valid until the parameter is modified.
+    [[nodiscard]] const T& ValRef() const noexcept {
+        static const T empty_value{};
+        return value_.empty() ? empty_value : value_[0];
+    }
+
+    [[nodiscard]] std::span<const T> View() const noexcept {
+        return {value_.data(), value_.size()};
     }
 
     // Operator ==
     template <class T2, auto Unit2>
     bool operator==(const ParameterBase<T2, Unit2> &other) const {
         if constexpr (Unit == Unit2) {
-            return value_ == other.Get();
+            return detail::values_equal(value_, other.Get());
         }
         else {
             return false;
@@ -95,89 +263,101 @@ public:
     decltype(auto) operator[](size_t i) { return value_.at(i); }
     decltype(auto) operator[](size_t i) const { return value_.at(i); }
 
-    std::string Name() const override { return "ParameterBase"; }
+    // Access without bounds check, for hot loops that already know i < Size()
+    decltype(auto) Unchecked(size_t i) noexcept { return value_[i]; }
+    decltype(auto) Unchecked(size_t i) const noexcept { return value_[i]; }
+
+    std::string_view NameView() const noexcept override { return "ParameterBase"; }
 
     // serialization to string
-    [[nodiscard]] std::string ValueAsString() const override {
-        std::ostringstream oss;
-        oss << std::boolalpha;
-        if (value_.size() == 1) {
-            oss << value_[0];
-        } else {
-            oss << "[";
-            for (size_t i = 0; i < value_.size(); ++i) {
-                if (i > 0) oss << ", ";
-                oss << value_[i];
-            }
-            oss << "]";
-        }
-        return oss.str();
-    }
+    [[nodiscard]] std::string ValueAsString() const override { return detail::values_to_string(View()); }
+    void FormatValueTo(fmt::memory_buffer& out) const override { detail::format_values_to(out, View()); }
+
+    // type-erased access, see IParameter
+    std::size_t TypeId() const noexcept override { return primitive_type_id_v<T>; }
+    RuntimeUnit GetRuntimeUnit() const noexcept override { return runtime_unit_of<Unit>; }
 
     // Getter/setter
-    [[nodiscard]] std::vector<T>& Get() noexcept { return value_; }
-    [[nodiscard]] const std::vector<T>& Get() const noexcept { return value_; }
+    [[nodiscard]] storage_type& Get() noexcept { return value_; }
+    [[nodiscard]] const storage_type& Get() const noexcept { return value_; }
     void Set(const T& v) {
+        const T* before = value_.data();
         if (value_.empty()) value_.resize(1);
         value_[0] = v;
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::assignment, before);
+        NotifyChanged();
+    }
+    void Set(const std::vector<T>& values) {
+        const T* before = value_.data();
+        value_ = values;
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::assignment, before);
+        NotifyChanged();
+    }
+    void Set(const storage_type& values) {
+        const T* before = value_.data();
+        value_ = values;
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::assignment, before);
+        NotifyChanged();
+    }
+    void Set(std::initializer_list<T> values) {
+        const T* before = value_.data();
+        value_ = values;
+        inverse_cache_.Invalidate();
+        InstrumentUpdate(detail::instrument_event::assignment, before);
+        NotifyChanged();
+    }
+    // Report a change made through Get() or Unchecked() to the change subscribers (see change_log.h).
+    // Set() and the value assignments do it themselves; without subscribers this is a single branch.
+    void NotifyChanged() const {
+        if (detail::change_notifications_active()) [[unlikely]] detail::record_change(Id(), this);
     }
-    void Set(const std::vector<T>& values) { value_ = values; }
-    void Set(std::initializer_list<T> values) { value_ = values;}
     static constexpr auto  GetUnit() noexcept { return unit_;}
     std::size_t Size() const noexcept { return value_.size();}
 
-    // ----------------
-    // Binary operators, we can probably use MACRO to reduce duplication of code
-    // ----------------
-    // ---- Operator +
-    template<class T2, mp_units::Reference auto Unit2>
-    requires (op_allowed<op_policy<category_t<T>, category_t<T2>, add_op>, T, T2>)
-    auto operator+(const ParameterBase<T2, Unit2>& rhs) const {
-        using policy = op_policy<category_t<T>, category_t<T2>, add_op>;
-        using T3 = op_return_t<policy, T, T2>;
-        constexpr auto Unit3 = policy::template unit_of<Unit, Unit2>();
-
-        auto r = policy::template impl<T, T2>(Val(), rhs.Val());
-        return ParameterBase<T3, Unit3>(r);
-    }
-
-    // ---- Operator -
-    template<class T2, mp_units::Reference auto Unit2>
-    requires (op_allowed<op_policy<category_t<T>, category_t<T2>, sub_op>, T, T2>)
-    auto operator-(const ParameterBase<T2, Unit2>& rhs) const {
-        using policy = op_policy<category_t<T>, category_t<T2>, sub_op>;
-        using T3 = op_return_t<policy, T, T2>;
-        constexpr auto Unit3 = policy::template unit_of<Unit, Unit2>();
-
-        auto r = policy::template impl<T, T2>(Val(), rhs.Val());
-        return ParameterBase<T3, Unit3>(r);
-    }    
-
-    // ---- Operator *
-    template<class T2, mp_units::Reference auto Unit2>
-    requires (op_allowed<op_policy<category_t<T>, category_t<T2>, mul_op>, T, T2>)
-    auto operator*(const ParameterBase<T2, Unit2>& rhs) const {
-        using policy = op_policy<category_t<T>, category_t<T2>, mul_op>;
-        using T3 = op_return_t<policy, T, T2>;
-        constexpr auto Unit3 = policy::template unit_of<Unit, Unit2>();
-
-        auto r = policy::template impl<T, T2>(Val(), rhs.Val());
-        return ParameterBase<T3, Unit3>(r);
-    }
-
-    // ---- Operator /
-    template<class T2, mp_units::Reference auto Unit2>
-    requires (op_allowed<op_policy<category_t<T>, category_t<T2>, div_op>, T, T2>)
-    auto operator/(const ParameterBase<T2, Unit2>& rhs) const {
-        using policy = op_policy<category_t<T>, category_t<T2>, div_op>;
-        using T3 = op_return_t<policy, T, T2>;
-        constexpr auto Unit3 = policy::template unit_of<Unit, Unit2>();
-
-        auto r = policy::template impl<T, T2>(Val(), rhs.Val());
-        return ParameterBase<T3, Unit3>(r);
-    }
-
-    // Similarly implement -, *, / with the right op tags
+    // true while the values (and the inverse cache) are stored inside the object, i.e. a copy does not allocate
+    bool IsInline() const noexcept { return value_.is_inline() && inverse_cache_.IsEmpty(); }
+
+    // ---- inverse cache of Matrix3d values, see inverse_cache.h
+    // Declare the values to be rotations (orthonormal), inverted by a transpose without a check
+    void DeclareOrthonormal(bool orthonormal = true) noexcept requires std::is_same_v<T, Eigen::Matrix3d> {
+        inverse_cache_.orthonormal = orthonormal;
+        inverse_cache_.Invalidate();
+    }
+
+    // Inverses of the values, computed on the first call after a change of the values
+    const storage_type& Inverse() requires std::is_same_v<T, Eigen::Matrix3d> { return inverse_cache_.Refresh(View()); }
+
+    // The inverses if they were computed from the current values, nullptr otherwise; used by
+    // EagerApply<inverse_op/div_op>
+    const storage_type* CachedInverse() const noexcept requires std::is_same_v<T, Eigen::Matrix3d> {
+        return inverse_cache_.Get(View());
+    }
+
+    // Binary operators (+, -, *, /) are free functions returning lazy ParameterExpr nodes, see expression.h
+
+protected:
+    std::span<const std::byte> ValueBytes() const noexcept override { return std::as_bytes(View()); }
+
+    // ---- instrumentation hooks, empty unless METHODVERSE_PARAMETER_INSTRUMENTATION is defined
+    // A heap buffer counts as an allocation when it is new: after a constructor, or when the data pointer
+    // changed during an update.
+    std::uint64_t HeapBytes() const noexcept { return value_.is_inline() ? 0 : value_.capacity() * sizeof(T); }
+
+    void InstrumentConstruction(detail::instrument_event event) const noexcept {
+        if constexpr (instrumentation_enabled) {
+            // a moved-to object owns the buffer of the source, nothing was allocated
+            detail::instrument_construction<T, Unit>(event, event == detail::instrument_event::move ? 0 : HeapBytes());
+        }
+    }
+
+    void InstrumentUpdate(detail::instrument_event event, const T* data_before) const noexcept {
+        if constexpr (instrumentation_enabled) {
+            detail::instrument_update<T, Unit>(event, NameView(), value_.data() != data_before ? HeapBytes() : 0);
+        }
+    }
 };
 
 
@@ -188,36 +368,107 @@ public:
     using Base::Base;
 
     static constexpr const char* name = Derived::name;
+    static constexpr ParameterId id{std::string_view(Derived::name)};
 
     // CRTP assignment operators
     Derived& operator=(const T& rhs) {
+        const T* before = this->value_.data();
         if (this->value_.empty()) this->value_.resize(1);
         this->value_[0] = rhs;
+        this->inverse_cache_.Invalidate();
+        this->InstrumentUpdate(detail::instrument_event::assignment, before);
+        this->NotifyChanged();
         return static_cast<Derived&>(*this);
     }
 
     Derived& operator=(const std::vector<T>& rhs) {
+        const T* before = this->value_.data();
         this->value_ = rhs;
+        this->inverse_cache_.Invalidate();
+        this->InstrumentUpdate(detail::instrument_event::assignment, before);
+        this->NotifyChanged();
         return static_cast<Derived&>(*this);
     }
 
     Derived& operator=(std::initializer_list<T> rhs) {
+        const T* before = this->value_.data();
         this->value_ = rhs;
+        this->inverse_cache_.Invalidate();
+        this->InstrumentUpdate(detail::instrument_event::assignment, before);
+        this->NotifyChanged();
         return static_cast<Derived&>(*this);
     }
 
-    // CRTP-specific functions
-    [[nodiscard]] std::string Name() const override {
-        return std::string(Derived::name);
+    template<parameter_expression E>
+    requires (std::is_same_v<typename E::value_type, T> && (E::GetUnit() == Unit))
+    Derived& operator=(const E& rhs) {
+        rhs.EvalInto(this->value_);
+        this->inverse_cache_.Invalidate();
+        this->InstrumentUpdate(detail::instrument_event::assignment, this->value_.data());
+        this->NotifyChanged();
+        return static_cast<Derived&>(*this);
     }
 
+    // CRTP-specific functions
+    [[nodiscard]] std::string_view NameView() const noexcept override { return Derived::name; }
+    [[nodiscard]] ParameterId Id() const noexcept override { return id; }
+
     // Rebind constructor: only works if type/unit match
     template<class T2, auto Unit2>
     Parameter(const ParameterBase<T2, Unit2>& other)
         requires (std::is_same_v<T2, T> && (Unit2 == Unit))
         : Base(other) {}
-};
 
+#if defined(METHODVERSE_PARAMETER_INSTRUMENTATION)
+private:
+    // attributes the constructions of the ParameterBase subobject to Derived::name, see instrumentation.h
+    [[no_unique_address]] detail::instrument_name_tag<Derived> instrument_name_tag_;
+#endif
+};
 
+#if defined(METHODVERSE_PARAMETER_EXTERN_TEMPLATES)
+// compiled in methodverse-parameter-impl, see instantiations.h
+METHODVERSE_PARAMETER_INSTANTIATIONS(METHODVERSE_PARAMETER_EXTERN_INSTANTIATION)
+#endif
 
 }
+
+// ---- fmt support for ParameterBase and the classes derived from it
+// "{}" writes the values like ValueAsString(), "{:u}" appends the unit symbol. The rest of the spec applies to
+// every value, e.g. "{:u.3f}".
+template<class P>
+    requires methodverse::parameter::parameter_like<P>
+struct fmt::formatter<P, char> {
+    using base_type = decltype(methodverse::parameter::detail::parameter_base_of(std::declval<const P*>()));
+    using value_type = typename base_type::value_type;
+
+    fmt::formatter<value_type> value_formatter;
+    bool with_unit = false;
+
+    constexpr auto parse(fmt::format_parse_context& ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it == 'u') {
+            with_unit = true;
+            ctx.advance_to(++it);
+        }
+        return value_formatter.parse(ctx);
+    }
+
+    template<class FormatContext>
+    auto format(const P& p, FormatContext& ctx) const {
+        const auto values = p.View();
+        auto out = methodverse::parameter::detail::format_values<value_type>(
+            ctx.out(), values.size(), [&](auto o, std::size_t i) {
+                ctx.advance_to(o);
+                return value_formatter.format(values[i], ctx);
+            });
+        if (with_unit) {
+            constexpr std::string_view symbol = mp_units::unit_symbol(mp_units::get_unit(base_type::GetUnit()));
+            if (!symbol.empty()) {
+                *out++ = ' ';
+                out = std::copy(symbol.begin(), symbol.end(), out);
+            }
+        }
+        return out;
+    }
+};
@@ -0,0 +1,51 @@
+// parameter_id.h
+// This file defines ParameterId, a 64-bit identifier computed from the parameter name with FNV-1a.
+// For Parameter<T, Derived, Unit> the id is computed at compile time from Derived::name, so protocol maps
+// can be keyed by an integer instead of allocating and hashing std::string names on every access.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace methodverse::parameter {
+
+    // ---- 64-bit FNV-1a hash
+    [[nodiscard]] constexpr std::uint64_t fnv1a_64(std::string_view s) noexcept {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : s) {
+            h ^= static_cast<std::uint8_t>(c);
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    // ---- ParameterId
+    struct ParameterId {
+        std::uint64_t value = 0;
+
+        constexpr ParameterId() noexcept = default;
+        constexpr explicit ParameterId(std::string_view name) noexcept : value(fnv1a_64(name)) {}
+
+        friend constexpr bool operator==(ParameterId, ParameterId) noexcept = default;
+        friend constexpr auto operator<=>(ParameterId, ParameterId) noexcept = default;
+    };
+
+    inline namespace literals {
+        // "TE"_pid
+        consteval ParameterId operator""_pid(const char* s, std::size_t n) { return ParameterId(std::string_view(s, n)); }
+    } // namespace literals
+
+}; // namespace methodverse::parameter
+
+template<>
+struct std::hash<methodverse::parameter::ParameterId> {
+    std::size_t operator()(methodverse::parameter::ParameterId id) const noexcept {
+        return static_cast<std::size_t>(id.value);
+    }
+};
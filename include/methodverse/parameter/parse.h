@@ -0,0 +1,296 @@
+// parse.h
+// This file defines the parser of parameter values from text, the inverse of ValueAsString() and of the fmt
+// formatters (formatters.h): "v" for one value or "[v1, v2, ...]", optionally followed by the unit symbol,
+// e.g. "[0.01, 0.02] s" or "(1, 0, 0) m". Numbers are read with std::from_chars, values are written directly
+// into the parameter storage, so parsing does not allocate per element.
+//     int, double    from_chars syntax (also inf and nan for double)
+//     bool           true | false | 1 | 0
+//     std::string    "quoted" (with \" and \\ escapes), or unquoted: the whole text for a single value, up to
+//                    the next ',' or ']' in a list. ValueAsString() quotes the strings that would not parse back
+//                    unquoted (see detail::string_needs_quotes), the fmt formatters write strings as they are.
+//     Vector3d, RowVector3d, Quaterniond (w, x, y, z), Matrix3d ((row 0), (row 1), (row 2))
+//     VectorXd, ArrayXd, VectorXf, ArrayXf (s0, s1, ...) with any number of samples, read into a buffer first
+// A unit suffix must be the mp-units symbol of the parameter unit, in UTF-8 or portable form (us, m/s^2).
+// Errors are reported with std::invalid_argument and the position in the text.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+namespace detail {
+
+    // ---- exact fast path for decimal doubles (Clinger): a mantissa of at most 2^53 and a power of ten of at
+    // most 10^22 are both exact, so one multiplication or division gives the correctly rounded result.
+    // Returns nullptr for everything else (long mantissas, large exponents, inf, nan), which goes to from_chars.
+    inline const char* parse_double_fast(const char* first, const char* last, double& out) noexcept {
+        static constexpr double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        const char* p = first;
+        const bool negative = p != last && *p == '-';
+        if (negative) ++p;
+
+        std::uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        const char* start = p;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p, ++digits) mantissa = mantissa * 10 + (*p - '0');
+        const bool has_integer = p != start;
+        if (p != last && *p == '.') {
+            const char* fraction = ++p;
+            for (; p != last && *p >= '0' && *p <= '9'; ++p, ++digits) mantissa = mantissa * 10 + (*p - '0');
+            exponent = -static_cast<int>(p - fraction);
+            if (!has_integer && p == fraction) return nullptr;
+        } else if (!has_integer) {
+            return nullptr;
+        }
+        if (p != last && (*p == 'e' || *p == 'E')) {
+            const char* q = p + 1;
+            const bool negative_exponent = q != last && *q == '-';
+            if (q != last && (*q == '-' || *q == '+')) ++q;
+            if (q == last || *q < '0' || *q > '9') return nullptr;
+            int e = 0;
+            for (; q != last && *q >= '0' && *q <= '9' && e < 10000; ++q) e = e * 10 + (*q - '0');
+            exponent += negative_exponent ? -e : e;
+            p = q;
+        }
+
+        // leading zeros count as digits above, so 19 digits is a safe bound for uint64 overflow
+        if (digits > 19 || mantissa > (std::uint64_t{1} << 53) || exponent < -22 || exponent > 22) return nullptr;
+        double value = static_cast<double>(mantissa);
+        value = exponent < 0 ? value / pow10[-exponent] : value * pow10[exponent];
+        out = negative ? -value : value;
+        return p;
+    }
+
+    class value_reader {
+    public:
+        explicit value_reader(std::string_view text) noexcept : text_(text) {}
+
+        [[noreturn]] void fail(const std::string& what) const {
+            throw std::invalid_argument("Parse: " + what + " at position " + std::to_string(pos_) + " in '" +
+                                        std::string(text_) + "'");
+        }
+
+        void skip_space() noexcept {
+            while (pos_ < text_.size() && (text_[pos_] == ' ' || text_[pos_] == '\t' || text_[pos_] == '\n' ||
+                                           text_[pos_] == '\r')) ++pos_;
+        }
+
+        bool accept(char c) noexcept {
+            skip_space();
+            if (pos_ < text_.size() && text_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char c) {
+            if (!accept(c)) fail(std::string("expected '") + c + "'");
+        }
+
+        [[nodiscard]] bool at_end() noexcept {
+            skip_space();
+            return pos_ == text_.size();
+        }
+
+        [[nodiscard]] std::string_view rest() const noexcept { return text_.substr(pos_); }
+
+        // ---- values
+        template<class T>
+        void read(T& out, bool in_list) {
+            if constexpr (std::is_same_v<T, bool>) {
+                read_bool(out);
+            } else if constexpr (std::is_arithmetic_v<T>) {
+                read_number(out);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                read_string(out, in_list);
+            } else if constexpr (std::is_same_v<T, Eigen::Quaterniond>) {
+                double c[4];
+                read_tuple(c, 4);
+                out = Eigen::Quaterniond(c[0], c[1], c[2], c[3]);
+            } else if constexpr (waveform_type<T>) {
+                read_samples(out);
+            } else if constexpr (T::RowsAtCompileTime == 1 || T::ColsAtCompileTime == 1) {
+                read_tuple(out.data(), T::SizeAtCompileTime);
+            } else {
+                expect('(');
+                for (int r = 0; r < T::RowsAtCompileTime; ++r) {
+                    if (r > 0) expect(',');
+                    typename T::Scalar row[T::ColsAtCompileTime];
+                    read_tuple(row, T::ColsAtCompileTime);
+                    for (int c = 0; c < T::ColsAtCompileTime; ++c) out(r, c) = row[c];
+                }
+                expect(')');
+            }
+        }
+
+    private:
+        std::string_view text_;
+        std::size_t pos_ = 0;
+
+        template<class T>
+        void read_number(T& out) {
+            skip_space();
+            const char* first = text_.data() + pos_;
+            const char* last = text_.data() + text_.size();
+            if (first != last && *first == '+') ++first; // from_chars does not accept a leading '+'
+            if constexpr (std::is_same_v<T, double>) {
+                if (const char* end = parse_double_fast(first, last, out)) {
+                    pos_ = static_cast<std::size_t>(end - text_.data());
+                    return;
+                }
+            }
+            const auto [end, ec] = std::from_chars(first, last, out);
+            if (ec == std::errc::result_out_of_range) fail("number out of range");
+            if (ec != std::errc{}) fail(std::is_integral_v<T> ? "expected an integer" : "expected a number");
+            pos_ = static_cast<std::size_t>(end - text_.data());
+        }
+
+        void read_bool(bool& out) {
+            skip_space();
+            const std::string_view r = rest();
+            std::size_t length = 0;
+            if (r.starts_with("true")) {
+                out = true;
+                length = 4;
+            } else if (r.starts_with("false")) {
+                out = false;
+                length = 5;
+            } else if (r.starts_with('1') || r.starts_with('0')) {
+                out = r[0] == '1';
+                length = 1;
+            }
+            // the keyword must end at a separator, so "truex" or "10" are not read as true
+            const bool at_separator = length == r.size() || std::string_view(" \t\n\r,])").contains(r[length]);
+            if (length == 0 || !at_separator) fail("expected true or false");
+            pos_ += length;
+        }
+
+        void read_string(std::string& out, bool in_list) {
+            skip_space();
+            out.clear();
+            if (pos_ < text_.size() && text_[pos_] == '"') {
+                for (++pos_; pos_ < text_.size() && text_[pos_] != '"'; ++pos_) {
+                    if (text_[pos_] == '\\' && pos_ + 1 < text_.size()) ++pos_;
+                    out.push_back(text_[pos_]);
+                }
+                if (pos_ == text_.size()) fail("unterminated string");
+                ++pos_;
+                return;
+            }
+            if (!in_list) {
+                out.assign(text_.substr(pos_));
+                pos_ = text_.size();
+                return;
+            }
+            const std::size_t end = text_.find_first_of(",]", pos_);
+            const std::size_t stop = end == std::string_view::npos ? text_.size() : end;
+            std::size_t last = stop;
+            while (last > pos_ && text_[last - 1] == ' ') --last;
+            out.assign(text_.substr(pos_, last - pos_));
+            pos_ = stop;
+        }
+
+        // a tuple of any length, e.g. the samples of a waveform
+        template<class W>
+        void read_samples(W& out) {
+            std::vector<typename W::Scalar> samples;
+            expect('(');
+            if (!accept(')')) {
+                do {
+                    read_number(samples.emplace_back());
+                } while (accept(','));
+                expect(')');
+            }
+            out = Eigen::Map<const W>(samples.data(), static_cast<Eigen::Index>(samples.size()));
+        }
+
+        template<class S>
+        void read_tuple(S* out, int n) {
+            expect('(');
+            for (int i = 0; i < n; ++i) {
+                if (i > 0) expect(',');
+                read_number(out[i]);
+            }
+            expect(')');
+        }
+    };
+
+    // the unit symbol in the form written by fmt ("{:u}") and in the portable form
+    template<auto Unit>
+    bool unit_symbol_matches(std::string_view symbol) {
+        constexpr auto unit = mp_units::get_unit(Unit);
+        constexpr std::string_view utf8 = mp_units::unit_symbol(unit);
+        constexpr std::string_view portable = mp_units::unit_symbol<mp_units::unit_symbol_formatting{
+            .char_set = mp_units::character_set::portable}>(unit);
+        return symbol == utf8 || symbol == portable;
+    }
+
+} // namespace detail
+
+    // ---- parse text into values
+    // Replaces the values of out. A unit suffix, if present, must be the symbol of Unit. On an error out is left
+    // cleared or partly written; ParseInto() leaves the parameter unchanged instead.
+    template<class T, auto Unit, std::size_t N>
+    void ParseValues(std::string_view text, small_vector<T, N>& out) {
+        detail::value_reader in(text);
+        out.clear();
+        if (in.accept('[')) {
+            if (!in.accept(']')) {
+                do {
+                    in.read(out.emplace_back(), true);
+                } while (in.accept(','));
+                in.expect(']');
+            }
+        } else {
+            in.read(out.emplace_back(), false);
+        }
+
+        if (in.at_end()) return;
+        std::string_view symbol = in.rest();
+        while (!symbol.empty() && (symbol.back() == ' ' || symbol.back() == '\n' || symbol.back() == '\r')) {
+            symbol.remove_suffix(1);
+        }
+        if (!detail::unit_symbol_matches<Unit>(symbol)) {
+            const std::string_view expected = mp_units::unit_symbol(mp_units::get_unit(Unit));
+            in.fail("unit '" + std::string(symbol) + "' does not match '" + std::string(expected) + "'");
+        }
+    }
+
+    // Set the values of a parameter from text, e.g. ParseInto("[0.01, 0.02] s", te). The values are parsed into a
+    // local buffer and moved into p on success, so p keeps its values if the text does not parse.
+    template<class T, auto Unit>
+    void ParseInto(std::string_view text, ParameterBase<T, Unit>& p) {
+        typename ParameterBase<T, Unit>::storage_type values;
+        ParseValues<T, Unit>(text, values);
+        p.Get() = std::move(values);
+        p.NotifyChanged();
+    }
+
+    // Construct a parameter of class P from text, e.g. Parse<EchoTime>("0.01 s")
+    template<class P>
+        requires parameter_like<P>
+    [[nodiscard]] P Parse(std::string_view text) {
+        P p;
+        ParseInto(text, p);
+        return p;
+    }
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,271 @@
+// protocol_state.h
+// This file defines ProtocolState, a persistent (structurally shared) set of parameters keyed by ParameterId,
+// and ProtocolHistory, an undo/redo history of states.
+// Parameters in a state are immutable and reference counted (std::shared_ptr<const IParameter>). The state
+// is a hash array mapped trie over the 64-bit id: 32-way nodes with a bitmap, so a lookup visits about
+// log32(n) nodes. Copying a state copies the root pointer, O(1). Setting a parameter copies the nodes on the
+// path to it (a few small nodes) and the parameter itself, O(size of that parameter); every other parameter
+// and node stays shared with the previous states, so undo steps and what-if variants cost only their changes.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+    // ======== ProtocolState ========
+    class ProtocolState {
+    public:
+        ProtocolState() = default;
+
+        // ---- lookup
+        [[nodiscard]] const IParameter* Find(ParameterId id) const noexcept {
+            const node* n = root_.get();
+            for (unsigned shift = 0; n != nullptr; shift += bits) {
+                const std::uint32_t bit = bit_of(id, shift);
+                if ((n->bitmap & bit) == 0) return nullptr;
+                const slot& s = n->slots[n->index(bit)];
+                if (!s.child) return s.id == id ? s.param.get() : nullptr;
+                n = s.child.get();
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] const IParameter* Find(std::string_view name) const noexcept { return Find(ParameterId(name)); }
+
+        // The parameter of class P (looked up by P::id), or nullptr if there is none or the parameter stored
+        // under P::id is of another class (e.g. a SnapshotParameter)
+        template<class P>
+        [[nodiscard]] const P* Get() const noexcept { return dynamic_cast<const P*>(Find(P::id)); }
+
+        // Shared handle of a parameter, to keep it alive independently of the state
+        [[nodiscard]] std::shared_ptr<const IParameter> Share(ParameterId id) const noexcept {
+            const slot* s = find_slot(id);
+            return s != nullptr ? s->param : nullptr;
+        }
+
+        [[nodiscard]] bool Contains(ParameterId id) const noexcept { return Find(id) != nullptr; }
+        [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+        [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+        // ---- modification, copying only the path to the parameter
+        // Insert or replace the parameter stored under p->Id()
+        void Set(std::shared_ptr<const IParameter> p) {
+            if (!p) throw std::invalid_argument("ProtocolState: null parameter");
+            const ParameterId id = p->Id();
+            bool added = false;
+            root_ = insert(root_.get(), id, std::move(p), 0, added);
+            if (added) ++size_;
+        }
+
+        // Insert or replace a parameter by value, e.g. state.Set(EchoTime(0.01))
+        template<class P>
+            requires std::is_base_of_v<IParameter, std::remove_cvref_t<P>>
+        void Set(P&& p) {
+            Set(std::make_shared<const std::remove_cvref_t<P>>(std::forward<P>(p)));
+        }
+
+        // Copy the parameter of class P, apply f(P&) to the copy and store it.
+        // Throws std::out_of_range if the state has no parameter P.
+        template<class P, class F>
+        void Modify(F&& f) {
+            const P* current = Get<P>();
+            if (current == nullptr) throw std::out_of_range("ProtocolState: no parameter " + std::string(P::name));
+            auto copy = std::make_shared<P>(*current);
+            f(*copy);
+            Set(std::shared_ptr<const IParameter>(std::move(copy)));
+        }
+
+        // Remove the parameter stored under id; returns false if there is none
+        bool Erase(ParameterId id) {
+            if (find_slot(id) == nullptr) return false;
+            root_ = erase(*root_, id, 0);
+            --size_;
+            return true;
+        }
+
+        // Visit every parameter (in trie order)
+        template<class F>
+        void ForEach(F&& f) const {
+            if (root_) for_each(*root_, f);
+        }
+
+        // true if both states hold the same parameter object for id (structural sharing, no value comparison)
+        [[nodiscard]] bool Shares(const ProtocolState& other, ParameterId id) const noexcept {
+            const IParameter* p = Find(id);
+            return p != nullptr && p == other.Find(id);
+        }
+
+    private:
+        static constexpr unsigned bits = 5; // 32-way nodes
+
+        struct node;
+
+        // a leaf (param set, child empty) or a sub-trie (child set)
+        struct slot {
+            std::shared_ptr<const node> child;
+            ParameterId id;
+            std::shared_ptr<const IParameter> param;
+        };
+
+        struct node {
+            std::uint32_t bitmap = 0;
+            std::vector<slot> slots; // one per set bit, in bit order
+
+            [[nodiscard]] std::size_t index(std::uint32_t bit) const noexcept {
+                return static_cast<std::size_t>(std::popcount(bitmap & (bit - 1)));
+            }
+        };
+
+        std::shared_ptr<const node> root_;
+        std::size_t size_ = 0;
+
+        [[nodiscard]] static std::uint32_t bit_of(ParameterId id, unsigned shift) noexcept {
+            return std::uint32_t{1} << ((id.value >> shift) & 31u);
+        }
+
+        [[nodiscard]] const slot* find_slot(ParameterId id) const noexcept {
+            const node* n = root_.get();
+            for (unsigned shift = 0; n != nullptr; shift += bits) {
+                const std::uint32_t bit = bit_of(id, shift);
+                if ((n->bitmap & bit) == 0) return nullptr;
+                const slot& s = n->slots[n->index(bit)];
+                if (!s.child) return s.id == id ? &s : nullptr;
+                n = s.child.get();
+            }
+            return nullptr;
+        }
+
+        // a sub-trie holding two leaves whose ids agree below shift
+        static std::shared_ptr<const node> make_pair(slot a, slot b, unsigned shift) {
+            auto n = std::make_shared<node>();
+            const std::uint32_t bit_a = bit_of(a.id, shift);
+            const std::uint32_t bit_b = bit_of(b.id, shift);
+            if (bit_a == bit_b) {
+                n->bitmap = bit_a;
+                n->slots.push_back({make_pair(std::move(a), std::move(b), shift + bits), {}, nullptr});
+            } else {
+                n->bitmap = bit_a | bit_b;
+                if (bit_a < bit_b) {
+                    n->slots.push_back(std::move(a));
+                    n->slots.push_back(std::move(b));
+                } else {
+                    n->slots.push_back(std::move(b));
+                    n->slots.push_back(std::move(a));
+                }
+            }
+            return n;
+        }
+
+        static std::shared_ptr<const node> insert(const node* n, ParameterId id, std::shared_ptr<const IParameter> p,
+                                                  unsigned shift, bool& added) {
+            auto copy = n != nullptr ? std::make_shared<node>(*n) : std::make_shared<node>();
+            const std::uint32_t bit = bit_of(id, shift);
+            const std::size_t i = copy->index(bit);
+            if ((copy->bitmap & bit) == 0) {
+                copy->bitmap |= bit;
+                copy->slots.insert(copy->slots.begin() + static_cast<std::ptrdiff_t>(i), slot{nullptr, id, std::move(p)});
+                added = true;
+            } else if (slot& s = copy->slots[i]; s.child) {
+                s.child = insert(s.child.get(), id, std::move(p), shift + bits, added);
+            } else if (s.id == id) {
+                s.param = std::move(p);
+            } else {
+                s = slot{make_pair(std::move(s), slot{nullptr, id, std::move(p)}, shift + bits), {}, nullptr};
+                added = true;
+            }
+            return copy;
+        }
+
+        // id is present below n
+        static std::shared_ptr<const node> erase(const node& n, ParameterId id, unsigned shift) {
+            const std::uint32_t bit = bit_of(id, shift);
+            const std::size_t i = n.index(bit);
+            auto copy = std::make_shared<node>(n);
+            if (const slot& s = n.slots[i]; s.child) {
+                auto child = erase(*s.child, id, shift + bits);
+                if (child->slots.size() == 1 && !child->slots[0].child) {
+                    copy->slots[i] = child->slots[0]; // pull a single leaf up
+                } else {
+                    copy->slots[i].child = std::move(child);
+                }
+            } else {
+                copy->bitmap &= ~bit;
+                copy->slots.erase(copy->slots.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            if (copy->slots.empty()) return nullptr;
+            return copy;
+        }
+
+        template<class F>
+        static void for_each(const node& n, F& f) {
+            for (const slot& s : n.slots) {
+                if (s.child) for_each(*s.child, f);
+                else f(static_cast<const IParameter&>(*s.param));
+            }
+        }
+    };
+
+    // ======== ProtocolHistory: undo/redo over ProtocolState ========
+    class ProtocolHistory {
+    public:
+        explicit ProtocolHistory(ProtocolState initial = {}, std::size_t max_depth = 1000)
+            : current_(std::move(initial)), max_depth_(max_depth) {}
+
+        [[nodiscard]] const ProtocolState& Current() const noexcept { return current_; }
+
+        // Make next the current state; the previous one becomes undoable and the redo list is dropped
+        void Commit(ProtocolState next) {
+            undo_.push_back(std::move(current_));
+            if (undo_.size() > max_depth_) undo_.erase(undo_.begin());
+            current_ = std::move(next);
+            redo_.clear();
+        }
+
+        // Commit the result of f(ProtocolState&) applied to a copy of the current state
+        template<class F>
+        void Edit(F&& f) {
+            ProtocolState next = current_;
+            f(next);
+            Commit(std::move(next));
+        }
+
+        bool Undo() {
+            if (undo_.empty()) return false;
+            redo_.push_back(std::move(current_));
+            current_ = std::move(undo_.back());
+            undo_.pop_back();
+            return true;
+        }
+
+        bool Redo() {
+            if (redo_.empty()) return false;
+            undo_.push_back(std::move(current_));
+            current_ = std::move(redo_.back());
+            redo_.pop_back();
+            return true;
+        }
+
+        [[nodiscard]] std::size_t UndoDepth() const noexcept { return undo_.size(); }
+        [[nodiscard]] std::size_t RedoDepth() const noexcept { return redo_.size(); }
+
+    private:
+        ProtocolState current_;
+        std::vector<ProtocolState> undo_;
+        std::vector<ProtocolState> redo_;
+        std::size_t max_depth_;
+    };
+
+}; // namespace methodverse::parameter
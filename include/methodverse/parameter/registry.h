@@ -0,0 +1,159 @@
+// registry.h
+// This file defines ParameterRegistry, the lookup table of the parameters of a protocol by ParameterId.
+// It is a flat open-addressing hash table with linear probing, kept at most half full, so a lookup by
+// id is usually a single probe into one contiguous array and never allocates. The registry does not own
+// the parameters.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+    class ParameterRegistry {
+    public:
+        ParameterRegistry() = default;
+        explicit ParameterRegistry(std::size_t expected) { Reserve(expected); }
+
+        ParameterRegistry(const ParameterRegistry&) = default;
+        ParameterRegistry& operator=(const ParameterRegistry&) = default;
+
+        // A moved-from registry is empty and usable
+        ParameterRegistry(ParameterRegistry&& other) noexcept
+            : slots_(std::move(other.slots_)), mask_(std::exchange(other.mask_, 0)),
+              size_(std::exchange(other.size_, 0)) {
+            other.slots_.clear();
+        }
+        ParameterRegistry& operator=(ParameterRegistry&& other) noexcept {
+            slots_ = std::move(other.slots_);
+            other.slots_.clear();
+            mask_ = std::exchange(other.mask_, 0);
+            size_ = std::exchange(other.size_, 0);
+            return *this;
+        }
+
+        // Register p under p.Id(). Throws std::invalid_argument if another parameter has the same id
+        // (duplicate name or hash collision). Registering the same parameter twice is a no-op.
+        void Insert(IParameter& p) {
+            if (2 * (size_ + 1) > slots_.size()) rehash(std::max<std::size_t>(16, 2 * slots_.size()));
+            const ParameterId id = p.Id();
+            std::size_t i = home(id);
+            for (; slots_[i].param != nullptr; i = (i + 1) & mask_) {
+                if (slots_[i].id == id) {
+                    if (slots_[i].param == &p) return;
+                    throw std::invalid_argument("ParameterRegistry: " + std::string(p.NameView()) +
+                                                " has the same id as " + std::string(slots_[i].param->NameView()));
+                }
+            }
+            slots_[i] = {id, &p};
+            ++size_;
+        }
+
+        // Parameter registered under id, or nullptr
+        [[nodiscard]] IParameter* Find(ParameterId id) const noexcept {
+            if (size_ == 0) return nullptr;
+            for (std::size_t i = home(id); slots_[i].param != nullptr; i = (i + 1) & mask_) {
+                if (slots_[i].id == id) return slots_[i].param;
+            }
+            return nullptr;
+        }
+
+        // Lookup by name, hashed at run time
+        [[nodiscard]] IParameter* Find(std::string_view name) const noexcept { return Find(ParameterId(name)); }
+
+        // Lookup of a Parameter<T, Derived, Unit> class by its compile-time id; nullptr if nothing is registered
+        // under the name of P or if the parameter registered under it is not a P (e.g. a SnapshotParameter)
+        template<class P>
+        [[nodiscard]] P* Find() const noexcept { return dynamic_cast<P*>(Find(P::id)); }
+
+        [[nodiscard]] bool Contains(ParameterId id) const noexcept { return Find(id) != nullptr; }
+
+        // Remove the parameter registered under id; returns false if there is none
+        bool Erase(ParameterId id) noexcept {
+            if (size_ == 0) return false;
+            std::size_t i = home(id);
+            for (; slots_[i].param != nullptr; i = (i + 1) & mask_) {
+                if (slots_[i].id == id) break;
+            }
+            if (slots_[i].param == nullptr) return false;
+
+            // backward shift deletion: move later entries of the probe sequence into the hole
+            for (std::size_t j = (i + 1) & mask_; slots_[j].param != nullptr; j = (j + 1) & mask_) {
+                const std::size_t h = home(slots_[j].id);
+                // the entry at j may fill the hole at i if its home is not in (i, j] (cyclically)
+                if (((j - h) & mask_) >= ((j - i) & mask_)) {
+                    slots_[i] = slots_[j];
+                    i = j;
+                }
+            }
+            slots_[i] = {};
+            --size_;
+            return true;
+        }
+
+        void Reserve(std::size_t n) {
+            const std::size_t needed = std::bit_ceil(std::max<std::size_t>(16, 2 * n));
+            if (needed > slots_.size()) rehash(needed);
+        }
+
+        void Clear() noexcept {
+            for (auto& s : slots_) s = {};
+            size_ = 0;
+        }
+
+        [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+        [[nodiscard]] bool Empty() const noexcept { return size_ == 0; }
+
+        // Replace every registered pointer p by f(p), e.g. after the parameters were copied to another
+        // address; f must map each parameter to one with the same id
+        template<class F>
+        void Rebind(F&& f) {
+            for (auto& s : slots_) if (s.param != nullptr) s.param = f(s.param);
+        }
+
+        // Visit every registered parameter (in table order)
+        template<class F>
+        void ForEach(F&& f) const {
+            for (const auto& s : slots_) if (s.param != nullptr) f(*s.param);
+        }
+
+    private:
+        struct slot {
+            ParameterId id;
+            IParameter* param = nullptr; // nullptr marks an empty slot
+        };
+
+        std::vector<slot> slots_;
+        std::size_t mask_ = 0;
+        std::size_t size_ = 0;
+
+        // Fibonacci hashing spreads the FNV bits over the index range
+        [[nodiscard]] std::size_t home(ParameterId id) const noexcept {
+            return static_cast<std::size_t>((id.value * 0x9e3779b97f4a7c15ull) >> 32) & mask_;
+        }
+
+        void rehash(std::size_t capacity) {
+            std::vector<slot> old(capacity);
+            old.swap(slots_);
+            mask_ = capacity - 1;
+            for (const auto& s : old) {
+                if (s.param == nullptr) continue;
+                std::size_t i = home(s.id);
+                while (slots_[i].param != nullptr) i = (i + 1) & mask_;
+                slots_[i] = s;
+            }
+        }
+    };
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,153 @@
+// runtime_unit.h
+// This file defines RuntimeUnit, the run-time counterpart of the mp-units unit of a ParameterBase.
+// Type-erased code (UI, scripting, the runtime operator dispatch) only sees IParameter and cannot use the
+// compile-time unit algebra of mp-units, so every unit is also decoded into the exponents of the SI base
+// units plus a scale factor. The decoding is done at compile time from the canonical form of the unit
+// (mp_units::get_canonical_unit), e.g. Hz/T -> 0.001 * A s g^-1.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <mp-units/core.h>
+#include <mp-units/systems/si/units.h>
+
+namespace methodverse::parameter {
+
+    // ---- RuntimeUnit
+    // magnitude is the scale factor to the coherent unit built from the SI base units (with gram as the
+    // base unit of mass, as in mp-units): s -> 1, ms -> 0.001, kg -> 1000.
+    struct RuntimeUnit {
+        static constexpr std::size_t base_count = 7;
+        static constexpr std::array<const char*, base_count> base_symbols{"m", "g", "s", "A", "K", "mol", "cd"};
+
+        std::array<std::int8_t, base_count> exponents{};
+        double magnitude = 1.0;
+
+        [[nodiscard]] constexpr bool IsDimensionless() const noexcept {
+            for (auto e : exponents) if (e != 0) return false;
+            return true;
+        }
+
+        // Same dimension, regardless of the magnitude (e.g. ms and s)
+        [[nodiscard]] constexpr bool SameDimension(const RuntimeUnit& other) const noexcept {
+            return exponents == other.exponents;
+        }
+
+        // Equivalent units: same dimension and same magnitude up to rounding, so Hz == 1/s
+        [[nodiscard]] friend constexpr bool operator==(const RuntimeUnit& lhs, const RuntimeUnit& rhs) noexcept {
+            constexpr auto abs = [](double x) { return x < 0 ? -x : x; };
+            const double scale = std::max(abs(lhs.magnitude), abs(rhs.magnitude));
+            return lhs.exponents == rhs.exponents && abs(lhs.magnitude - rhs.magnitude) <= 1e-12 * scale;
+        }
+
+        [[nodiscard]] friend constexpr RuntimeUnit operator*(const RuntimeUnit& lhs, const RuntimeUnit& rhs) noexcept {
+            RuntimeUnit r;
+            for (std::size_t i = 0; i < base_count; ++i)
+                r.exponents[i] = static_cast<std::int8_t>(lhs.exponents[i] + rhs.exponents[i]);
+            r.magnitude = lhs.magnitude * rhs.magnitude;
+            return r;
+        }
+
+        [[nodiscard]] friend constexpr RuntimeUnit operator/(const RuntimeUnit& lhs, const RuntimeUnit& rhs) noexcept {
+            RuntimeUnit r;
+            for (std::size_t i = 0; i < base_count; ++i)
+                r.exponents[i] = static_cast<std::int8_t>(lhs.exponents[i] - rhs.exponents[i]);
+            r.magnitude = lhs.magnitude / rhs.magnitude;
+            return r;
+        }
+
+        // e.g. "0.001 A s g^-1", "m", "1" for dimensionless
+        [[nodiscard]] std::string ToString() const {
+            std::string s;
+            if (magnitude != 1.0 || IsDimensionless()) {
+                std::array<char, 32> buf{};
+                std::snprintf(buf.data(), buf.size(), "%g", magnitude);
+                s = buf.data();
+            }
+            for (std::size_t i = 0; i < base_count; ++i) {
+                if (exponents[i] == 0) continue;
+                if (!s.empty()) s += ' ';
+                s += base_symbols[i];
+                if (exponents[i] != 1) s += '^' + std::to_string(exponents[i]);
+            }
+            return s;
+        }
+    };
+
+namespace detail {
+
+    // the unit objects (si::metre, one, ...) hide their type names
+    template<auto U>
+    using unit_type = std::remove_const_t<decltype(U)>;
+
+    // ---- index of an SI base unit in RuntimeUnit::exponents
+    template<class U> inline constexpr int si_base_index = -1;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::metre>> = 0;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::gram>> = 1;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::second>> = 2;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::ampere>> = 3;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::kelvin>> = 4;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::mole>> = 5;
+    template<> inline constexpr int si_base_index<unit_type<mp_units::si::candela>> = 6;
+
+    // ---- accumulate the exponents of one factor of a canonical unit
+    // A factor is a base unit, power<base, N>, per<factors...> (negative exponents) or derived_unit<factors...>
+    template<class F>
+    struct unit_exponents {
+        static constexpr void add(std::array<std::int8_t, RuntimeUnit::base_count>& e, int sign) {
+            static_assert(si_base_index<F> >= 0, "RuntimeUnit: unit is not built from SI base units");
+            e[si_base_index<F>] = static_cast<std::int8_t>(e[si_base_index<F>] + sign);
+        }
+    };
+
+    template<>
+    struct unit_exponents<unit_type<mp_units::one>> {
+        static constexpr void add(std::array<std::int8_t, RuntimeUnit::base_count>&, int) {}
+    };
+
+    template<class F, int Num, int... Den>
+    struct unit_exponents<mp_units::power<F, Num, Den...>> {
+        static_assert(sizeof...(Den) == 0, "RuntimeUnit: fractional unit exponents are not supported");
+        static constexpr void add(std::array<std::int8_t, RuntimeUnit::base_count>& e, int sign) {
+            e[si_base_index<F>] = static_cast<std::int8_t>(e[si_base_index<F>] + sign * Num);
+        }
+    };
+
+    template<class... Fs>
+    struct unit_exponents<mp_units::per<Fs...>> {
+        static constexpr void add(std::array<std::int8_t, RuntimeUnit::base_count>& e, int sign) {
+            (unit_exponents<Fs>::add(e, -sign), ...);
+        }
+    };
+
+    template<class... Fs>
+    struct unit_exponents<mp_units::derived_unit<Fs...>> {
+        static constexpr void add(std::array<std::int8_t, RuntimeUnit::base_count>& e, int sign) {
+            (unit_exponents<Fs>::add(e, sign), ...);
+        }
+    };
+
+    template<mp_units::Reference auto R>
+    consteval RuntimeUnit make_runtime_unit() {
+        constexpr auto canonical = mp_units::get_canonical_unit(mp_units::get_unit(R));
+        RuntimeUnit u;
+        unit_exponents<std::remove_cvref_t<decltype(canonical.reference_unit)>>::add(u.exponents, 1);
+        u.magnitude = get_value<double>(canonical.mag);
+        return u;
+    }
+
+} // namespace detail
+
+    // ---- RuntimeUnit of a compile-time unit (or reference)
+    template<mp_units::Reference auto R>
+    inline constexpr RuntimeUnit runtime_unit_of = detail::make_runtime_unit<R>();
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,283 @@
+// small_vector.h
+// This file defines small_vector, a contiguous container with inline storage for the first N elements.
+// Most protocol parameters (TE, TR, flip angle, FOV) hold exactly one value, so keeping that value inside
+// the ParameterBase object avoids a heap allocation on construction, copy and in operator temporaries.
+// The container only spills to the heap when the number of values exceeds the inline capacity.
+// The inline capacity is selected per value type through the inline_capacity trait, which can be
+// specialized by users (e.g. to keep 3 slice positions inline).
+// The container holds no pointer into itself (the inline buffer is in use iff capacity() == N), so while
+// the values are inline a copy copies the inline buffer and does not allocate.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace methodverse::parameter {
+
+    // ---- inline capacity of the value storage of ParameterBase<T, Unit>, specialize to tune per type
+    template<class T>
+    struct inline_capacity : std::integral_constant<std::size_t, 1> {};
+
+    template<class T>
+    inline constexpr std::size_t inline_capacity_v = inline_capacity<T>::value;
+
+    // ---- small_vector
+    // A std::vector-like container that stores up to N elements inline (N >= 1).
+    // Heap memory is allocated with the alignment of T, which keeps Eigen fixed-size types safe.
+    template<class T, std::size_t N>
+    class small_vector {
+        static_assert(N >= 1, "small_vector requires an inline capacity of at least 1");
+
+    public:
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr size_type inline_size = N;
+
+        // Constructors
+        small_vector() noexcept = default;
+
+        explicit small_vector(size_type n) { resize(n); }
+
+        small_vector(size_type n, const T& value) { assign(n, value); }
+
+        small_vector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+
+        template<std::input_iterator It>
+        small_vector(It first, It last) { assign(first, last); }
+
+        small_vector(const std::vector<T>& values) { assign(values.begin(), values.end()); }
+
+        small_vector(const small_vector& other) { assign(other.begin(), other.end()); }
+
+        small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            steal(std::move(other));
+        }
+
+        ~small_vector() {
+            destroy_all();
+            release();
+        }
+
+        small_vector& operator=(const small_vector& other) {
+            if (this != &other) assign(other.begin(), other.end());
+            return *this;
+        }
+
+        small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                destroy_all();
+                release();
+                steal(std::move(other));
+            }
+            return *this;
+        }
+
+        small_vector& operator=(std::initializer_list<T> values) {
+            assign(values.begin(), values.end());
+            return *this;
+        }
+
+        small_vector& operator=(const std::vector<T>& values) {
+            assign(values.begin(), values.end());
+            return *this;
+        }
+
+        // Assignment helpers
+        template<std::input_iterator It>
+        void assign(It first, It last) {
+            clear();
+            if constexpr (std::forward_iterator<It>) {
+                reserve(static_cast<size_type>(std::distance(first, last)));
+            }
+            for (; first != last; ++first) emplace_back(*first);
+        }
+
+        void assign(size_type n, const T& value) {
+            clear();
+            reserve(n);
+            std::uninitialized_fill_n(data(), n, value);
+            size_ = n;
+        }
+
+        // Element access
+        [[nodiscard]] T& operator[](size_type i) noexcept { return data()[i]; }
+        [[nodiscard]] const T& operator[](size_type i) const noexcept { return data()[i]; }
+
+        [[nodiscard]] T& at(size_type i) {
+            if (i >= size_) throw std::out_of_range("small_vector::at: index out of range");
+            return data()[i];
+        }
+        [[nodiscard]] const T& at(size_type i) const {
+            if (i >= size_) throw std::out_of_range("small_vector::at: index out of range");
+            return data()[i];
+        }
+
+        [[nodiscard]] T& front() noexcept { return data()[0]; }
+        [[nodiscard]] const T& front() const noexcept { return data()[0]; }
+        [[nodiscard]] T& back() noexcept { return data()[size_ - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return data()[size_ - 1]; }
+        [[nodiscard]] T* data() noexcept { return is_inline() ? inline_data() : heap_; }
+        [[nodiscard]] const T* data() const noexcept { return is_inline() ? inline_data() : heap_; }
+
+        // Iterators
+        [[nodiscard]] iterator begin() noexcept { return data(); }
+        [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+        [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+        [[nodiscard]] iterator end() noexcept { return data() + size_; }
+        [[nodiscard]] const_iterator end() const noexcept { return data() + size_; }
+        [[nodiscard]] const_iterator cend() const noexcept { return data() + size_; }
+
+        // Capacity
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] size_type size() const noexcept { return size_; }
+        [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+        // heap buffers are always larger than N, so the capacity tells where the values are
+        [[nodiscard]] bool is_inline() const noexcept { return capacity_ == N; }
+
+        void reserve(size_type n) {
+            if (n > capacity_) reallocate(n);
+        }
+
+        // Modifiers
+        void clear() noexcept { destroy_all(); }
+
+        void resize(size_type n) {
+            if (n < size_) {
+                std::destroy(data() + n, data() + size_);
+            } else if (n > size_) {
+                reserve(n);
+                std::uninitialized_value_construct(data() + size_, data() + n);
+            }
+            size_ = n;
+        }
+
+        void resize(size_type n, const T& value) {
+            if (n < size_) {
+                std::destroy(data() + n, data() + size_);
+            } else if (n > size_) {
+                reserve(n);
+                std::uninitialized_fill(data() + size_, data() + n, value);
+            }
+            size_ = n;
+        }
+
+        // resize without value-initializing new elements; for arithmetic and Eigen types they are left
+        // uninitialized and must be overwritten by the caller (used by the element-wise operator kernels)
+        void resize_for_overwrite(size_type n) {
+            if (n < size_) {
+                std::destroy(data() + n, data() + size_);
+            } else if (n > size_) {
+                reserve(n);
+                std::uninitialized_default_construct(data() + size_, data() + n);
+            }
+            size_ = n;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template<class... Args>
+        T& emplace_back(Args&&... args) {
+            if constexpr (sizeof...(Args) == 0) {
+                // nothing to alias: construct in place, a default-constructed Eigen object is not read or moved
+                if (size_ == capacity_) reallocate(grow_to(size_ + 1));
+                std::construct_at(data() + size_);
+            } else if (size_ == capacity_) {
+                // construct first: args may alias an element that moves during reallocation
+                T tmp(std::forward<Args>(args)...);
+                reallocate(grow_to(size_ + 1));
+                std::construct_at(data() + size_, std::move(tmp));
+            } else {
+                std::construct_at(data() + size_, std::forward<Args>(args)...);
+            }
+            return data()[size_++];
+        }
+
+        void pop_back() noexcept { std::destroy_at(data() + --size_); }
+
+        // Conversion to std::vector for APIs that still hand out copies
+        [[nodiscard]] std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+
+        // Comparison against any sized range of comparable values (small_vector, std::vector, ...)
+        template<std::ranges::sized_range R>
+        requires std::equality_comparable_with<const T&, std::ranges::range_reference_t<const R>>
+        [[nodiscard]] friend bool operator==(const small_vector& lhs, const R& rhs) {
+            return lhs.size() == static_cast<size_type>(std::ranges::size(rhs)) &&
+                   std::equal(lhs.begin(), lhs.end(), std::ranges::begin(rhs));
+        }
+
+    private:
+        alignas(T) std::byte inline_[N * sizeof(T)];
+        T* heap_ = nullptr; // only used when capacity_ > N
+        size_type size_ = 0;
+        size_type capacity_ = N;
+
+        [[nodiscard]] T* inline_data() noexcept { return reinterpret_cast<T*>(inline_); }
+        [[nodiscard]] const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_); }
+
+        [[nodiscard]] size_type grow_to(size_type n) const noexcept { return std::max(n, capacity_ * 2); }
+
+        static T* allocate(size_type n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        }
+
+        static void deallocate(T* p) noexcept { ::operator delete(p, std::align_val_t{alignof(T)}); }
+
+        void destroy_all() noexcept {
+            std::destroy(data(), data() + size_);
+            size_ = 0;
+        }
+
+        // free the heap buffer (if any) and fall back to the inline buffer; elements must be destroyed already
+        void release() noexcept {
+            if (!is_inline()) deallocate(heap_);
+            heap_ = nullptr;
+            capacity_ = N;
+        }
+
+        // n > capacity_, so the new buffer is always on the heap
+        void reallocate(size_type n) {
+            T* p = allocate(n);
+            T* old = data();
+            std::uninitialized_move(old, old + size_, p);
+            std::destroy(old, old + size_);
+            if (!is_inline()) deallocate(heap_);
+            heap_ = p;
+            capacity_ = n;
+        }
+
+        // take the content of other, stealing its heap buffer if it has one; this must be empty and inline
+        void steal(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (other.is_inline()) {
+                std::uninitialized_move(other.inline_data(), other.inline_data() + other.size_, inline_data());
+                size_ = other.size_;
+                other.destroy_all();
+            } else {
+                heap_ = std::exchange(other.heap_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                capacity_ = std::exchange(other.capacity_, N);
+            }
+        }
+    };
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,552 @@
+// snapshot.h
+// This file defines the binary protocol snapshot format, written by WriteSnapshot() and opened with
+// Snapshot, which memory-maps the file. The values of a snapshot parameter are read in place through
+// IParameter::ViewAs<T>(), nothing is deserialized when a snapshot is opened.
+//
+// Layout (native byte order, checked when opening):
+//     snapshot_header
+//     snapshot_entry[entry_count]       sorted by parameter id
+//     names                             the parameter names, not terminated
+//     payloads                          each aligned to snapshot_alignment
+// An entry holds the parameter id, a type tag (hash of the name in primitive_type_names, so that the tags do
+// not depend on the order of primitive_types), the unit (RuntimeUnit) and the offset and size of its values.
+// Values of trivially copyable types are stored as arrays. std::string values are stored as a sequence of
+// (uint32 length, bytes); they are not views of std::string, so ViewAs<std::string>() is not available on a
+// snapshot (use Snapshot::Strings or LoadInto). Waveform values (VectorXd, ArrayXd, VectorXf, ArrayXf) are stored
+// the same way, as (uint64 sample count, samples padded to 8 bytes) per value, and read in place as Eigen::Map
+// through SnapshotParameter::Waveforms<W>() or copied by LoadInto.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <boost/mp11/algorithm.hpp>
+#include "parameter.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace methodverse::parameter {
+
+    // ======== MappedFile: read-only memory mapping of a whole file ========
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        // Throws std::runtime_error if the file cannot be opened or mapped
+        explicit MappedFile(const std::string& path) {
+#if defined(_WIN32)
+            file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file_ == INVALID_HANDLE_VALUE) throw std::runtime_error("MappedFile: cannot open " + path);
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(file_, &size)) {
+                close();
+                throw std::runtime_error("MappedFile: cannot read the size of " + path);
+            }
+            size_ = static_cast<std::size_t>(size.QuadPart);
+            if (size_ == 0) return;
+            mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ != nullptr) data_ = ::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+            if (data_ == nullptr) {
+                close();
+                throw std::runtime_error("MappedFile: cannot map " + path);
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("MappedFile: cannot open " + path);
+            struct stat st {};
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                throw std::runtime_error("MappedFile: cannot read the size of " + path);
+            }
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ > 0) {
+                void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("MappedFile: cannot map " + path);
+                }
+                data_ = p;
+            }
+            ::close(fd); // the mapping stays valid
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept { swap(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                swap(other);
+            }
+            return *this;
+        }
+
+        ~MappedFile() { close(); }
+
+        [[nodiscard]] std::span<const std::byte> Bytes() const noexcept {
+            return {static_cast<const std::byte*>(data_), size_};
+        }
+
+    private:
+        const void* data_ = nullptr;
+        std::size_t size_ = 0;
+#if defined(_WIN32)
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#endif
+
+        void swap(MappedFile& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+#if defined(_WIN32)
+            std::swap(file_, other.file_);
+            std::swap(mapping_, other.mapping_);
+#endif
+        }
+
+        void close() noexcept {
+#if defined(_WIN32)
+            if (data_ != nullptr) ::UnmapViewOfFile(data_);
+            if (mapping_ != nullptr) ::CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE) ::CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+            mapping_ = nullptr;
+#else
+            if (data_ != nullptr) ::munmap(const_cast<void*>(data_), size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+        }
+    };
+
+namespace detail {
+
+    inline constexpr std::uint16_t snapshot_version = 1;
+    inline constexpr std::size_t snapshot_alignment = 64;
+    inline constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+
+    struct snapshot_header {
+        char magic[4];             // "MVPS"
+        std::uint32_t byte_order;  // snapshot_byte_order as written by the producer
+        std::uint16_t version;
+        std::uint16_t entry_size;  // sizeof(snapshot_entry)
+        std::uint32_t entry_count;
+        std::uint64_t names_offset;
+        std::uint64_t names_size;
+        std::uint64_t file_size;
+    };
+    static_assert(sizeof(snapshot_header) == 40 && std::is_trivially_copyable_v<snapshot_header>);
+
+    struct snapshot_entry {
+        std::uint64_t id;
+        std::uint64_t offset;  // of the payload, from the start of the file
+        std::uint64_t size;    // payload bytes
+        std::uint64_t count;   // number of values
+        double magnitude;
+        std::uint32_t name_offset; // in the name table
+        std::uint32_t name_size;
+        std::uint32_t type_tag;
+        std::array<std::int8_t, 7> exponents;
+        std::uint8_t reserved[5];
+    };
+    static_assert(sizeof(snapshot_entry) == 64 && std::is_trivially_copyable_v<snapshot_entry>);
+
+    [[nodiscard]] constexpr std::uint32_t snapshot_type_tag(std::size_t type_id) noexcept {
+        return static_cast<std::uint32_t>(fnv1a_64(primitive_type_names[type_id]));
+    }
+
+    [[nodiscard]] inline std::size_t snapshot_type_id(std::uint32_t tag) noexcept {
+        for (std::size_t i = 0; i < primitive_type_count; ++i) {
+            if (snapshot_type_tag(i) == tag) return i;
+        }
+        return no_type_id;
+    }
+
+    [[nodiscard]] constexpr std::size_t align_snapshot(std::size_t n) noexcept {
+        return (n + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+    }
+
+    // Calls f with std::type_identity<T> for the primitive type with the given id
+    template<class F>
+    decltype(auto) with_primitive_type(std::size_t type_id, F&& f) {
+        return boost::mp11::mp_with_index<primitive_type_count>(
+            type_id, [&](auto I) { return f(std::type_identity<boost::mp11::mp_at_c<primitive_types, I>>{}); });
+    }
+
+    // ---- std::string payloads: (uint32 length, bytes) per value
+    inline void append_strings(std::vector<std::byte>& out, std::span<const std::string> values) {
+        for (const auto& s : values) {
+            const auto n = static_cast<std::uint32_t>(s.size());
+            const auto* len = reinterpret_cast<const std::byte*>(&n);
+            out.insert(out.end(), len, len + sizeof(n));
+            const auto* chars = reinterpret_cast<const std::byte*>(s.data());
+            out.insert(out.end(), chars, chars + s.size());
+        }
+    }
+
+    // Calls f(std::string_view) for every value; returns false if the payload is malformed
+    template<class F>
+    bool for_each_string(std::span<const std::byte> payload, std::size_t count, F&& f) {
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint32_t n = 0;
+            if (payload.size() - pos < sizeof(n)) return false;
+            std::memcpy(&n, payload.data() + pos, sizeof(n));
+            pos += sizeof(n);
+            if (payload.size() - pos < n) return false;
+            f(std::string_view(reinterpret_cast<const char*>(payload.data() + pos), n));
+            pos += n;
+        }
+        return pos == payload.size();
+    }
+
+    // ---- waveform payloads: (uint64 sample count, samples) per value, each padded to 8 bytes so that the samples
+    // of every value are aligned for their scalar type
+    template<waveform_type W>
+    void append_waveforms(std::vector<std::byte>& out, std::span<const W> values) {
+        const std::size_t start = out.size();
+        for (const auto& w : values) {
+            const auto n = static_cast<std::uint64_t>(w.size());
+            const auto* len = reinterpret_cast<const std::byte*>(&n);
+            out.insert(out.end(), len, len + sizeof(n));
+            const auto* samples = reinterpret_cast<const std::byte*>(w.data());
+            out.insert(out.end(), samples, samples + w.size() * sizeof(typename W::Scalar));
+            out.resize(start + (out.size() - start + 7) / 8 * 8, std::byte{0});
+        }
+    }
+
+    // Calls f(Eigen::Map<const W>) for every value; returns false if the payload is malformed
+    template<waveform_type W, class F>
+    bool for_each_waveform(std::span<const std::byte> payload, std::size_t count, F&& f) {
+        using S = typename W::Scalar;
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint64_t n = 0;
+            if (payload.size() - pos < sizeof(n)) return false;
+            std::memcpy(&n, payload.data() + pos, sizeof(n));
+            pos += sizeof(n);
+            if (n > (payload.size() - pos) / sizeof(S)) return false;
+            const std::size_t bytes = (static_cast<std::size_t>(n) * sizeof(S) + 7) / 8 * 8;
+            if (bytes > payload.size() - pos) return false;
+            f(Eigen::Map<const W>(reinterpret_cast<const S*>(payload.data() + pos), static_cast<Eigen::Index>(n)));
+            pos += bytes;
+        }
+        return pos == payload.size();
+    }
+
+    // value types stored as a sequence of records instead of an array of T
+    template<class T>
+    inline constexpr bool record_payload_v = std::is_same_v<T, std::string> || waveform_type<T>;
+
+    [[nodiscard]] inline bool has_record_payload(std::size_t type_id) {
+        return with_primitive_type(type_id, [](auto t) { return record_payload_v<typename decltype(t)::type>; });
+    }
+
+} // namespace detail
+
+    // ======== SnapshotParameter: a parameter whose values live in a mapped snapshot ========
+    class SnapshotParameter : public IParameter {
+    public:
+        SnapshotParameter(const detail::snapshot_entry& e, std::string_view name, std::size_t type_id,
+                          std::span<const std::byte> payload) noexcept
+            : name_(name), id_{e.id}, type_id_(type_id), count_(e.count), payload_(payload),
+              unit_{e.exponents, e.magnitude}, records_(detail::has_record_payload(type_id)) {}
+
+        std::string_view NameView() const noexcept override { return name_; }
+        ParameterId Id() const noexcept override {
+            ParameterId id;
+            id.value = id_;
+            return id;
+        }
+
+        // no_type_id for std::string and waveform values, which are not stored as objects of their type
+        std::size_t TypeId() const noexcept override { return records_ ? no_type_id : type_id_; }
+        RuntimeUnit GetRuntimeUnit() const noexcept override { return unit_; }
+
+        // The type id stored in the snapshot, also for std::string values
+        [[nodiscard]] std::size_t StoredTypeId() const noexcept { return type_id_; }
+        [[nodiscard]] std::size_t Size() const noexcept { return count_; }
+
+        [[nodiscard]] std::string ValueAsString() const override {
+            fmt::memory_buffer buffer;
+            FormatValueTo(buffer);
+            return fmt::to_string(buffer);
+        }
+
+        void FormatValueTo(fmt::memory_buffer& out) const override {
+            if (type_id_ == primitive_type_id_v<std::string>) {
+                const auto strings = Strings();
+                detail::format_values_to(out, std::span<const std::string_view>(strings));
+            } else {
+                detail::with_primitive_type(type_id_, [&](auto t) {
+                    using T = typename decltype(t)::type;
+                    if constexpr (waveform_type<T>) {
+                        const auto maps = Waveforms<T>();
+                        const std::vector<T> values(maps.begin(), maps.end());
+                        detail::format_values_to(out, std::span<const T>(values));
+                    } else if constexpr (!std::is_same_v<T, std::string>) {
+                        detail::format_values_to(out, UncheckedViewAs<T>());
+                    }
+                });
+            }
+        }
+
+        // The values of a std::string parameter
+        [[nodiscard]] std::vector<std::string_view> Strings() const {
+            std::vector<std::string_view> values;
+            values.reserve(count_);
+            detail::for_each_string(payload_, count_, [&](std::string_view s) { values.push_back(s); });
+            return values;
+        }
+
+        // The values of a waveform parameter as views of the snapshot; throws std::bad_cast if W is not the
+        // stored type
+        template<waveform_type W>
+        [[nodiscard]] std::vector<Eigen::Map<const W>> Waveforms() const {
+            if (type_id_ != primitive_type_id_v<W>) throw std::bad_cast();
+            std::vector<Eigen::Map<const W>> values;
+            values.reserve(count_);
+            detail::for_each_waveform<W>(payload_, count_, [&](const Eigen::Map<const W>& w) { values.push_back(w); });
+            return values;
+        }
+
+    protected:
+        std::span<const std::byte> ValueBytes() const noexcept override { return payload_; }
+
+    private:
+        std::string_view name_;
+        std::uint64_t id_;
+        std::size_t type_id_;
+        std::size_t count_;
+        std::span<const std::byte> payload_;
+        RuntimeUnit unit_;
+        bool records_; // std::string or waveform payload
+    };
+
+    // ---- writing
+    // Write the parameters to a snapshot file. Throws std::invalid_argument for parameters that do not store a
+    // primitive value type or whose ids collide, and std::runtime_error if the file cannot be written.
+    inline void WriteSnapshot(const std::string& path, std::span<const IParameter* const> params) {
+        std::vector<const IParameter*> sorted(params.begin(), params.end());
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const IParameter* a, const IParameter* b) { return a->Id() < b->Id(); });
+
+        std::vector<detail::snapshot_entry> entries(sorted.size());
+        std::string names;
+        std::vector<std::byte> records; // payloads of std::string and waveform parameters
+        std::vector<std::size_t> record_offsets(sorted.size(), 0);
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            const IParameter& p = *sorted[i];
+            if (i > 0 && sorted[i - 1]->Id() == p.Id()) {
+                throw std::invalid_argument("WriteSnapshot: " + std::string(p.NameView()) + " has the same id as " +
+                                            std::string(sorted[i - 1]->NameView()));
+            }
+            const std::size_t type_id = p.TypeId();
+            if (type_id >= primitive_type_count) {
+                throw std::invalid_argument("WriteSnapshot: " + std::string(p.NameView()) +
+                                            " does not store a primitive value type");
+            }
+
+            detail::snapshot_entry& e = entries[i];
+            e = {};
+            e.id = p.Id().value;
+            e.type_tag = detail::snapshot_type_tag(type_id);
+            const RuntimeUnit unit = p.GetRuntimeUnit();
+            e.exponents = unit.exponents;
+            e.magnitude = unit.magnitude;
+            e.name_offset = static_cast<std::uint32_t>(names.size());
+            e.name_size = static_cast<std::uint32_t>(p.NameView().size());
+            names.append(p.NameView());
+            detail::with_primitive_type(type_id, [&](auto t) {
+                using T = typename decltype(t)::type;
+                const auto values = p.UncheckedViewAs<T>();
+                e.count = values.size();
+                if constexpr (detail::record_payload_v<T>) {
+                    record_offsets[i] = records.size();
+                    if constexpr (std::is_same_v<T, std::string>) detail::append_strings(records, values);
+                    else detail::append_waveforms(records, values);
+                    e.size = records.size() - record_offsets[i];
+                } else {
+                    e.size = values.size_bytes();
+                }
+            });
+        }
+
+        detail::snapshot_header header{};
+        std::memcpy(header.magic, "MVPS", 4);
+        header.byte_order = detail::snapshot_byte_order;
+        header.version = detail::snapshot_version;
+        header.entry_size = sizeof(detail::snapshot_entry);
+        header.entry_count = static_cast<std::uint32_t>(entries.size());
+        header.names_offset = sizeof(header) + entries.size() * sizeof(detail::snapshot_entry);
+        header.names_size = names.size();
+        std::size_t offset = detail::align_snapshot(header.names_offset + names.size());
+        for (auto& e : entries) {
+            e.offset = offset;
+            offset = detail::align_snapshot(offset + e.size);
+        }
+        header.file_size = offset;
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("WriteSnapshot: cannot open " + path);
+        const auto write = [&](const void* data, std::size_t n) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(n));
+        };
+        static constexpr char zeros[detail::snapshot_alignment] = {};
+        std::size_t written = 0;
+        const auto pad_to = [&](std::size_t pos) {
+            write(zeros, pos - written);
+            written = pos;
+        };
+
+        write(&header, sizeof(header));
+        write(entries.data(), entries.size() * sizeof(detail::snapshot_entry));
+        write(names.data(), names.size());
+        written = header.names_offset + names.size();
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            const auto& e = entries[i];
+            pad_to(e.offset);
+            if (detail::has_record_payload(sorted[i]->TypeId())) {
+                write(records.data() + record_offsets[i], e.size);
+            } else {
+                detail::with_primitive_type(sorted[i]->TypeId(), [&](auto t) {
+                    using T = typename decltype(t)::type;
+                    const auto bytes = std::as_bytes(sorted[i]->UncheckedViewAs<T>());
+                    write(bytes.data(), bytes.size());
+                });
+            }
+            written += e.size;
+        }
+        pad_to(header.file_size);
+        if (!out) throw std::runtime_error("WriteSnapshot: cannot write " + path);
+    }
+
+    inline void WriteSnapshot(const std::string& path, std::initializer_list<const IParameter*> params) {
+        WriteSnapshot(path, std::span<const IParameter* const>(params.begin(), params.size()));
+    }
+
+    // ======== Snapshot: a memory-mapped snapshot file ========
+    class Snapshot {
+    public:
+        // Map and validate the file; throws std::runtime_error if it is not a valid snapshot
+        explicit Snapshot(const std::string& path) : file_(path) {
+            const auto bytes = file_.Bytes();
+            if (bytes.size() < sizeof(detail::snapshot_header)) fail(path, "too small");
+            detail::snapshot_header header;
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            if (std::memcmp(header.magic, "MVPS", 4) != 0) fail(path, "not a snapshot");
+            if (header.byte_order != detail::snapshot_byte_order) fail(path, "written with another byte order");
+            if (header.version != detail::snapshot_version) fail(path, "unsupported version " + std::to_string(header.version));
+            if (header.entry_size != sizeof(detail::snapshot_entry) || header.file_size != bytes.size() ||
+                header.names_offset != sizeof(header) + std::uint64_t{header.entry_count} * sizeof(detail::snapshot_entry) ||
+                header.names_offset + header.names_size > bytes.size()) {
+                fail(path, "corrupt header");
+            }
+
+            // the mapping is page aligned, so the entry table is suitably aligned
+            entries_ = {reinterpret_cast<const detail::snapshot_entry*>(bytes.data() + sizeof(header)), header.entry_count};
+            const std::string_view names(reinterpret_cast<const char*>(bytes.data() + header.names_offset), header.names_size);
+            params_.reserve(entries_.size());
+            for (const auto& e : entries_) {
+                const std::size_t type_id = detail::snapshot_type_id(e.type_tag);
+                if (type_id == no_type_id) fail(path, "unknown value type");
+                if (e.offset % detail::snapshot_alignment != 0 || e.offset > bytes.size() || e.size > bytes.size() - e.offset ||
+                    std::uint64_t{e.name_offset} + e.name_size > names.size()) {
+                    fail(path, "corrupt entry");
+                }
+                const auto payload = bytes.subspan(e.offset, e.size);
+                const bool sized = detail::with_primitive_type(type_id, [&](auto t) {
+                    using T = typename decltype(t)::type;
+                    if constexpr (std::is_same_v<T, std::string>) return detail::for_each_string(payload, e.count, [](auto) {});
+                    else if constexpr (waveform_type<T>) return detail::for_each_waveform<T>(payload, e.count, [](const auto&) {});
+                    else return e.size == e.count * sizeof(T);
+                });
+                if (!sized) fail(path, "corrupt values");
+                params_.emplace_back(e, names.substr(e.name_offset, e.name_size), type_id, payload);
+            }
+        }
+
+        Snapshot(Snapshot&&) noexcept = default;
+        Snapshot& operator=(Snapshot&&) noexcept = default;
+
+        // ---- access
+        [[nodiscard]] std::size_t Size() const noexcept { return params_.size(); }
+        [[nodiscard]] const SnapshotParameter& operator[](std::size_t i) const noexcept { return params_[i]; }
+
+        // Parameter with the given id, or nullptr (binary search, the entries are sorted by id)
+        [[nodiscard]] const SnapshotParameter* Find(ParameterId id) const noexcept {
+            const auto it = std::lower_bound(entries_.begin(), entries_.end(), id.value,
+                                             [](const detail::snapshot_entry& e, std::uint64_t v) { return e.id < v; });
+            if (it == entries_.end() || it->id != id.value) return nullptr;
+            return &params_[static_cast<std::size_t>(it - entries_.begin())];
+        }
+
+        [[nodiscard]] const SnapshotParameter* Find(std::string_view name) const noexcept { return Find(ParameterId(name)); }
+
+        // Copy the values stored under p.Id() into p. Throws std::out_of_range if the snapshot has no such
+        // parameter and std::invalid_argument if its value type or unit differ.
+        template<class T, auto Unit>
+        void LoadInto(ParameterBase<T, Unit>& p) const {
+            const SnapshotParameter* s = Find(p.Id());
+            if (s == nullptr) throw std::out_of_range("Snapshot: no parameter " + std::string(p.NameView()));
+            if (s->StoredTypeId() != primitive_type_id_v<T>) {
+                throw std::invalid_argument("Snapshot: " + std::string(p.NameView()) + " is stored as " +
+                                            std::string(primitive_type_names[s->StoredTypeId()]));
+            }
+            if (!(s->GetRuntimeUnit() == runtime_unit_of<Unit>)) {
+                throw std::invalid_argument("Snapshot: " + std::string(p.NameView()) + " is stored in " +
+                                            s->GetRuntimeUnit().ToString() + ", expected " +
+                                            runtime_unit_of<Unit>.ToString());
+            }
+            if constexpr (std::is_same_v<T, std::string>) {
+                p.Get().clear();
+                for (std::string_view v : s->Strings()) p.Get().emplace_back(v);
+            } else if constexpr (waveform_type<T>) {
+                p.Get().clear();
+                for (const auto& w : s->template Waveforms<T>()) p.Get().emplace_back(w);
+            } else {
+                const auto values = s->template UncheckedViewAs<T>();
+                p.Get().assign(values.begin(), values.end());
+            }
+            p.NotifyChanged();
+        }
+
+    private:
+        MappedFile file_;
+        std::span<const detail::snapshot_entry> entries_;
+        std::vector<SnapshotParameter> params_;
+
+        [[noreturn]] static void fail(const std::string& path, const std::string& what) {
+            throw std::runtime_error("Snapshot: " + path + ": " + what);
+        }
+    };
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,464 @@
+// soa.h
+// This file defines an opt-in structure-of-arrays (SoA) storage for parameters of the eigen_colvec_tag,
+// eigen_rowvec_tag and eigen_quat_tag categories. ParameterBase stores an array of small fixed-size Eigen
+// objects (AoS: x0 y0 z0 x1 y1 z1 ...), which prevents SIMD across elements. SoaParameter stores one
+// contiguous lane per coefficient (x0 x1 ... | y0 y1 ... | z0 z1 ...), so the element-wise dot_op, cross_op,
+// coefw_mul_op (and quaternion mul_op) kernels below are plain loops over lanes that the compiler
+// vectorizes, processing 2/4/8 elements per instruction depending on the target (SSE2/AVX2/AVX-512).
+// Element access keeps the ParameterBase semantics through proxy references.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+    // ---- lane layout of the SoA-capable categories
+    // lanes: number of coefficients, get/set: coefficient k of a value
+    template<class Tag>
+    struct soa_layout { static constexpr bool enabled = false; };
+
+    template<>
+    struct soa_layout<eigen_colvec_tag> {
+        static constexpr bool enabled = true;
+        static constexpr std::size_t lanes = 3;
+        template<class U> static double get(const U& v, std::size_t k) { return v[k]; }
+        template<class U> static void set(U& v, std::size_t k, double x) { v[k] = x; }
+    };
+
+    template<> struct soa_layout<eigen_rowvec_tag> : soa_layout<eigen_colvec_tag> {};
+
+    // quaternion lanes follow Eigen's coeffs() order: x, y, z, w
+    template<>
+    struct soa_layout<eigen_quat_tag> {
+        static constexpr bool enabled = true;
+        static constexpr std::size_t lanes = 4;
+        template<class U> static double get(const U& q, std::size_t k) { return q.coeffs()[k]; }
+        template<class U> static void set(U& q, std::size_t k, double x) { q.coeffs()[k] = x; }
+    };
+
+    template<class T>
+    concept soa_capable = soa_layout<category_t<T>>::enabled;
+
+    template<soa_capable T>
+    class soa_vector;
+
+    // ---- proxy reference to element i of a soa_vector
+    template<soa_capable T>
+    class soa_reference {
+    public:
+        soa_reference(soa_vector<T>& owner, std::size_t i) noexcept : owner_(owner), i_(i) {}
+
+        operator T() const { return owner_.get(i_); }
+
+        soa_reference& operator=(const T& value) {
+            owner_.set(i_, value);
+            return *this;
+        }
+
+        soa_reference& operator=(const soa_reference& other) { return *this = static_cast<T>(other); }
+
+        friend bool operator==(const soa_reference& lhs, const T& rhs) { return static_cast<T>(lhs) == rhs; }
+
+    private:
+        soa_vector<T>& owner_;
+        std::size_t i_;
+    };
+
+    // ======== soa_vector: one aligned lane per coefficient ========
+    template<soa_capable T>
+    class soa_vector {
+    public:
+        using value_type = T;
+        using layout = soa_layout<category_t<T>>;
+        static constexpr std::size_t lanes = layout::lanes;
+        static constexpr std::size_t alignment = 64; // one cache line, also the widest SIMD register
+
+        soa_vector() = default;
+
+        explicit soa_vector(std::size_t n) { resize(n); }
+
+        soa_vector(std::initializer_list<T> values) { assign(values.begin(), values.end()); }
+
+        template<std::input_iterator It>
+        soa_vector(It first, It last) { assign(first, last); }
+
+        soa_vector(const std::vector<T>& values) { assign(values.begin(), values.end()); }
+
+        soa_vector(const soa_vector& other) : soa_vector() { *this = other; }
+
+        soa_vector(soa_vector&& other) noexcept { swap(other); }
+
+        soa_vector& operator=(const soa_vector& other) {
+            if (this != &other) {
+                resize(0);
+                reserve(other.size_);
+                for (std::size_t k = 0; k < lanes; ++k) std::copy_n(other.lane(k), other.size_, lane(k));
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        soa_vector& operator=(soa_vector&& other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~soa_vector() { release(); }
+
+        void swap(soa_vector& other) noexcept {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        template<std::input_iterator It>
+        void assign(It first, It last) {
+            resize(0);
+            for (; first != last; ++first) push_back(*first);
+        }
+
+        // Lane k holds coefficient k of every element; lanes are capacity() doubles apart
+        [[nodiscard]] double* lane(std::size_t k) noexcept { return data_ + k * capacity_; }
+        [[nodiscard]] const double* lane(std::size_t k) const noexcept { return data_ + k * capacity_; }
+
+        [[nodiscard]] T get(std::size_t i) const {
+            T value;
+            for (std::size_t k = 0; k < lanes; ++k) layout::set(value, k, lane(k)[i]);
+            return value;
+        }
+
+        void set(std::size_t i, const T& value) {
+            for (std::size_t k = 0; k < lanes; ++k) lane(k)[i] = layout::get(value, k);
+        }
+
+        [[nodiscard]] soa_reference<T> operator[](std::size_t i) noexcept { return {*this, i}; }
+        [[nodiscard]] T operator[](std::size_t i) const { return get(i); }
+
+        [[nodiscard]] soa_reference<T> at(std::size_t i) {
+            if (i >= size_) throw std::out_of_range("soa_vector::at: index out of range");
+            return {*this, i};
+        }
+        [[nodiscard]] T at(std::size_t i) const {
+            if (i >= size_) throw std::out_of_range("soa_vector::at: index out of range");
+            return get(i);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+        void reserve(std::size_t n) {
+            if (n <= capacity_) return;
+            // round up to whole cache lines so every lane starts aligned
+            // plus one line of padding, so lanes are not a power of two apart and do not alias in the cache
+            constexpr std::size_t per_line = alignment / sizeof(double);
+            const std::size_t cap = std::max((n + per_line - 1) / per_line * per_line, 2 * capacity_) + per_line;
+            double* p = static_cast<double*>(
+                ::operator new(lanes * cap * sizeof(double), std::align_val_t{alignment}));
+            for (std::size_t k = 0; k < lanes; ++k) std::copy_n(lane(k), size_, p + k * cap);
+            release();
+            data_ = p;
+            capacity_ = cap;
+        }
+
+        // new elements are zero
+        void resize(std::size_t n) {
+            reserve(n);
+            if (n > size_) {
+                for (std::size_t k = 0; k < lanes; ++k) std::fill(lane(k) + size_, lane(k) + n, 0.0);
+            }
+            size_ = n;
+        }
+
+        // resize leaving new elements uninitialized, for kernels that overwrite every lane
+        void resize_for_overwrite(std::size_t n) {
+            reserve(n);
+            size_ = n;
+        }
+
+        void clear() noexcept { size_ = 0; }
+
+        void push_back(const T& value) {
+            if (size_ == capacity_) reserve(size_ + 1);
+            set(size_++, value);
+        }
+
+        [[nodiscard]] std::vector<T> to_vector() const {
+            std::vector<T> values;
+            values.reserve(size_);
+            for (std::size_t i = 0; i < size_; ++i) values.push_back(get(i));
+            return values;
+        }
+
+        friend bool operator==(const soa_vector& lhs, const soa_vector& rhs) {
+            if (lhs.size_ != rhs.size_) return false;
+            for (std::size_t k = 0; k < lanes; ++k) {
+                if (!std::equal(lhs.lane(k), lhs.lane(k) + lhs.size_, rhs.lane(k))) return false;
+            }
+            return true;
+        }
+
+    private:
+        double* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+
+        void release() noexcept {
+            if (data_) ::operator delete(data_, std::align_val_t{alignment});
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+    };
+
+    // ======== SoaParameter: ParameterBase with SoA storage ========
+    template<soa_capable T, mp_units::Reference auto Unit = mp_units::one>
+    class SoaParameter : public IParameter {
+    protected:
+        soa_vector<T> value_;
+        static constexpr auto unit_ = Unit;
+
+    public:
+        using value_type = T;
+        using storage_type = soa_vector<T>;
+
+        // Constructors
+        SoaParameter() = default;
+
+        SoaParameter(const T& value) { value_.push_back(value); }
+
+        SoaParameter(const std::vector<T>& values) : value_(values) {}
+
+        SoaParameter(std::initializer_list<T> values) : value_(values) {}
+
+        // Conversion from/to the AoS ParameterBase
+        explicit SoaParameter(const ParameterBase<T, Unit>& other) : value_(other.View().begin(), other.View().end()) {}
+
+        [[nodiscard]] ParameterBase<T, Unit> ToParameterBase() const { return ParameterBase<T, Unit>(Vals()); }
+
+        // Conversion to T
+        [[nodiscard]] T Val() const { return value_.empty() ? T{} : value_.get(0); }
+
+        // Conversion to vector
+        [[nodiscard]] std::vector<T> Vals() const { return value_.to_vector(); }
+
+        template<auto Unit2>
+        bool operator==(const SoaParameter<T, Unit2>& other) const {
+            if constexpr (Unit == Unit2) return value_ == other.Get();
+            else return false;
+        }
+
+        // Access operator, through proxy references on the non-const path
+        decltype(auto) operator[](size_t i) { return value_.at(i); }
+        decltype(auto) operator[](size_t i) const { return value_.at(i); }
+
+        std::string_view NameView() const noexcept override { return "SoaParameter"; }
+
+        [[nodiscard]] std::string ValueAsString() const override {
+            fmt::memory_buffer buffer;
+            FormatValueTo(buffer);
+            return fmt::to_string(buffer);
+        }
+
+        void FormatValueTo(fmt::memory_buffer& out) const override {
+            detail::format_values<T>(fmt::appender(out), value_.size(), [&](fmt::appender o, std::size_t i) {
+                return fmt::format_to(o, "{}", value_.get(i));
+            });
+        }
+
+        // The lanes are not an array of T, so TypeId() stays no_type_id; convert with ToParameterBase()
+        // for type-erased arithmetic
+        RuntimeUnit GetRuntimeUnit() const noexcept override { return runtime_unit_of<Unit>; }
+
+        // Getter/setter
+        [[nodiscard]] storage_type& Get() noexcept { return value_; }
+        [[nodiscard]] const storage_type& Get() const noexcept { return value_; }
+        void Set(const T& v) {
+            if (value_.empty()) value_.resize(1);
+            value_.set(0, v);
+            NotifyChanged();
+        }
+        void Set(const std::vector<T>& values) {
+            value_ = storage_type(values);
+            NotifyChanged();
+        }
+        void Set(std::initializer_list<T> values) {
+            value_ = storage_type(values);
+            NotifyChanged();
+        }
+        // Report a change made through Get() or operator[] to the change subscribers, see change_log.h
+        void NotifyChanged() const {
+            if (detail::change_notifications_active()) [[unlikely]] detail::record_change(Id(), this);
+        }
+        static constexpr auto GetUnit() noexcept { return unit_; }
+        std::size_t Size() const noexcept { return value_.size(); }
+    };
+
+namespace detail {
+
+    // ---- broadcasting dispatch of the SoA kernels
+    // Calls f.template operator()<BroadcastA, BroadcastB>(); a broadcast operand is read at index 0. The loops
+    // themselves live in functions taking __restrict lane pointers, so the compiler can vectorize them
+    // without runtime alias checks.
+    template<class F>
+    void soa_dispatch(std::size_t na, std::size_t nb, F&& f) {
+        if (na == nb) f.template operator()<false, false>();
+        else if (na == 1) f.template operator()<true, false>();
+        else f.template operator()<false, true>();
+    }
+
+} // namespace detail
+
+    // ---- SoA kernels, one per (category, op) pair enabled in op_policy
+    // run(a, b, out, n) combines the lanes of a and b into the lanes of out (a plain double array for dot_op).
+    // Broadcasting follows ParameterBase: equal sizes, or one operand of size 1.
+    template<class Tag, class Op>
+    struct soa_kernel { static constexpr bool enabled = false; };
+
+    template<class Tag>
+    requires (std::is_base_of_v<eigen_vec_tag, Tag>)
+    struct soa_kernel<Tag, dot_op> {
+        static constexpr bool enabled = true;
+
+        template<bool BA, bool BB>
+        static void loop(std::size_t n,
+                         const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                         const double* __restrict bx, const double* __restrict by, const double* __restrict bz,
+                         double* __restrict out) {
+            for (std::size_t o = 0; o < n; ++o) {
+                const std::size_t i = BA ? 0 : o, j = BB ? 0 : o;
+                out[o] = ax[i] * bx[j] + ay[i] * by[j] + az[i] * bz[j];
+            }
+        }
+
+        template<class T>
+        static void run(const soa_vector<T>& a, const soa_vector<T>& b, double* out, std::size_t n) {
+            detail::soa_dispatch(a.size(), b.size(), [&]<bool BA, bool BB>() {
+                loop<BA, BB>(n, a.lane(0), a.lane(1), a.lane(2), b.lane(0), b.lane(1), b.lane(2), out);
+            });
+        }
+    };
+
+    template<class Tag>
+    requires (std::is_base_of_v<eigen_vec_tag, Tag>)
+    struct soa_kernel<Tag, cross_op> {
+        static constexpr bool enabled = true;
+
+        template<bool BA, bool BB>
+        static void loop(std::size_t n,
+                         const double* __restrict ax, const double* __restrict ay, const double* __restrict az,
+                         const double* __restrict bx, const double* __restrict by, const double* __restrict bz,
+                         double* __restrict ox, double* __restrict oy, double* __restrict oz) {
+            for (std::size_t o = 0; o < n; ++o) {
+                const std::size_t i = BA ? 0 : o, j = BB ? 0 : o;
+                ox[o] = ay[i] * bz[j] - az[i] * by[j];
+                oy[o] = az[i] * bx[j] - ax[i] * bz[j];
+                oz[o] = ax[i] * by[j] - ay[i] * bx[j];
+            }
+        }
+
+        template<class T>
+        static void run(const soa_vector<T>& a, const soa_vector<T>& b, soa_vector<T>& out, std::size_t n) {
+            detail::soa_dispatch(a.size(), b.size(), [&]<bool BA, bool BB>() {
+                loop<BA, BB>(n, a.lane(0), a.lane(1), a.lane(2), b.lane(0), b.lane(1), b.lane(2),
+                             out.lane(0), out.lane(1), out.lane(2));
+            });
+        }
+    };
+
+    template<class Tag>
+    requires (std::is_base_of_v<eigen_vec_tag, Tag>)
+    struct soa_kernel<Tag, coefw_mul_op> {
+        static constexpr bool enabled = true;
+
+        template<bool BA, bool BB>
+        static void loop(std::size_t n, const double* __restrict a, const double* __restrict b, double* __restrict out) {
+            for (std::size_t o = 0; o < n; ++o) out[o] = a[BA ? 0 : o] * b[BB ? 0 : o];
+        }
+
+        template<class T>
+        static void run(const soa_vector<T>& a, const soa_vector<T>& b, soa_vector<T>& out, std::size_t n) {
+            detail::soa_dispatch(a.size(), b.size(), [&]<bool BA, bool BB>() {
+                for (std::size_t k = 0; k < soa_vector<T>::lanes; ++k) loop<BA, BB>(n, a.lane(k), b.lane(k), out.lane(k));
+            });
+        }
+    };
+
+    // Hamilton product, lanes in x, y, z, w order
+    template<>
+    struct soa_kernel<eigen_quat_tag, mul_op> {
+        static constexpr bool enabled = true;
+
+        template<bool BA, bool BB>
+        static void loop(std::size_t n,
+                         const double* __restrict ax, const double* __restrict ay,
+                         const double* __restrict az, const double* __restrict aw,
+                         const double* __restrict bx, const double* __restrict by,
+                         const double* __restrict bz, const double* __restrict bw,
+                         double* __restrict ox, double* __restrict oy, double* __restrict oz, double* __restrict ow) {
+            for (std::size_t o = 0; o < n; ++o) {
+                const std::size_t i = BA ? 0 : o, j = BB ? 0 : o;
+                ow[o] = aw[i] * bw[j] - ax[i] * bx[j] - ay[i] * by[j] - az[i] * bz[j];
+                ox[o] = aw[i] * bx[j] + ax[i] * bw[j] + ay[i] * bz[j] - az[i] * by[j];
+                oy[o] = aw[i] * by[j] + ay[i] * bw[j] + az[i] * bx[j] - ax[i] * bz[j];
+                oz[o] = aw[i] * bz[j] + az[i] * bw[j] + ax[i] * by[j] - ay[i] * bx[j];
+            }
+        }
+
+        template<class T>
+        static void run(const soa_vector<T>& a, const soa_vector<T>& b, soa_vector<T>& out, std::size_t n) {
+            detail::soa_dispatch(a.size(), b.size(), [&]<bool BA, bool BB>() {
+                loop<BA, BB>(n, a.lane(0), a.lane(1), a.lane(2), a.lane(3), b.lane(0), b.lane(1), b.lane(2), b.lane(3),
+                             out.lane(0), out.lane(1), out.lane(2), out.lane(3));
+            });
+        }
+    };
+
+    // ---- element-wise operation on two SoA parameters
+    // The value type and unit of the result come from the same op_policy as ParameterBase; dot_op yields a
+    // ParameterBase<double>, the other ops yield an SoaParameter of the operand type.
+    template<class Op, class T, auto Unit1, auto Unit2>
+    requires (soa_kernel<category_t<T>, Op>::enabled &&
+              op_allowed<op_policy<category_t<T>, category_t<T>, Op>, T, T>)
+    auto SoaApply(const SoaParameter<T, Unit1>& lhs, const SoaParameter<T, Unit2>& rhs) {
+        using policy = op_policy<category_t<T>, category_t<T>, Op>;
+        using kernel = soa_kernel<category_t<T>, Op>;
+        using T3 = op_return_t<policy, T, T>;
+        constexpr auto Unit3 = policy::template unit_of<Unit1, Unit2>();
+
+        static_assert(std::is_same_v<T3, double> || std::is_same_v<T3, T>, "SoA kernels keep the operand type");
+        // one named result for both branches, so that it is constructed in place (NRVO) and not moved out
+        using result_type = std::conditional_t<std::is_same_v<T3, double>, ParameterBase<double, Unit3>,
+                                               SoaParameter<T, Unit3>>;
+
+        const std::size_t n = detail::broadcast_size(lhs.Size(), rhs.Size());
+        result_type result;
+        result.Get().resize_for_overwrite(n);
+        if constexpr (std::is_same_v<T3, double>) kernel::run(lhs.Get(), rhs.Get(), result.Get().data(), n);
+        else kernel::run(lhs.Get(), rhs.Get(), result.Get(), n);
+        return result;
+    }
+
+    template<class T, auto Unit1, auto Unit2>
+    auto Dot(const SoaParameter<T, Unit1>& lhs, const SoaParameter<T, Unit2>& rhs) { return SoaApply<dot_op>(lhs, rhs); }
+
+    template<class T, auto Unit1, auto Unit2>
+    auto Cross(const SoaParameter<T, Unit1>& lhs, const SoaParameter<T, Unit2>& rhs) { return SoaApply<cross_op>(lhs, rhs); }
+
+    template<class T, auto Unit1, auto Unit2>
+    auto CoefwMul(const SoaParameter<T, Unit1>& lhs, const SoaParameter<T, Unit2>& rhs) { return SoaApply<coefw_mul_op>(lhs, rhs); }
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,161 @@
+// static_parameter.h
+// This file defines StaticParameter<T, N, Unit>, a parameter with a fixed number of values stored in a
+// std::array, for sequence constants that are known at compile time (gyromagnetic ratio, raster times,
+// hardware limits). ParameterBase owns heap-capable storage and is polymorphic, so it cannot be a constant
+// expression; StaticParameter is a literal type and every operation on it is constexpr:
+//     inline constexpr StaticParameter<double, 1, si::second> grad_raster(10e-6);
+//     inline constexpr StaticParameter<int, 1> ramp_samples(12);
+//     inline constexpr auto ramp_time = grad_raster * ramp_samples;  // folded at compile time, unit s
+// The operators use the same op_policy and unit algebra as ParameterBase: value types, result types and
+// units are checked by the policy of the value categories, and the number of values follows the broadcasting
+// rules of the element-wise operators, checked at compile time. The scalar and bool policies are constexpr;
+// the Eigen ones are not, so StaticParameter of Eigen types works at run time only.
+// ToParameterBase() copies the values into a ParameterBase for the rest of the library.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+namespace detail {
+
+    // ---- broadcasting rules of the element-wise operators on the number of values, 0 if they do not broadcast
+    consteval std::size_t static_broadcast_size(std::size_t n1, std::size_t n2) {
+        if (n1 == n2 || n2 == 1) return n1;
+        if (n1 == 1) return n2;
+        return 0;
+    }
+
+} // namespace detail
+
+    // ======== StaticParameter: N values of T in a std::array, usable in constant expressions ========
+    template<class T, std::size_t N, mp_units::Reference auto Unit = mp_units::one>
+    class StaticParameter {
+        static_assert(N >= 1, "StaticParameter requires at least one value");
+
+    public:
+        using value_type = T;
+        using storage_type = std::array<T, N>;
+
+        constexpr StaticParameter() = default;
+
+        // One value per argument, e.g. StaticParameter<double, 3, si::metre>(0.0, 0.1, 0.2)
+        template<class... Ts>
+        requires (sizeof...(Ts) == N && (std::is_convertible_v<Ts, T> && ...))
+        explicit constexpr StaticParameter(Ts... values) : value_{static_cast<T>(values)...} {}
+
+        explicit constexpr StaticParameter(const storage_type& values) : value_(values) {}
+
+        // ---- same accessors as ParameterBase
+        [[nodiscard]] static constexpr auto GetUnit() noexcept { return Unit; }
+        [[nodiscard]] static constexpr std::size_t Size() noexcept { return N; }
+        [[nodiscard]] constexpr const T& Val() const noexcept { return value_[0]; }
+        [[nodiscard]] constexpr const storage_type& Get() const noexcept { return value_; }
+        [[nodiscard]] constexpr std::span<const T, N> View() const noexcept { return value_; }
+
+        // throws std::out_of_range if i >= N (a compile error in a constant expression)
+        [[nodiscard]] constexpr const T& operator[](std::size_t i) const {
+            if (i >= N) throw std::out_of_range("StaticParameter: index " + std::to_string(i) + " out of range");
+            return value_[i];
+        }
+
+        // The values in a unit of the same dimension, e.g. raster.In<si::micro<si::second>>()
+        template<mp_units::Reference auto Unit2>
+        requires (std::is_floating_point_v<T> && runtime_unit_of<Unit>.SameDimension(runtime_unit_of<Unit2>))
+        [[nodiscard]] constexpr StaticParameter<T, N, Unit2> In() const {
+            constexpr T factor = static_cast<T>(runtime_unit_of<Unit>.magnitude / runtime_unit_of<Unit2>.magnitude);
+            std::array<T, N> values{};
+            for (std::size_t i = 0; i < N; ++i) values[i] = value_[i] * factor;
+            return StaticParameter<T, N, Unit2>(values);
+        }
+
+        // A copy of the values as a ParameterBase, e.g. to initialize a Parameter or pass it to DynamicApply
+        [[nodiscard]] ParameterBase<T, Unit> ToParameterBase() const {
+            return ParameterBase<T, Unit>(std::vector<T>(value_.begin(), value_.end()));
+        }
+
+        [[nodiscard]] std::string ValueAsString() const { return detail::values_to_string(std::span<const T>(value_)); }
+
+        template<class T2, std::size_t N2, auto Unit2>
+        [[nodiscard]] constexpr bool operator==(const StaticParameter<T2, N2, Unit2>& other) const {
+            if constexpr (N == N2 && Unit == Unit2 && std::is_same_v<T, T2>) return value_ == other.Get();
+            else return false;
+        }
+
+    private:
+        storage_type value_{};
+    };
+
+    template<class Op, class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    concept static_op_allowed =
+        op_allowed<op_policy<category_t<T1>, category_t<T2>, Op>, T1, T2> &&
+        detail::unit_rule_allowed<op_policy<category_t<T1>, category_t<T2>, Op>, Unit1, Unit2> &&
+        detail::static_broadcast_size(N1, N2) != 0;
+
+    // ---- lhs Op rhs, element-wise with broadcasting
+    template<class Op, class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    requires static_op_allowed<Op, T1, N1, Unit1, T2, N2, Unit2>
+    [[nodiscard]] constexpr auto StaticApply(const StaticParameter<T1, N1, Unit1>& lhs, const StaticParameter<T2, N2, Unit2>& rhs) {
+        using policy = op_policy<category_t<T1>, category_t<T2>, Op>;
+        using T3 = op_return_t<policy, T1, T2>;
+        constexpr std::size_t N3 = detail::static_broadcast_size(N1, N2);
+        constexpr auto Unit3 = detail::applied_unit_of<policy, Unit1, Unit2>();
+
+        std::array<T3, N3> values{};
+        for (std::size_t i = 0; i < N3; ++i) {
+            values[i] = policy::template impl<T1, T2>(lhs.Get()[N1 == 1 ? 0 : i], rhs.Get()[N2 == 1 ? 0 : i]);
+        }
+        return StaticParameter<T3, N3, Unit3>(values);
+    }
+
+    // ---- Op operand for the unary policies (not_op, transpose_op, inverse_op)
+    template<class Op, class T1, std::size_t N1, auto Unit1>
+    requires (op_policy<category_t<T1>, void, Op>::enabled &&
+              requires(const T1& v) { op_policy<category_t<T1>, void, Op>::template impl<T1>(v); })
+    [[nodiscard]] constexpr auto StaticApply(const StaticParameter<T1, N1, Unit1>& operand) {
+        using policy = op_policy<category_t<T1>, void, Op>;
+        using T3 = decltype(policy::template impl<T1>(std::declval<const T1&>()));
+        constexpr auto Unit3 = detail::applied_unit_of<policy, Unit1>();
+
+        std::array<T3, N1> values{};
+        for (std::size_t i = 0; i < N1; ++i) values[i] = policy::template impl<T1>(operand.Get()[i]);
+        return StaticParameter<T3, N1, Unit3>(values);
+    }
+
+    // ---- arithmetic operators
+    template<class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    requires static_op_allowed<add_op, T1, N1, Unit1, T2, N2, Unit2>
+    [[nodiscard]] constexpr auto operator+(const StaticParameter<T1, N1, Unit1>& lhs, const StaticParameter<T2, N2, Unit2>& rhs) {
+        return StaticApply<add_op>(lhs, rhs);
+    }
+
+    template<class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    requires static_op_allowed<sub_op, T1, N1, Unit1, T2, N2, Unit2>
+    [[nodiscard]] constexpr auto operator-(const StaticParameter<T1, N1, Unit1>& lhs, const StaticParameter<T2, N2, Unit2>& rhs) {
+        return StaticApply<sub_op>(lhs, rhs);
+    }
+
+    template<class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    requires static_op_allowed<mul_op, T1, N1, Unit1, T2, N2, Unit2>
+    [[nodiscard]] constexpr auto operator*(const StaticParameter<T1, N1, Unit1>& lhs, const StaticParameter<T2, N2, Unit2>& rhs) {
+        return StaticApply<mul_op>(lhs, rhs);
+    }
+
+    template<class T1, std::size_t N1, auto Unit1, class T2, std::size_t N2, auto Unit2>
+    requires static_op_allowed<div_op, T1, N1, Unit1, T2, N2, Unit2>
+    [[nodiscard]] constexpr auto operator/(const StaticParameter<T1, N1, Unit1>& lhs, const StaticParameter<T2, N2, Unit2>& rhs) {
+        return StaticApply<div_op>(lhs, rhs);
+    }
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,254 @@
+// sweep.h
+// This file defines Sweep, the parallel evaluation of a function over the cartesian product of parameter
+// values, e.g. every combination of the values of TE x TR x flip angle x matrix size.
+// Each axis is a parameter holding several values. The grid is never materialized: point i is decoded from
+// its index in mixed radix (the last axis varies fastest), and consecutive points are reached by incrementing
+// the index digits like an odometer, so a worker only rewrites the axes that changed.
+// Points are evaluated on a work-stealing pool: every worker owns a range of point indices, takes chunks of
+// `grain` points from its front and, when it runs out, steals the back half of the range of another worker.
+// Results are streamed to a sink in chunks; the sink is never called concurrently, but chunks arrive in no
+// particular order.
+//     Sweep sweep(te_values, tr_values, fa_values);
+//     sweep.Run([](const EchoTime& te, const RepetitionTime& tr, const FlipAngle& fa) { return Check(te, tr, fa); },
+//               [&](std::size_t index, const CheckResult& r) { ... });
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "parameter.h"
+
+namespace methodverse::parameter {
+
+    struct SweepOptions {
+        std::size_t threads = 0; // 0: std::thread::hardware_concurrency()
+        std::size_t grain = 64;  // points taken from a range at a time
+
+        [[nodiscard]] std::size_t ThreadCount() const noexcept {
+            return threads != 0 ? threads : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        }
+    };
+
+namespace detail {
+
+    // ---- range of indices owned by one worker, shrunk from the front by the owner and from the back by thieves
+    class alignas(64) work_range {
+    public:
+        void assign(std::size_t begin, std::size_t end) {
+            std::lock_guard lock(mutex_);
+            begin_ = begin;
+            end_ = end;
+        }
+
+        bool pop_front(std::size_t grain, std::size_t& begin, std::size_t& end) {
+            std::lock_guard lock(mutex_);
+            if (begin_ == end_) return false;
+            begin = begin_;
+            end = begin_ + std::min(grain, end_ - begin_);
+            begin_ = end;
+            return true;
+        }
+
+        bool steal_back_half(std::size_t& begin, std::size_t& end) {
+            std::lock_guard lock(mutex_);
+            if (begin_ == end_) return false;
+            const std::size_t mid = begin_ + (end_ - begin_) / 2;
+            begin = mid;
+            end = end_;
+            end_ = mid;
+            return true;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::size_t begin_ = 0;
+        std::size_t end_ = 0;
+    };
+
+    // ---- run body(worker, begin, end) over [0, n) in chunks of at most grain indices on a work-stealing pool
+    // of at most options.ThreadCount() workers. The calling thread is worker 0. The first exception thrown by
+    // body stops the workers and is rethrown.
+    template<class Body>
+    void parallel_ranges(std::size_t n, const SweepOptions& options, Body&& body) {
+        if (n == 0) return;
+        const std::size_t grain = std::max<std::size_t>(1, options.grain);
+        std::size_t threads = options.ThreadCount();
+        threads = std::min(threads, (n + grain - 1) / grain);
+
+        std::vector<work_range> ranges(threads);
+        for (std::size_t w = 0; w < threads; ++w) ranges[w].assign(n * w / threads, n * (w + 1) / threads);
+
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto worker = [&](std::size_t w) {
+            try {
+                std::size_t begin = 0;
+                std::size_t end = 0;
+                while (!failed.load(std::memory_order_relaxed)) {
+                    if (ranges[w].pop_front(grain, begin, end)) {
+                        body(w, begin, end);
+                        continue;
+                    }
+                    bool stolen = false;
+                    for (std::size_t k = 1; k < threads && !stolen; ++k) {
+                        stolen = ranges[(w + k) % threads].steal_back_half(begin, end);
+                    }
+                    if (!stolen) return; // every range is empty, the rest is in flight on other workers
+                    ranges[w].assign(begin, end);
+                }
+            } catch (...) {
+                std::lock_guard lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed.store(true);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (std::size_t w = 1; w < threads; ++w) pool.emplace_back(worker, w);
+        worker(0);
+        for (auto& t : pool) t.join();
+        if (error) std::rethrow_exception(error);
+    }
+
+} // namespace detail
+
+    // ======== Sweep ========
+    template<class... P>
+        requires (sizeof...(P) > 0 && (parameter_like<P> && ...))
+    class Sweep {
+    public:
+        static constexpr std::size_t axis_count = sizeof...(P);
+        using point_type = std::tuple<P...>;
+
+        // The values of each axis are copied; an axis without values gives an empty sweep.
+        explicit Sweep(const P&... axes) : axes_(axes...) {
+            std::size_t i = 0;
+            ((radix_[i++] = axes.Size()), ...);
+            size_ = 1;
+            for (std::size_t r : radix_) {
+                if (r != 0 && size_ > std::numeric_limits<std::size_t>::max() / r) {
+                    throw std::invalid_argument("Sweep: number of points overflows std::size_t");
+                }
+                size_ *= r;
+            }
+        }
+
+        [[nodiscard]] std::size_t Size() const noexcept { return size_; }
+        [[nodiscard]] const std::array<std::size_t, axis_count>& Shape() const noexcept { return radix_; }
+
+        // Value index on every axis of point i, the last axis varying fastest
+        [[nodiscard]] std::array<std::size_t, axis_count> Indices(std::size_t i) const {
+            if (i >= size_) throw std::out_of_range("Sweep: point index out of range");
+            std::array<std::size_t, axis_count> digits{};
+            for (std::size_t a = axis_count; a-- > 0;) {
+                digits[a] = i % radix_[a];
+                i /= radix_[a];
+            }
+            return digits;
+        }
+
+        // Point i as single-valued parameters
+        [[nodiscard]] point_type Point(std::size_t i) const {
+            const auto digits = Indices(i);
+            return make_point(digits, std::index_sequence_for<P...>{});
+        }
+
+        // Call f(const P&...) on every point in index order, on the calling thread
+        template<class F>
+        void ForEach(F&& f) const {
+            if (size_ == 0) return;
+            cursor c(*this, 0);
+            for (std::size_t i = 0; i < size_; ++i, c.next()) std::apply(f, std::as_const(c.point));
+        }
+
+        // Evaluate every point in parallel, discarding the results (evaluate may collect them itself, it is
+        // called concurrently)
+        template<class F>
+        void Run(F&& evaluate, SweepOptions options = {}) const {
+            detail::parallel_ranges(size_, options,
+                                    [&](std::size_t, std::size_t begin, std::size_t end) {
+                                        cursor c(*this, begin);
+                                        for (std::size_t i = begin; i < end; ++i, c.next()) {
+                                            std::apply(evaluate, std::as_const(c.point));
+                                        }
+                                    });
+        }
+
+        // Evaluate every point in parallel and stream sink(index, result) per chunk of points. Only one
+        // chunk is buffered per worker, so memory does not grow with the number of points.
+        template<class F, class Sink>
+        void Run(F&& evaluate, Sink&& sink, SweepOptions options = {}) const {
+            using result_type = std::decay_t<std::invoke_result_t<F&, const P&...>>;
+            std::vector<std::vector<result_type>> buffers(options.ThreadCount());
+            std::mutex sink_mutex;
+            detail::parallel_ranges(size_, options,
+                                    [&](std::size_t worker, std::size_t begin, std::size_t end) {
+                                        auto& results = buffers[worker];
+                                        results.clear();
+                                        cursor c(*this, begin);
+                                        for (std::size_t i = begin; i < end; ++i, c.next()) {
+                                            results.push_back(std::apply(evaluate, std::as_const(c.point)));
+                                        }
+                                        std::lock_guard lock(sink_mutex);
+                                        for (std::size_t i = begin; i < end; ++i) {
+                                            sink(i, std::as_const(results[i - begin]));
+                                        }
+                                    });
+        }
+
+    private:
+        std::tuple<P...> axes_;
+        std::array<std::size_t, axis_count> radix_{};
+        std::size_t size_ = 0;
+
+        template<std::size_t... I>
+        point_type make_point(const std::array<std::size_t, axis_count>& digits, std::index_sequence<I...>) const {
+            return point_type(P(std::get<I>(axes_).Unchecked(digits[I]))...);
+        }
+
+        // Current point of a worker, advanced by incrementing the digits. Values are written through
+        // Unchecked(), so sweeping does not send change notifications.
+        struct cursor {
+            const Sweep& sweep;
+            std::array<std::size_t, axis_count> digits;
+            point_type point;
+
+            cursor(const Sweep& s, std::size_t i)
+                : sweep(s), digits(s.Indices(i)), point(s.make_point(digits, std::index_sequence_for<P...>{})) {}
+
+            void next() { advance(std::integral_constant<std::size_t, axis_count - 1>{}); }
+
+            template<std::size_t A>
+            void advance(std::integral_constant<std::size_t, A>) {
+                std::size_t& d = digits[A];
+                const bool carry = ++d == sweep.radix_[A];
+                if (carry) d = 0;
+                std::get<A>(point).Unchecked(0) = std::get<A>(sweep.axes_).Unchecked(d);
+                if constexpr (A > 0) {
+                    if (carry) advance(std::integral_constant<std::size_t, A - 1>{});
+                }
+            }
+        };
+    };
+
+    template<class... P>
+    Sweep(const P&...) -> Sweep<P...>;
+
+}; // namespace methodverse::parameter
@@ -8,10 +8,14 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <utility> 
 #include <cmath>
-#include <Eigen/Dense>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
 #include <boost/mp11/list.hpp>
 #include <boost/mp11/algorithm.hpp>
 #include <type_traits>
@@ -39,16 +43,21 @@ namespace methodverse::parameter {
 
     template<class T> inline constexpr bool always_false = false;
 
+    class BitMask; // bit_mask.h
+
     // ---- Define category tags for different primitive types. purpose is to organize some types into one category
     struct scalar_tag { using types = boost::mp11::mp_list<int, double>;}; // scalar types include everthing that is convertable to double
     struct string_tag { using types = boost::mp11::mp_list<std::string>;};
     struct bool_tag { using types = boost::mp11::mp_list<bool>;};
+    struct bitmask_tag { using types = boost::mp11::mp_list<BitMask>;}; // packed boolean masks, not a primitive type
     struct eigen_vecmat_tag {};
     struct eigen_vec_tag : public eigen_vecmat_tag{};
     struct eigen_quat_tag { using types = boost::mp11::mp_list<Eigen::Quaterniond>;};
     struct eigen_colvec_tag : public eigen_vec_tag { using types = boost::mp11::mp_list<Eigen::Vector3d>;};    // all column vectors
     struct eigen_rowvec_tag : public eigen_vec_tag { using types = boost::mp11::mp_list<Eigen::RowVector3d>;}; // all row vectors
     struct eigen_mat_tag { using types = boost::mp11::mp_list<Eigen::Matrix3d>;};       // all matrices
+    // dynamic-size sample vectors (gradient and RF waveforms), not an eigen_vecmat_tag: see waveform.h
+    struct eigen_waveform_tag { using types = boost::mp11::mp_list<Eigen::VectorXd, Eigen::ArrayXd, Eigen::VectorXf, Eigen::ArrayXf>;};
 
     template<class T, class Tag> 
     concept is_category_of = boost::mp11::mp_contains<typename Tag::types, T>::value;
@@ -63,7 +72,9 @@ namespace methodverse::parameter {
             std::conditional_t<is_category_of<T, eigen_colvec_tag>,eigen_colvec_tag,
             std::conditional_t<is_category_of<T, eigen_rowvec_tag>,eigen_rowvec_tag,
             std::conditional_t<is_category_of<T, eigen_mat_tag>,   eigen_mat_tag,
-            void>>>>>>>;
+            std::conditional_t<is_category_of<T, bitmask_tag>,     bitmask_tag,
+            std::conditional_t<is_category_of<T, eigen_waveform_tag>, eigen_waveform_tag,
+            void>>>>>>>>>;
         static_assert(!std::is_same_v<type, void>, "Type not in any category");
     };
 
@@ -78,11 +89,28 @@ namespace methodverse::parameter {
         Eigen::Vector3d, 
         Eigen::RowVector3d, 
         Eigen::Matrix3d, 
-        Eigen::Quaterniond>;
+        Eigen::Quaterniond,
+        Eigen::VectorXd,
+        Eigen::ArrayXd,
+        Eigen::VectorXf,
+        Eigen::ArrayXf>;
 
     template <class T>
     concept is_allowed_primitive = boost::mp11::mp_contains<primitive_types, T>::value;
 
+    // ---- run-time ids of the primitive types: the index in primitive_types, used by type-erased code
+    inline constexpr std::size_t primitive_type_count = boost::mp11::mp_size<primitive_types>::value;
+    inline constexpr std::size_t no_type_id = static_cast<std::size_t>(-1);
+
+    template <class T>
+    inline constexpr std::size_t primitive_type_id_v =
+        is_allowed_primitive<T> ? boost::mp11::mp_find<primitive_types, T>::value : no_type_id;
+
+    // names of primitive_types for messages and file formats, in the order of primitive_types
+    inline constexpr std::array<std::string_view, primitive_type_count> primitive_type_names{
+        "bool", "string", "int", "double", "Vector3d", "RowVector3d", "Matrix3d", "Quaterniond",
+        "VectorXd", "ArrayXd", "VectorXf", "ArrayXf"};
+
     // ---- op policy
     // primary template, not defined
     template<class C1, class C2, class Op>
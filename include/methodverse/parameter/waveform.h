@@ -0,0 +1,96 @@
+// waveform.h
+// This file defines the helpers of the eigen_waveform_tag category: Eigen::VectorXd, ArrayXd, VectorXf and ArrayXf
+// values that each hold a whole sampled waveform (a gradient or RF shape on the raster time grid), with the unit
+// of the samples checked at compile time like any other parameter:
+//     struct ReadoutShape : Parameter<Eigen::VectorXd, ReadoutShape, si::milli<si::tesla> / si::metre> { ... };
+//     ParameterBase<Eigen::VectorXd, si::milli<si::tesla> / si::metre * si::second> moment = shape * raster;
+//     auto rf = (b1_shape + b1_offset) * amplitude;   // unit checked, one pass over the samples
+// The samples are allocated by Eigen's aligned allocator (EIGEN_MAX_ALIGN_BYTES), so Eigen's packet loops run on
+// them without alignment peeling; the parameter itself stores the small VectorXd headers contiguously.
+// The op policies (+, -, *, /, .*, ./) are defined in operation_policy.h. A waveform combines sample by sample with
+// a waveform of the same type and length, or with a scalar that is cast to the sample type and broadcast over the
+// samples; * and / are coefficient-wise like .* and ./. Waveforms of different lengths are rejected with
+// std::invalid_argument. Next to impl(), each waveform policy has a lazy() that returns an Eigen expression; the
+// fused evaluator of ParameterExpr (expression.h) nests these, so every sample of the result is written once, by a
+// single vectorized Eigen loop, with no temporary waveform per operator.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <Eigen/Core>
+#include "tags.h"
+
+namespace methodverse::parameter {
+
+    template<class T>
+    concept waveform_type = is_category_of<T, eigen_waveform_tag>;
+
+namespace detail {
+
+    // ---- operands of the waveform policies
+    // The waveform type of the result: the waveform operand of a waveform/scalar pair
+    template<class U1, class U2>
+    using waveform_result_t = std::conditional_t<waveform_type<U1>, U1, U2>;
+
+    // Two waveforms of the same type, or a waveform and a scalar
+    template<class U1, class U2>
+    concept waveform_operands = (waveform_type<U1> && std::is_same_v<U1, U2>) ||
+                                (waveform_type<U1> && is_category_of<U2, scalar_tag>) ||
+                                (is_category_of<U1, scalar_tag> && waveform_type<U2>);
+
+    // An operand as an Eigen array expression: waveforms and nested expressions through array(), scalars cast to
+    // the sample type of W. Plain waveforms are referenced, nested expressions are copied by Eigen.
+    template<class W, class X>
+    decltype(auto) waveform_array(const X& x) {
+        if constexpr (std::is_arithmetic_v<X>) return static_cast<typename W::Scalar>(x);
+        else return x.array();
+    }
+
+    // An array expression as an expression of W: matrix() for VectorXd and VectorXf
+    template<class W, class E>
+    auto as_waveform(const E& e) {
+        if constexpr (std::is_base_of_v<Eigen::MatrixBase<W>, W>) return e.matrix();
+        else return e;
+    }
+
+    // Eigen only asserts on operands of different lengths, so the policies check them first
+    template<class A, class B>
+    void check_waveform_sizes(const A& a, const B& b, const char* op) {
+        if constexpr (!std::is_arithmetic_v<A> && !std::is_arithmetic_v<B>) {
+            if (a.size() != b.size()) {
+                throw std::invalid_argument(std::string("waveform operator") + op + ": " + std::to_string(a.size()) +
+                                            " and " + std::to_string(b.size()) + " samples");
+            }
+        }
+    }
+
+    // ---- equality
+    // == on Eigen arrays is coefficient-wise and asserts on different sizes, so waveforms compare their length first
+    template<waveform_type W>
+    bool waveform_equal(const W& a, const W& b) noexcept {
+        return a.size() == b.size() && (a.array() == b.array()).all();
+    }
+
+    // Equality of two lists of values (small_vector, std::vector, span), used by ParameterBase and AnyParameter
+    template<class R1, class R2>
+    bool values_equal(const R1& a, const R2& b) {
+        using T1 = std::ranges::range_value_t<R1>;
+        using T2 = std::ranges::range_value_t<R2>;
+        if constexpr (waveform_type<T1> || waveform_type<T2>) {
+            if constexpr (!std::is_same_v<T1, T2>) return false;
+            else return std::ranges::equal(a, b, [](const T1& x, const T1& y) { return waveform_equal(x, y); });
+        } else {
+            return std::ranges::equal(a, b);
+        }
+    }
+
+} // namespace detail
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,12 @@
+// instantiations.cpp
+// This file compiles the ParameterBase specializations listed in instantiations.h for methodverse-parameter-impl.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#include <methodverse/parameter/parameter.h>
+
+namespace methodverse::parameter {
+
+    METHODVERSE_PARAMETER_INSTANTIATIONS(METHODVERSE_PARAMETER_INSTANTIATION)
+
+}; // namespace methodverse::parameter
@@ -0,0 +1,71 @@
+"""Compare a methodverse_bench JSON result against a stored baseline.
+
+Matches the benchmarks by name (including the element count) and reports the ratio of ns_per_iteration,
+current / baseline. Exits with status 1 when a benchmark is slower than the baseline by more than the
+threshold, so the script can gate a CI job. Benchmarks that exist in only one of the files are listed but
+do not fail the comparison.
+
+    methodverse_bench --json baseline.json           # on the reference commit
+    methodverse_bench --json current.json            # on the change
+    python tools/compare_bench.py baseline.json current.json --threshold 0.10
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, "r") as f:
+        data = json.load(f)
+    return {b["name"]: b for b in data["benchmarks"]}, data.get("context", {})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline", help="JSON file written by methodverse_bench --json")
+    parser.add_argument("current", help="JSON file written by methodverse_bench --json")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression (default: 0.10 = 10%%)")
+    parser.add_argument("--filter", default="", help="substring of the benchmark names to compare")
+    parser.add_argument("--all", action="store_true", help="print every benchmark, not only the changed ones")
+    args = parser.parse_args()
+
+    baseline, baseline_context = load(args.baseline)
+    current, current_context = load(args.current)
+    if baseline_context.get("assertions") != current_context.get("assertions"):
+        print("⚠️ The files were measured with different assertion settings (Debug vs Release)")
+
+    regressions = []
+    improvements = []
+    print(f"{'benchmark':64} {'baseline [ns]':>14} {'current [ns]':>14} {'ratio':>7}")
+    for name in sorted(baseline.keys() & current.keys()):
+        if args.filter not in name:
+            continue
+        before = baseline[name]["ns_per_iteration"]
+        after = current[name]["ns_per_iteration"]
+        ratio = after / before if before > 0 else float("inf")
+        mark = ""
+        if ratio > 1 + args.threshold:
+            regressions.append(name)
+            mark = "  ❌ slower"
+        elif ratio < 1 / (1 + args.threshold):
+            improvements.append(name)
+            mark = "  ✅ faster"
+        if mark or args.all:
+            print(f"{name:64} {before:14.1f} {after:14.1f} {ratio:7.2f}{mark}")
+
+    for name in sorted(baseline.keys() - current.keys()):
+        if args.filter in name:
+            print(f"{name:64} only in the baseline")
+    for name in sorted(current.keys() - baseline.keys()):
+        if args.filter in name:
+            print(f"{name:64} new")
+
+    print(f"{len(regressions)} slower, {len(improvements)} faster than the baseline "
+          f"(threshold {args.threshold:.0%})")
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
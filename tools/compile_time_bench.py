@@ -0,0 +1,129 @@
+"""Compile-time benchmark of translation units that include the parameter headers.
+
+Reads compile_commands.json of a configured build directory and compiles the selected translation units
+again, several times each, reporting the fastest wall time per TU. The benchmark TU
+bench/compile_time/sequence_tu.cpp is compiled twice by the build, against methodverse-parameter
+(header-only) and methodverse-parameter-impl (extern templates), so both show up in the report.
+
+With --baseline <git-ref>, every TU is also compiled against the include/ directory of that ref
+(e.g. a commit before the header trimming), giving before/after numbers.
+
+    python tools/compile_time_bench.py build/linux-release
+    python tools/compile_time_bench.py _gate_build --filter tst/ --baseline HEAD~1
+"""
+
+import argparse
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tarfile
+import tempfile
+import time
+
+
+def load_commands(build_dir, filters):
+    path = os.path.join(build_dir, "compile_commands.json")
+    if not os.path.exists(path):
+        sys.exit(f"❌ {path} not found, configure the build with CMAKE_EXPORT_COMPILE_COMMANDS=ON")
+    with open(path, "r") as f:
+        entries = json.load(f)
+    return [e for e in entries if any(flt in e["file"] for flt in filters)]
+
+
+def split_command(entry):
+    if "arguments" in entry:
+        return list(entry["arguments"])
+    return shlex.split(entry["command"])
+
+
+def without_output(args):
+    # compile to /dev/null-like temporary output so the build tree is not touched
+    out = []
+    skip = False
+    for a in args:
+        if skip:
+            skip = False
+            continue
+        if a == "-o":
+            skip = True
+            continue
+        out.append(a)
+    return out
+
+
+def time_compile(args, directory, repetitions):
+    best = float("inf")
+    with tempfile.TemporaryDirectory() as tmp:
+        target = os.path.join(tmp, "tu.o")
+        for _ in range(repetitions):
+            start = time.perf_counter()
+            result = subprocess.run(args + ["-o", target], cwd=directory, capture_output=True, text=True)
+            elapsed = time.perf_counter() - start
+            if result.returncode != 0:
+                return None, result.stderr.strip().splitlines()[:3]
+            best = min(best, elapsed)
+        size = os.path.getsize(target)
+    return (best, size), None
+
+
+def extract_include(root_dir, ref, destination):
+    archive = os.path.join(destination, "include.tar")
+    subprocess.run(["git", "archive", "--format=tar", "-o", archive, ref, "include"], cwd=root_dir, check=True)
+    with tarfile.open(archive) as tar:
+        tar.extractall(destination)
+    return os.path.join(destination, "include")
+
+
+def label_of(entry, command, root_dir):
+    name = os.path.relpath(entry["file"], root_dir)
+    extern = any("METHODVERSE_PARAMETER_EXTERN_TEMPLATES" in a for a in command)
+    return f"{name} [{'impl' if extern else 'header-only'}]"
+
+
+def main():
+    tools_dir = os.path.abspath(os.path.dirname(__file__))
+    root_dir = os.path.abspath(os.path.join(tools_dir, ".."))
+
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build_dir", help="configured build directory with compile_commands.json")
+    parser.add_argument("--filter", action="append", default=None,
+                        help="substring of the source paths to time (default: bench/compile_time/)")
+    parser.add_argument("--repetitions", type=int, default=3)
+    parser.add_argument("--baseline", help="git ref whose include/ directory gives the 'before' numbers")
+    args = parser.parse_args()
+
+    filters = args.filter or ["bench/compile_time/"]
+    entries = load_commands(os.path.abspath(args.build_dir), filters)
+    if not entries:
+        sys.exit(f"❌ No translation unit matches {filters}")
+
+    include_dir = os.path.join(root_dir, "include")
+    with tempfile.TemporaryDirectory() as tmp:
+        baseline_include = extract_include(root_dir, args.baseline, tmp) if args.baseline else None
+
+        header = f"{'translation unit':56} {'time [s]':>9} {'object [KB]':>12}"
+        if baseline_include:
+            header += f" {'before [s]':>11} {'speedup':>8}"
+        print(header)
+        for entry in entries:
+            command = without_output(split_command(entry))
+            after, error = time_compile(command, entry["directory"], args.repetitions)
+            line = f"{label_of(entry, command, root_dir):56} "
+            if error:
+                print(line + "failed: " + " | ".join(error))
+                continue
+            line += f"{after[0]:9.2f} {after[1] / 1024:12.1f}"
+            if baseline_include:
+                before_command = [a.replace(include_dir, baseline_include) for a in command]
+                before, error = time_compile(before_command, entry["directory"], args.repetitions)
+                if error:
+                    line += f" {'n/a':>11}" # e.g. the TU uses headers that do not exist at the baseline
+                else:
+                    line += f" {before[0]:11.2f} {before[0] / after[0]:7.2f}x"
+            print(line)
+
+
+if __name__ == "__main__":
+    main()
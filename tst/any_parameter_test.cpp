@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/any_parameter.h>
+#include <methodverse/parameter/dispatch.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct MatrixSize : Parameter<int, MatrixSize, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "MatrixSize";
+};
+
+struct Orientation : Parameter<Eigen::Matrix3d, Orientation, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Orientation";
+};
+
+struct SequenceName : Parameter<std::string, SequenceName, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "SequenceName";
+};
+
+TEST(AnyParameter, VariantFollowsPrimitiveTypes) {
+    boost::mp11::mp_for_each<boost::mp11::mp_iota_c<primitive_type_count>>([](auto I) {
+        using T = boost::mp11::mp_at_c<primitive_types, I>;
+        static_assert(std::is_same_v<std::variant_alternative_t<decltype(I)::value, ParameterValue>,
+                                     methodverse::parameter::detail::value_storage_t<T>>);
+    });
+    const AnyParameter matrix{MatrixSize(256)};
+    EXPECT_EQ(primitive_type_id_v<int>, matrix.TypeId());
+}
+
+TEST(AnyParameter, HoldsIdNameUnitAndValues) {
+    const AnyParameter te{EchoTime{0.01, 0.02}};
+    EXPECT_EQ(EchoTime::id, te.Id());
+    EXPECT_EQ("TE", te.NameView());
+    EXPECT_EQ(runtime_unit_of<si::second>, te.GetRuntimeUnit());
+    EXPECT_EQ(primitive_type_id_v<double>, te.TypeId());
+    EXPECT_EQ(2u, te.Size());
+    EXPECT_EQ(0.02, te.ViewAs<double>()[1]);
+    EXPECT_THROW((void)te.ViewAs<int>(), std::bad_cast);
+    EXPECT_EQ(EchoTime({0.01, 0.02}).ValueAsString(), te.ValueAsString());
+    EXPECT_EQ(2u, te.Visit([](auto values) { return values.size(); }));
+}
+
+TEST(AnyParameter, FromIParameterAndAssignBack) {
+    const Orientation orientation(Eigen::Matrix3d::Identity());
+    const IParameter& erased = orientation;
+    const AnyParameter any = AnyParameter::From(erased);
+    EXPECT_EQ(AnyParameter(orientation), any);
+
+    Orientation target;
+    any.AssignTo(target);
+    EXPECT_EQ(orientation, target);
+
+    EchoTime te;
+    EXPECT_THROW(any.AssignTo(te), std::invalid_argument); // Matrix3d into double
+    const AnyParameter tr{RepetitionTime(2.0)};
+    ParameterBase<double, si::metre> distance;
+    EXPECT_THROW(tr.AssignTo(distance), std::invalid_argument); // s into m
+    tr.AssignTo(te);
+    EXPECT_EQ(2.0, te.Val());
+
+    const DynamicParameter<double> dynamic(runtime_unit_of<si::second>);
+    EXPECT_NO_THROW((void)AnyParameter::From(dynamic));
+}
+
+TEST(AnyParameter, FindNonFinite) {
+    Eigen::Matrix3d bad = Eigen::Matrix3d::Identity();
+    bad(1, 2) = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<AnyParameter> protocol{
+        AnyParameter(EchoTime{0.01, std::numeric_limits<double>::infinity()}), AnyParameter(RepetitionTime(2.0)),
+        AnyParameter(Orientation(bad)), AnyParameter(MatrixSize(256)), AnyParameter(SequenceName("gre"))};
+    EXPECT_EQ((std::vector<ParameterId>{EchoTime::id, Orientation::id}), FindNonFinite(protocol));
+}
+
+TEST(AnyParameter, FormatParametersTo) {
+    const std::vector<AnyParameter> protocol{AnyParameter(EchoTime{0.01, 0.02}), AnyParameter(MatrixSize(256)),
+                                             AnyParameter(SequenceName("gre"))};
+    fmt::memory_buffer out;
+    FormatParametersTo(out, protocol);
+    EXPECT_EQ("TE = [0.01, 0.02] s\nMatrixSize = 256\nSequenceName = gre\n", fmt::to_string(out));
+}
+
+TEST(AnyParameter, DiffParameters) {
+    const std::vector<AnyParameter> before{AnyParameter(EchoTime(0.01)), AnyParameter(RepetitionTime(2.0)),
+                                           AnyParameter(MatrixSize(256))};
+    const std::vector<AnyParameter> after{AnyParameter(MatrixSize(256)), AnyParameter(EchoTime(0.02)),
+                                          AnyParameter(SequenceName("gre"))};
+    auto diff = DiffParameters(before, after);
+    ASSERT_EQ(3u, diff.size());
+    std::sort(diff.begin(), diff.end(), [](const auto& a, const auto& b) { return a.name < b.name; });
+    EXPECT_EQ("SequenceName", diff[0].name);
+    EXPECT_EQ(ParameterDiff::Kind::added, diff[0].kind);
+    EXPECT_EQ("TE", diff[1].name);
+    EXPECT_EQ(ParameterDiff::Kind::changed, diff[1].kind);
+    EXPECT_EQ("TR", diff[2].name);
+    EXPECT_EQ(ParameterDiff::Kind::removed, diff[2].kind);
+    EXPECT_TRUE(DiffParameters(before, before).empty());
+}
+
+TEST(AnyParameter, DiffTreatsNanAsUnchanged) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    Eigen::Matrix3d m = Eigen::Matrix3d::Identity();
+    m(1, 2) = nan;
+    const std::vector<AnyParameter> before{AnyParameter(EchoTime{0.01, nan}), AnyParameter(Orientation(m))};
+    const std::vector<AnyParameter> same{AnyParameter(EchoTime{0.01, nan}), AnyParameter(Orientation(m))};
+    EXPECT_TRUE(DiffParameters(before, same).empty());
+
+    const std::vector<AnyParameter> after{AnyParameter(EchoTime{nan, nan}), AnyParameter(Orientation(m))};
+    const auto diff = DiffParameters(before, after);
+    ASSERT_EQ(1u, diff.size());
+    EXPECT_EQ(ParameterDiff::Kind::changed, diff[0].kind);
+}
+
+TEST(AnyParameter, OwnsTheName) {
+    // a run-time name that is gone before the AnyParameter is used
+    struct Named : ParameterBase<double> {
+        std::string name;
+        explicit Named(std::string n) : ParameterBase<double>(1.0), name(std::move(n)) {}
+        std::string_view NameView() const noexcept override { return name; }
+    };
+    std::vector<AnyParameter> protocol;
+    {
+        Named p(std::string(40, 'x'));
+        protocol.push_back(AnyParameter::From(p));
+    }
+    EXPECT_EQ(std::string(40, 'x'), protocol[0].NameView());
+}
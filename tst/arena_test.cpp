@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/arena.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Position : Parameter<Eigen::Vector3d, Position, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Position";
+};
+
+struct Samples : Parameter<double, Samples, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Samples";
+};
+
+struct Label : Parameter<std::string, Label, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Label";
+};
+
+// holds a std::string besides the values
+struct Named : ParameterBase<double> {
+    std::string name;
+    explicit Named(std::string n, double v) : ParameterBase<double>(v), name(std::move(n)) {}
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+TEST(ParameterArena, BumpAllocatesAlignedWithinBlocks) {
+    ParameterArena arena(256);
+    void* a = arena.Allocate(10, 8);
+    void* b = arena.Allocate(8, 64);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(a) % ParameterArena::block_alignment);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 64);
+    EXPECT_EQ(static_cast<std::byte*>(a) + 64, static_cast<std::byte*>(b));
+    EXPECT_EQ(1u, arena.BlockCount());
+
+    (void)arena.Allocate(200, 8); // does not fit: new block
+    EXPECT_EQ(2u, arena.BlockCount());
+    (void)arena.Allocate(1000, 8); // larger than the block size
+    EXPECT_EQ(3u, arena.BlockCount());
+    EXPECT_EQ(10u + 54u + 8u + 200u + 1000u, arena.BytesUsed());
+
+    arena.Release();
+    EXPECT_EQ(0u, arena.BlockCount());
+    EXPECT_EQ(0u, arena.BytesUsed());
+}
+
+TEST(ParameterArena, IsAMemoryResource) {
+    ParameterArena arena;
+    std::pmr::vector<int> v(&arena);
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    EXPECT_EQ(99, v.back());
+    EXPECT_GT(arena.BytesUsed(), 100 * sizeof(int));
+}
+
+TEST(Protocol, ConstructsParametersContiguously) {
+    Protocol protocol;
+    auto& te = protocol.Emplace<EchoTime>(0.01);
+    auto& pos = protocol.Emplace<Position>(Eigen::Vector3d(1, 2, 3));
+    EXPECT_EQ(2u, protocol.Size());
+    EXPECT_EQ(1u, protocol.Arena().BlockCount());
+    EXPECT_LT(reinterpret_cast<std::byte*>(&te), reinterpret_cast<std::byte*>(&pos));
+    EXPECT_LE(reinterpret_cast<std::byte*>(&pos) - reinterpret_cast<std::byte*>(&te),
+              static_cast<std::ptrdiff_t>(ParameterArena::align_up(sizeof(EchoTime), alignof(Position))));
+
+    EXPECT_EQ(&te, protocol.Find("TE"_pid));
+    EXPECT_EQ(&pos, protocol.Find<Position>());
+    EXPECT_EQ(&te, &protocol[0]);
+    EXPECT_EQ(nullptr, protocol.Find("TR"_pid));
+    EXPECT_THROW(protocol.Emplace<EchoTime>(0.02), std::invalid_argument);
+    EXPECT_EQ(2u, protocol.Size());
+
+    std::vector<std::string> names;
+    protocol.ForEach([&](const IParameter& p) { names.emplace_back(p.NameView()); });
+    EXPECT_EQ((std::vector<std::string>{"TE", "Position"}), names);
+}
+
+TEST(Protocol, CopyIsDeepAndIndependent) {
+    Protocol protocol(512); // small blocks so the copy spans several source blocks
+    protocol.Emplace<EchoTime>(0.01);
+    protocol.Emplace<Position>(Eigen::Vector3d(1, 2, 3));
+    protocol.Emplace<Samples>(std::vector<double>{1, 2, 3, 4, 5, 6, 7, 8}); // spilled to the heap
+    protocol.Emplace<Label>(std::string(100, 'x'));
+    for (int i = 0; i < 20; ++i) protocol.Emplace<Named>("Param_" + std::to_string(i), i);
+    ASSERT_GT(protocol.Arena().BlockCount(), 1u);
+
+    Protocol copy(protocol);
+    ASSERT_EQ(protocol.Size(), copy.Size());
+    EXPECT_EQ(1u, copy.Arena().BlockCount());
+    for (std::size_t i = 0; i < copy.Size(); ++i) {
+        EXPECT_NE(&protocol[i], &copy[i]);
+        EXPECT_EQ(protocol[i].NameView(), copy[i].NameView());
+        EXPECT_EQ(protocol[i].ValueAsString(), copy[i].ValueAsString());
+    }
+
+    auto* te = copy.Find<EchoTime>();
+    ASSERT_NE(nullptr, te);
+    EXPECT_EQ(&copy[0], te);
+    (*te)[0] = 0.02;
+    EXPECT_DOUBLE_EQ(0.01, (*protocol.Find<EchoTime>())[0]);
+
+    auto* samples = copy.Find<Samples>();
+    (*samples)[0] = -1.0;
+    EXPECT_DOUBLE_EQ(1.0, (*protocol.Find<Samples>())[0]);
+    EXPECT_NE(samples->View().data(), protocol.Find<Samples>()->View().data());
+
+    auto* named = static_cast<Named*>(copy.Find("Param_7"_pid));
+    ASSERT_NE(nullptr, named);
+    EXPECT_EQ("Param_7", named->NameView());
+    EXPECT_EQ(&copy[11], named);
+}
+
+// counts its live objects; the copy of the one named "Throws" fails
+struct Counted : ParameterBase<double> {
+    inline static int live = 0;
+    std::string name;
+    explicit Counted(std::string n) : name(std::move(n)) { ++live; }
+    Counted(const Counted& other) : ParameterBase<double>(other), name(other.name) {
+        if (name == "Throws") throw std::runtime_error("copy");
+        ++live;
+    }
+    ~Counted() override { --live; }
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+TEST(Protocol, CopyConstructsEveryParameter) {
+    {
+        Protocol protocol;
+        protocol.Emplace<Counted>("A");
+        protocol.Emplace<EchoTime>(0.01);
+        protocol.Emplace<Counted>("B");
+        {
+            const Protocol copy(protocol);
+            EXPECT_EQ(4, Counted::live);
+            EXPECT_EQ("B", copy[2].NameView());
+        }
+        EXPECT_EQ(2, Counted::live);
+    }
+    EXPECT_EQ(0, Counted::live);
+}
+
+TEST(Protocol, FailedCopyDestroysTheCopiedParameters) {
+    {
+        Protocol protocol;
+        protocol.Emplace<EchoTime>(0.01);
+        protocol.Emplace<Counted>("A");
+        protocol.Emplace<Counted>("B");
+        protocol.Emplace<Counted>("Throws");
+        EXPECT_EQ(3, Counted::live);
+        EXPECT_THROW(Protocol copy(protocol), std::runtime_error);
+        EXPECT_EQ(3, Counted::live);
+    }
+    EXPECT_EQ(0, Counted::live);
+}
+
+TEST(Protocol, AssignmentAndMove) {
+    Protocol a;
+    a.Emplace<EchoTime>(0.01);
+    a.Emplace<Named>("Long name that does not fit the small string buffer", 3.0);
+
+    Protocol b;
+    b.Emplace<Position>(Eigen::Vector3d::Zero());
+    b = a;
+    ASSERT_EQ(2u, b.Size());
+    EXPECT_EQ(nullptr, b.Find<Position>());
+    EXPECT_NE(nullptr, b.Find<EchoTime>());
+
+    const IParameter* te = a.Find<EchoTime>();
+    Protocol c(std::move(a));
+    EXPECT_EQ(te, c.Find<EchoTime>());
+    EXPECT_EQ(0u, a.Size());
+    EXPECT_EQ(nullptr, a.Find(EchoTime::id));
+    EXPECT_EQ(nullptr, a.Find<EchoTime>());
+
+    b = std::move(c);
+    EXPECT_EQ(te, b.Find<EchoTime>());
+    EXPECT_EQ(0u, c.Size());
+    EXPECT_EQ(nullptr, c.Find(EchoTime::id));
+    // a moved-from protocol can be reused
+    a.Emplace<EchoTime>(0.02);
+    EXPECT_DOUBLE_EQ(0.02, (*a.Find<EchoTime>())[0]);
+    EXPECT_EQ("3", b[1].ValueAsString());
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct LineMask : Parameter<BitMask, LineMask, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "LineMask";
+};
+
+// bits i with i % step == 0
+BitMask every(std::size_t size, std::size_t step) {
+    auto mask = BitMask::Filled(size, false);
+    for (std::size_t i = 0; i < size; i += step) mask.Set(i);
+    return mask;
+}
+
+TEST(BitMask, ConstructTestAndSet) {
+    const BitMask empty{};
+    EXPECT_TRUE(empty.Empty());
+    EXPECT_EQ(BitMask::npos, empty.FindFirst());
+
+    auto mask = BitMask::Filled(130, false);
+    EXPECT_EQ(130u, mask.Size());
+    EXPECT_EQ(3u, mask.Words().size());
+    EXPECT_TRUE(mask.None());
+    mask.Set(0);
+    mask.Set(129);
+    EXPECT_TRUE(mask.Test(0));
+    EXPECT_TRUE(mask.Test(129));
+    EXPECT_FALSE(mask.Test(64));
+    mask.Reset(0);
+    EXPECT_FALSE(mask.Test(0));
+    EXPECT_THROW((void)mask.Test(130), std::out_of_range);
+    EXPECT_THROW(mask.Set(130), std::out_of_range);
+
+    const auto full = BitMask::Filled(70, true);
+    EXPECT_TRUE(full.All());
+    EXPECT_EQ(70u, full.Count());
+    EXPECT_EQ(0x3Fu, full.Words()[1]); // the bits past Size() stay zero
+    EXPECT_EQ(64u, BitMask::Filled(64, true).Count());
+    EXPECT_EQ(2u, (BitMask{true, true}.Size())); // braces always list the bits
+}
+
+TEST(BitMask, SetRange) {
+    auto mask = BitMask::Filled(200, false);
+    mask.Set(3, 150, true);
+    EXPECT_EQ(147u, mask.Count());
+    EXPECT_FALSE(mask.Test(2));
+    EXPECT_TRUE(mask.Test(3));
+    EXPECT_TRUE(mask.Test(149));
+    EXPECT_FALSE(mask.Test(150));
+    mask.Set(64, 128, false);
+    EXPECT_EQ(83u, mask.Count());
+    EXPECT_THROW(mask.Set(10, 201, true), std::out_of_range);
+    mask.SetAll();
+    EXPECT_TRUE(mask.All());
+}
+
+TEST(BitMask, FromAndToBools) {
+    std::vector<bool> expected(100);
+    bool bools[100];
+    for (std::size_t i = 0; i < 100; ++i) bools[i] = expected[i] = i % 3 == 0;
+    const BitMask mask{std::span<const bool>(bools)};
+    EXPECT_EQ(34u, mask.Count());
+    EXPECT_EQ(every(100, 3), mask);
+
+    bool unpacked[100];
+    mask.CopyTo(unpacked);
+    for (std::size_t i = 0; i < 100; ++i) EXPECT_EQ(expected[i], unpacked[i]);
+    EXPECT_THROW(mask.CopyTo(std::span<bool>(unpacked, 99)), std::invalid_argument);
+
+    EXPECT_EQ(BitMask({true, false, true}), every(3, 2));
+}
+
+TEST(BitMask, WordParallelOperators) {
+    const BitMask a = every(150, 2);
+    const BitMask b = every(150, 3);
+    EXPECT_EQ(every(150, 6), a & b);
+    EXPECT_EQ(75u + 50u - 25u, (a | b).Count());
+    EXPECT_EQ(75u + 50u - 2 * 25u, (a ^ b).Count());
+    EXPECT_EQ(150u - (a ^ b).Count(), Xnor(a, b).Count());
+    EXPECT_EQ(75u, (~a).Count()); // the tail of the last word is cleared again
+    EXPECT_EQ(a, ~~a);
+    EXPECT_THROW((void)(a & every(151, 2)), std::invalid_argument);
+}
+
+TEST(BitMask, FindAndIterateSetBits) {
+    auto mask = BitMask::Filled(300, false);
+    for (const std::size_t i : {5u, 63u, 64u, 200u, 299u}) mask.Set(i);
+    EXPECT_EQ(5u, mask.FindFirst());
+
+    std::vector<std::size_t> found;
+    for (std::size_t i = mask.FindFirst(); i != BitMask::npos; i = mask.FindNext(i)) found.push_back(i);
+    EXPECT_EQ((std::vector<std::size_t>{5, 63, 64, 200, 299}), found);
+
+    std::vector<std::size_t> visited;
+    mask.ForEachSet([&](std::size_t i) { visited.push_back(i); });
+    EXPECT_EQ(found, visited);
+    EXPECT_EQ(BitMask::npos, mask.FindNext(299));
+}
+
+TEST(BitMask, ParameterThroughOpTags) {
+    static_assert(std::is_same_v<category_t<BitMask>, bitmask_tag>);
+    const LineMask sampled(every(256, 2));
+    const LineMask center(every(256, 5));
+
+    const auto both = EagerApply<and_op>(sampled, center);
+    EXPECT_EQ(every(256, 10), both.Val());
+    EXPECT_EQ((every(256, 2) | every(256, 5)), EagerApply<or_op>(sampled, center).Val());
+    EXPECT_EQ((every(256, 2) ^ every(256, 5)), EagerApply<xor_op>(sampled, center).Val());
+    EXPECT_EQ(Xnor(every(256, 2), every(256, 5)), EagerApply<xnor_op>(sampled, center).Val());
+    EXPECT_EQ(128u, EagerApply<not_op>(sampled).Val().Count());
+
+    EXPECT_EQ("LineMask", sampled.Name());
+    EXPECT_EQ("10101", fmt::format("{}", BitMask({true, false, true, false, true})));
+}
+
+TEST(BitMask, UnaryOpOnBoolParameter) {
+    const ParameterBase<bool, one> enabled({true, false, true});
+    const auto disabled = EagerApply<not_op>(enabled);
+    EXPECT_EQ((std::vector<bool>{false, true, false}), disabled.Vals());
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/formula.h>
+#include <methodverse/parameter/parameter.h>
+#include <methodverse/parameter/parse.h>
+#include <methodverse/parameter/snapshot.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct FlipAngle : Parameter<double, FlipAngle, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "FlipAngle";
+};
+
+// records the batches delivered to it
+struct Recorder {
+    std::vector<std::vector<ParameterId>> batches;
+    ChangeSubscription subscription = SubscribeChanges([this](std::span<const ParameterChange> batch) {
+        std::vector<ParameterId> ids;
+        for (const auto& c : batch) ids.push_back(c.id);
+        batches.push_back(std::move(ids));
+    });
+};
+
+TEST(ChangeLog, NoSubscriberNoDelivery) {
+    EchoTime te(0.01);
+    te = 0.02;
+    te.Set(0.03);
+    EXPECT_DOUBLE_EQ(0.03, te.Val());
+}
+
+TEST(ChangeLog, ChangesOutsideTransactionAreDeliveredImmediately) {
+    Recorder recorder;
+    EchoTime te;
+    RepetitionTime tr;
+    te = 0.01;
+    tr.Set({1.0, 2.0});
+    ASSERT_EQ(2u, recorder.batches.size());
+    EXPECT_EQ(std::vector<ParameterId>{EchoTime::id}, recorder.batches[0]);
+    EXPECT_EQ(std::vector<ParameterId>{RepetitionTime::id}, recorder.batches[1]);
+}
+
+TEST(ChangeLog, TransactionDeliversOneDeduplicatedBatch) {
+    Recorder recorder;
+    EchoTime te;
+    RepetitionTime tr;
+    FlipAngle fa;
+    const IParameter* last_te = nullptr;
+    auto check = SubscribeChanges([&](std::span<const ParameterChange> batch) {
+        for (const auto& c : batch) {
+            if (c.id == EchoTime::id) last_te = c.parameter;
+        }
+    });
+    EchoTime other_te;
+    {
+        ChangeTransaction tx;
+        te = 0.01;
+        tr = {1.0, 2.0};
+        for (int i = 0; i < 1000; ++i) fa = static_cast<double>(i);
+        other_te = 0.05; // same id, changed last
+        EXPECT_TRUE(recorder.batches.empty());
+    }
+    ASSERT_EQ(1u, recorder.batches.size());
+    EXPECT_EQ((std::vector<ParameterId>{EchoTime::id, RepetitionTime::id, FlipAngle::id}), recorder.batches[0]);
+    EXPECT_EQ(&other_te, last_te);
+}
+
+TEST(ChangeLog, NestedTransactionsDeliverAtTheOutermostCommit) {
+    Recorder recorder;
+    EchoTime te;
+    ChangeTransaction outer;
+    {
+        ChangeTransaction inner;
+        te = 0.01;
+    }
+    EXPECT_TRUE(recorder.batches.empty());
+    te = 0.02;
+    outer.Commit();
+    ASSERT_EQ(1u, recorder.batches.size());
+    EXPECT_EQ(std::vector<ParameterId>{EchoTime::id}, recorder.batches[0]);
+    outer.Commit(); // no effect
+    EXPECT_EQ(1u, recorder.batches.size());
+}
+
+TEST(ChangeLog, ExplicitNotificationAndParse) {
+    Recorder recorder;
+    RepetitionTime tr(1.0);
+    tr.Get()[0] = 2.0; // not seen
+    EXPECT_TRUE(recorder.batches.empty());
+    tr.NotifyChanged();
+    ParseInto("3.0 s", tr);
+    EXPECT_EQ(2u, recorder.batches.size());
+}
+
+TEST(ChangeLog, SnapshotLoadsAndFormulaResultsAreDelivered) {
+    const std::string path = (std::filesystem::temp_directory_path() / "change_log_test.mvps").string();
+    const EchoTime saved_te(0.01);
+    const RepetitionTime saved_tr(2.0);
+    WriteSnapshot(path, {&saved_te, &saved_tr});
+
+    Recorder recorder;
+    EchoTime te;
+    RepetitionTime tr;
+    {
+        const Snapshot snapshot(path);
+        ChangeTransaction tx;
+        snapshot.LoadInto(te);
+        snapshot.LoadInto(tr);
+    }
+    std::filesystem::remove(path);
+    ASSERT_EQ(1u, recorder.batches.size());
+    EXPECT_EQ((std::vector<ParameterId>{EchoTime::id, RepetitionTime::id}), recorder.batches[0]);
+    EXPECT_DOUBLE_EQ(2.0, tr.Val());
+
+    FormulaSymbols symbols{{"te", &te}};
+    Formula tr_min("TR_min = te * 100", symbols);
+    tr_min.EvaluateInto(tr);
+    ASSERT_EQ(2u, recorder.batches.size());
+    EXPECT_EQ(std::vector<ParameterId>{RepetitionTime::id}, recorder.batches[1]);
+    EXPECT_DOUBLE_EQ(1.0, tr.Val());
+}
+
+TEST(ChangeLog, ChangesBySubscribersAreDeliveredInAFollowingBatch) {
+    Recorder recorder;
+    RepetitionTime tr;
+    // keep TR = 2 * TE
+    auto rule = SubscribeChanges([&](std::span<const ParameterChange> batch) {
+        for (const auto& c : batch) {
+            if (c.id == EchoTime::id) tr = 2.0 * static_cast<const EchoTime*>(c.parameter)->Val();
+        }
+    });
+    EchoTime te;
+    te = 0.5;
+    EXPECT_DOUBLE_EQ(1.0, tr.Val());
+    ASSERT_EQ(2u, recorder.batches.size());
+    EXPECT_EQ(std::vector<ParameterId>{RepetitionTime::id}, recorder.batches[1]);
+}
+
+TEST(ChangeLog, ThrowingSubscriberDoesNotStopLaterDeliveries) {
+    EchoTime te;
+    {
+        auto failing = SubscribeChanges([](std::span<const ParameterChange>) { throw std::runtime_error("subscriber"); });
+        EXPECT_THROW(te.Set(0.01), std::runtime_error);
+        ChangeTransaction tx;
+        te = 0.02;
+        EXPECT_THROW(tx.Commit(), std::runtime_error);
+    }
+    Recorder recorder;
+    te.Set(0.03);
+    {
+        ChangeTransaction tx;
+        te = 0.04;
+    }
+    EXPECT_EQ(2u, recorder.batches.size());
+}
+
+TEST(ChangeLog, LogsArePerThread) {
+    Recorder recorder;
+    ChangeTransaction tx;
+    std::thread([] {
+        EchoTime te;
+        te = 0.01; // delivered on this thread, not held by the transaction of the main thread
+    }).join();
+    EXPECT_EQ(1u, recorder.batches.size());
+}
+
+TEST(ChangeLog, UnsubscribeStopsDelivery) {
+    Recorder recorder;
+    EchoTime te;
+    te = 0.01;
+    recorder.subscription.Reset();
+    te = 0.02;
+    EXPECT_EQ(1u, recorder.batches.size());
+}
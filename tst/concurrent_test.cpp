@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/concurrent.h>
+#include <methodverse/parameter/parameter.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Gradients : Parameter<Eigen::Vector3d, Gradients, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Gradients";
+};
+
+TEST(ConcurrentParameter, ReadsAndWrites) {
+    ConcurrentParameter<EchoTime> te(0.01);
+    EXPECT_DOUBLE_EQ(0.01, te.Read([](const EchoTime& p) { return p.Val(); }));
+    EXPECT_EQ(0u, te.Version());
+
+    te.Write([](EchoTime& p) { p = 0.02; });
+    EXPECT_DOUBLE_EQ(0.02, te.Load().Val());
+    EXPECT_EQ(1u, te.Version());
+
+    te.Store(EchoTime(std::vector<double>{1, 2, 3}));
+    EXPECT_EQ(3u, te.Load().Size());
+    EXPECT_EQ(2u, te.Version());
+}
+
+TEST(ConcurrentParameter, WriteIsReportedOnceAfterTheLock) {
+    ConcurrentParameter<EchoTime> te(0.01);
+    std::vector<const IParameter*> changed;
+    auto subscription = SubscribeChanges([&](std::span<const ParameterChange> batch) {
+        for (const auto& c : batch) changed.push_back(c.parameter);
+        // a subscriber may write the parameter it is notified of
+        if (changed.size() == 1) te.Store(EchoTime(0.05));
+    });
+    te.Write([](EchoTime& p) { p = 0.02; });
+    ASSERT_EQ(2u, changed.size());
+    const IParameter* published = te.Read([](const EchoTime& p) { return static_cast<const IParameter*>(&p); });
+    EXPECT_EQ(published, changed[1]);
+    EXPECT_DOUBLE_EQ(0.05, te.Load().Val());
+    EXPECT_EQ(2u, te.Version());
+}
+
+// Writers keep every value of the parameter equal and its size tied to the value; a reader that observes
+// a partially written parameter breaks the invariant.
+TEST(ConcurrentParameter, StressReadersNeverSeeTornValues) {
+    ConcurrentParameter<Gradients> g(std::vector<Eigen::Vector3d>(1, Eigen::Vector3d::Zero()));
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> torn{0};
+    std::atomic<std::uint64_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            std::uint64_t last_version = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const bool ok = g.Read([](const Gradients& p) {
+                    const auto v = p.View();
+                    if (v.empty()) return false;
+                    const double k = v[0].x();
+                    if (v.size() != static_cast<std::size_t>(k) % 40 + 1) return false;
+                    for (const auto& x : v) {
+                        if (x != Eigen::Vector3d(k, -k, 2 * k)) return false;
+                    }
+                    return true;
+                });
+                if (!ok) torn.fetch_add(1);
+                const std::uint64_t version = g.Version();
+                if (version < last_version) torn.fetch_add(1); // versions never go back
+                last_version = version;
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 2; ++w) {
+        writers.emplace_back([&, w] {
+            for (int i = 0; i < 2000; ++i) {
+                const double k = 2 * i + w;
+                // sizes up to 40 spill to the heap, so a torn read could also touch freed memory
+                g.Write([k](Gradients& p) {
+                    p.Get().assign(static_cast<std::size_t>(k) % 40 + 1, Eigen::Vector3d(k, -k, 2 * k));
+                });
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(0u, torn.load());
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(4000u, g.Version());
+}
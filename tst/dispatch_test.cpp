@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <Eigen/Dense>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/dispatch.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+TEST(RuntimeUnit, DecodedFromCanonicalUnit) {
+    constexpr RuntimeUnit hz = runtime_unit_of<si::hertz>;
+    EXPECT_EQ(-1, hz.exponents[2]);
+    EXPECT_EQ(hz, runtime_unit_of<one / si::second>);
+    EXPECT_EQ(runtime_unit_of<si::metre> * runtime_unit_of<si::metre>, runtime_unit_of<square(si::metre)>);
+    EXPECT_DOUBLE_EQ(0.001, runtime_unit_of<si::milli<si::second>>.magnitude);
+    EXPECT_FALSE(runtime_unit_of<si::milli<si::second>> == runtime_unit_of<si::second>);
+    EXPECT_TRUE(runtime_unit_of<si::milli<si::second>>.SameDimension(runtime_unit_of<si::second>));
+    EXPECT_TRUE(runtime_unit_of<one>.IsDimensionless());
+    EXPECT_EQ("m s^-1", (runtime_unit_of<si::metre / si::second>).ToString());
+}
+
+TEST(DynamicApply, MatchesCompileTimeOperators) {
+    ParameterBase<double, si::hertz / si::tesla> gamma(42.577478461e6);
+    ParameterBase<double, si::tesla / si::metre> grad{10.0, 20.0};
+    const IParameter& a = gamma;
+    const IParameter& b = grad;
+
+    auto r = DynamicApply<mul_op>(a, b);
+    ParameterBase<double, si::hertz / si::tesla * (si::tesla / si::metre)> expected = gamma * grad;
+    ASSERT_EQ(primitive_type_id_v<double>, r->TypeId());
+    EXPECT_EQ(expected.Vals(), std::vector<double>(r->ViewAs<double>().begin(), r->ViewAs<double>().end()));
+    EXPECT_EQ(runtime_unit_of<si::hertz / si::metre>, r->GetRuntimeUnit());
+
+    // results can be used as operands again
+    ParameterBase<double, si::metre> x(0.5);
+    auto phase = DynamicApply(*FindDispatchOp("*"), *r, x);
+    EXPECT_EQ(runtime_unit_of<si::hertz>, phase->GetRuntimeUnit());
+    EXPECT_DOUBLE_EQ(0.5 * 20.0 * 42.577478461e6, phase->ViewAs<double>()[1]);
+}
+
+TEST(DynamicApply, MixedTypesAndCategories) {
+    ParameterBase<int, si::metre> n(2);
+    ParameterBase<Eigen::Vector3d, si::metre> v{Eigen::Vector3d(1, 2, 3), Eigen::Vector3d(0, 0, 1)};
+    ParameterBase<Eigen::Vector3d, si::metre> w(Eigen::Vector3d(1, 0, 0));
+
+    auto sum = DynamicApply<add_op>(n, v);
+    EXPECT_EQ(Eigen::Vector3d(3, 4, 5), sum->ViewAs<Eigen::Vector3d>()[0]);
+
+    auto dot = DynamicApply<dot_op>(v, w);
+    ASSERT_EQ(primitive_type_id_v<double>, dot->TypeId());
+    EXPECT_EQ(2u, dot->ViewAs<double>().size());
+    EXPECT_DOUBLE_EQ(1.0, dot->ViewAs<double>()[0]);
+    EXPECT_EQ(runtime_unit_of<square(si::metre)>, dot->GetRuntimeUnit());
+
+    ParameterBase<bool> t(true), f(false);
+    EXPECT_FALSE(DynamicApply<and_op>(t, f)->ViewAs<bool>()[0]);
+    EXPECT_EQ("false", DynamicApply<and_op>(t, f)->ValueAsString());
+}
+
+TEST(DynamicApply, ReportsInvalidOperations) {
+    ParameterBase<double, si::second> t(1.0);
+    ParameterBase<double, si::milli<si::second>> t_ms(1.0);
+    ParameterBase<std::string> s(std::string("TE"));
+
+    EXPECT_THROW((void)DynamicApply<mul_op>(t, s), std::invalid_argument);   // policy disabled
+    EXPECT_THROW((void)DynamicApply<add_op>(t, t_ms), std::invalid_argument); // units differ
+    EXPECT_THROW((void)DynamicApply(dispatch_op_count, t, t), std::out_of_range);
+    EXPECT_THROW((void)t.ViewAs<int>(), std::bad_cast);
+
+    try {
+        (void)DynamicApply<cross_op>(t, s);
+        FAIL();
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string("DynamicApply: operator cross is not defined for double and string"), e.what());
+    }
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/dispatch.h>
+#include <methodverse/parameter/soa.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Gradient : Parameter<Eigen::Vector3d, Gradient, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Gradient";
+};
+
+TEST(Formatters, PrimitiveTypesOnOneLine) {
+    EXPECT_EQ("(1, 2, 3)", fmt::format("{}", Eigen::Vector3d(1, 2, 3)));
+    EXPECT_EQ("(1, 2.5, -3)", fmt::format("{}", Eigen::RowVector3d(1, 2.5, -3)));
+    EXPECT_EQ("((1, 0, 0), (0, 1, 0), (0, 0, 1))", fmt::format("{}", Eigen::Matrix3d::Identity().eval()));
+    EXPECT_EQ("(1, 0, 0, 0)", fmt::format("{}", Eigen::Quaterniond::Identity()));
+    EXPECT_EQ("(1.00, 0.50)", fmt::format("{:.2f}", Eigen::Vector2d(1, 0.5)));
+
+    Eigen::Matrix3d m;
+    m << 1, 2, 3, 4, 5, 6, 7, 8, 9;
+    EXPECT_EQ("((1, 2, 3), (4, 5, 6), (7, 8, 9))", fmt::format("{}", m)); // row by row
+}
+
+TEST(Formatters, ValueAsStringMatchesFormatValueTo) {
+    EXPECT_EQ("0.01", EchoTime(0.01).ValueAsString());
+    EXPECT_EQ("[1, 2, 3]", ParameterBase<int>({1, 2, 3}).ValueAsString());
+    EXPECT_EQ("[true, false]", ParameterBase<bool>({true, false}).ValueAsString());
+    EXPECT_EQ("abc", ParameterBase<std::string>(std::string("abc")).ValueAsString());
+    EXPECT_EQ("[(1, 2, 3), (4, 5, 6)]",
+              Gradient(std::vector<Eigen::Vector3d>{{1, 2, 3}, {4, 5, 6}}).ValueAsString());
+
+    // one buffer reused for several parameters
+    const EchoTime te(0.01);
+    const Gradient g(Eigen::Vector3d(1, 2, 3));
+    const std::vector<const IParameter*> params{&te, &g};
+    fmt::memory_buffer buffer;
+    for (const IParameter* p : params) {
+        fmt::format_to(fmt::appender(buffer), "{}=", p->NameView());
+        p->FormatValueTo(buffer);
+        buffer.push_back(';');
+    }
+    EXPECT_EQ("TE=0.01;Gradient=(1, 2, 3);", fmt::to_string(buffer));
+}
+
+TEST(Formatters, OtherParameterClasses) {
+    SoaParameter<Eigen::Vector3d, si::metre> soa(std::vector<Eigen::Vector3d>{{1, 2, 3}, {4, 5, 6}});
+    EXPECT_EQ("[(1, 2, 3), (4, 5, 6)]", soa.ValueAsString());
+
+    DynamicParameter<double> d(RuntimeUnit{});
+    d.Get().assign(1, 2.5);
+    fmt::memory_buffer buffer;
+    d.FormatValueTo(buffer);
+    EXPECT_EQ("2.5", fmt::to_string(buffer));
+}
+
+TEST(Formatters, ParameterWithUnit) {
+    const EchoTime te(0.01);
+    EXPECT_EQ("0.01", fmt::format("{}", te));
+    EXPECT_EQ("0.01 s", fmt::format("{:u}", te));
+    EXPECT_EQ("0.010 s", fmt::format("{:u.3f}", te));
+    EXPECT_EQ("[(1.0, 2.0, 3.0), (4.0, 5.0, 6.0)] m",
+              fmt::format("{:u.1f}", Gradient(std::vector<Eigen::Vector3d>{{1, 2, 3}, {4, 5, 6}})));
+    EXPECT_EQ("[1, 2]", fmt::format("{:u}", ParameterBase<int>({1, 2}))); // dimensionless: no suffix
+}
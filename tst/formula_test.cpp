@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <Eigen/Dense>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/formula.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+TEST(Formula, EvaluatesWithBoundParameters) {
+    ParameterBase<double, si::second> t_exc(0.004), t_ref(0.006), t_adc(0.008);
+    FormulaSymbols symbols{{"t_exc", &t_exc}, {"t_ref", &t_ref}, {"t_adc", &t_adc}};
+
+    Formula te_min("TE_min = t_exc/2 + t_ref + t_adc/2", symbols);
+    EXPECT_EQ("TE_min", te_min.Target());
+    EXPECT_EQ(runtime_unit_of<si::second>, te_min.GetRuntimeUnit());
+    EXPECT_EQ(4u, te_min.InstructionCount());
+
+    ParameterBase<double, si::second> te;
+    te_min.EvaluateInto(te);
+    EXPECT_DOUBLE_EQ(0.012, te.Val());
+
+    // values are read at evaluation time
+    t_ref.Set(0.010);
+    te_min.EvaluateInto(te);
+    EXPECT_DOUBLE_EQ(0.016, te.Val());
+
+    ParameterBase<double, si::metre> wrong_unit;
+    EXPECT_THROW(te_min.EvaluateInto(wrong_unit), std::invalid_argument);
+}
+
+TEST(Formula, FoldsConstantsAndChainsResults) {
+    ParameterBase<double, si::second> tr(0.5);
+    FormulaSymbols symbols{{"tr", &tr}};
+
+    Formula scaled("-(2 * 3 - 1) * tr / (4 / 2)", symbols);
+    EXPECT_EQ(2u, scaled.InstructionCount()); // constant * tr, then / constant
+    EXPECT_DOUBLE_EQ(-1.25, scaled.Evaluate().ViewAs<double>()[0]);
+
+    Formula constant("1.5e-3 * 2", symbols);
+    EXPECT_EQ(0u, constant.InstructionCount());
+    EXPECT_DOUBLE_EQ(3e-3, constant.Evaluate().ViewAs<double>()[0]);
+
+    symbols.emplace("scaled", &scaled.Result());
+    Formula rate("1 / (tr - scaled)", symbols);
+    scaled.Evaluate();
+    EXPECT_DOUBLE_EQ(1.0 / 1.75, rate.Evaluate().ViewAs<double>()[0]);
+    EXPECT_EQ(runtime_unit_of<si::hertz>, rate.GetRuntimeUnit());
+}
+
+TEST(Formula, CallsDispatchOpsOnVectors) {
+    ParameterBase<Eigen::Vector3d, si::metre> a(Eigen::Vector3d(1, 0, 0)), b(Eigen::Vector3d(0, 2, 0));
+    ParameterBase<double, one> s(3.0);
+    ParameterBase<double, si::metre> len(2.0);
+    FormulaSymbols symbols{{"a", &a}, {"b", &b}, {"s", &s}, {"len", &len}};
+
+    Formula f("cross(a, b) * s / len + a", symbols);
+    EXPECT_EQ(Eigen::Vector3d(1, 0, 3), f.Evaluate().ViewAs<Eigen::Vector3d>()[0]);
+    EXPECT_THROW(Formula("cross(a, b) + a", symbols), std::invalid_argument); // m^2 + m
+
+    Formula d("dot(a + b, b)", symbols);
+    EXPECT_DOUBLE_EQ(4.0, d.Evaluate().ViewAs<double>()[0]);
+}
+
+TEST(Formula, ReportsErrorsWithPosition) {
+    ParameterBase<double, si::second> t(1.0);
+    ParameterBase<std::string> name(std::string("TE"));
+    FormulaSymbols symbols{{"t", &t}, {"name", &name}};
+
+    try {
+        Formula f("t + x", symbols);
+        FAIL();
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ(std::string("Formula: unknown parameter 'x' at position 4 in 't + x'"), e.what());
+    }
+    EXPECT_THROW(Formula("t + 1", symbols), std::invalid_argument);   // s + dimensionless
+    EXPECT_THROW(Formula("t * name", symbols), std::invalid_argument); // no policy
+    EXPECT_THROW(Formula("(t", symbols), std::invalid_argument);
+    EXPECT_THROW(Formula("t t", symbols), std::invalid_argument);
+    EXPECT_THROW(Formula("foo(t, t)", symbols), std::invalid_argument);
+}
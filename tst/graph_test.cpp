@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/graph.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+TEST(ParameterGraph, RecomputesOnlyTheAffectedCone) {
+    ParameterBase<double, si::second> t_exc(0.004), t_ref(0.006), t_adc(0.008), tr(1.0);
+    FormulaSymbols symbols{{"t_exc", &t_exc}, {"t_ref", &t_ref}, {"t_adc", &t_adc}, {"tr", &tr}};
+    Formula te_min("TE_min = t_exc/2 + t_ref + t_adc/2", symbols);
+    symbols.emplace("TE_min", &te_min.Result());
+    Formula echo_spacing("2 * TE_min", symbols);
+    Formula duty("t_exc / tr", symbols);
+
+    ParameterGraph graph;
+    graph.AddFormula(te_min);
+    graph.AddFormula(echo_spacing);
+    graph.AddFormula(duty);
+    EXPECT_EQ(3u, graph.DirtyCount());
+    graph.RefreshAll();
+    EXPECT_EQ(3u, graph.RecomputeCount());
+    EXPECT_DOUBLE_EQ(0.024, echo_spacing.Result().ViewAs<double>()[0]);
+
+    graph.Set(t_ref, 0.010); // cone: TE_min, echo_spacing
+    EXPECT_TRUE(graph.IsDirty(echo_spacing.Result()));
+    EXPECT_FALSE(graph.IsDirty(duty.Result()));
+
+    // lazy: reading echo_spacing refreshes TE_min first
+    EXPECT_DOUBLE_EQ(0.032, graph.Refresh(echo_spacing.Result()).ViewAs<double>()[0]);
+    EXPECT_EQ(5u, graph.RecomputeCount());
+    EXPECT_EQ(0u, graph.DirtyCount());
+
+    graph.Set(tr, 2.0); // cone: duty
+    graph.RefreshAll();
+    EXPECT_EQ(6u, graph.RecomputeCount());
+    EXPECT_DOUBLE_EQ(0.002, duty.Result().ViewAs<double>()[0]);
+}
+
+TEST(ParameterGraph, CallbackDerivedParameters) {
+    ParameterBase<int> matrix(128);
+    ParameterBase<double, si::metre> fov(0.256);
+    ParameterBase<double, si::metre> resolution;
+
+    ParameterGraph graph;
+    graph.AddDerived(resolution, {&fov, &matrix}, [&] { resolution.Set(fov.Val() / matrix.Val()); });
+    graph.Set(matrix, 256);
+    graph.RefreshAll();
+    EXPECT_DOUBLE_EQ(0.001, resolution.Val());
+    EXPECT_EQ(1u, graph.RecomputeCount());
+}
+
+TEST(ParameterGraph, RejectsCycles) {
+    ParameterBase<double> a(1.0), b(2.0), c(3.0);
+    ParameterGraph graph;
+    graph.AddDerived(b, {&a}, [] {});
+    graph.AddDerived(c, {&b}, [] {});
+    EXPECT_THROW(graph.AddDerived(a, {&c}, [] {}), std::invalid_argument);
+    EXPECT_THROW(graph.AddDerived(a, {&a}, [] {}), std::invalid_argument);
+    EXPECT_THROW(graph.AddDerived(b, {&a}, [] {}), std::invalid_argument); // already derived
+
+    // the rejected registrations left the graph unchanged
+    graph.MarkChanged(a);
+    graph.RefreshAll();
+    EXPECT_EQ(0u, graph.DirtyCount());
+    EXPECT_EQ(3u, graph.Size());
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/parameter.h>
+#include "test_parameters.h"
+
+// built with METHODVERSE_PARAMETER_INSTRUMENTATION=1, see tst/CMakeLists.txt
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Positions : Parameter<Eigen::Vector3d, Positions, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Positions";
+};
+
+InstrumentationCounters find(const std::vector<InstrumentationEntry>& entries, const std::string& key) {
+    for (const auto& e : entries) {
+        if (e.key == key) return e.counters;
+    }
+    ADD_FAILURE() << key << " not in the report";
+    return {};
+}
+
+bool contains(const std::vector<InstrumentationEntry>& entries, const std::string& key) {
+    for (const auto& e : entries) {
+        if (e.key == key) return true;
+    }
+    return false;
+}
+
+TEST(Instrumentation, CountsPerTypeAndName) {
+    static_assert(instrumentation_enabled);
+    ResetInstrumentation();
+    {
+        EchoTime te(std::vector<double>(100, 0.01));
+        EchoTime copy = te;
+        EchoTime moved = std::move(copy);
+        const std::vector<double> values = te.Vals();
+        EXPECT_EQ(100u, values.size());
+        EXPECT_EQ(100u, moved.Size());
+    }
+    const InstrumentationReport report = CollectInstrumentation();
+    const InstrumentationCounters te = find(report.names, "TE");
+    EXPECT_EQ(1u, te.constructions);
+    EXPECT_EQ(1u, te.copies);
+    EXPECT_EQ(1u, te.moves);
+    EXPECT_EQ(1u, te.vals);
+    EXPECT_EQ(3u, te.allocations); // construction, copy and Vals(); the move takes over the buffer
+    EXPECT_EQ(3u * 100 * sizeof(double), te.bytes);
+
+    const InstrumentationCounters type = find(report.types, "double [s]");
+    EXPECT_EQ(te.constructions, type.constructions);
+    EXPECT_EQ(te.allocations, type.allocations);
+    EXPECT_EQ(te.bytes, type.bytes);
+}
+
+TEST(Instrumentation, AssignmentsCountNewBuffersOnly) {
+    EchoTime te(0.01);
+    ResetInstrumentation();
+    te.Set(0.02);                          // inline storage
+    te.Set(std::vector<double>(64, 0.03)); // new buffer
+    te.Set(std::vector<double>(32, 0.04)); // fits the buffer
+    InstrumentationCounters counters = find(CollectInstrumentation().names, "TE");
+    EXPECT_EQ(3u, counters.assignments);
+    EXPECT_EQ(1u, counters.allocations);
+    EXPECT_EQ(64u * sizeof(double), counters.bytes);
+
+    // te = values goes through the implicit assignment of EchoTime: a temporary EchoTime is constructed
+    // from the values and moved in, which is the kind of hidden copy the counters are meant to show
+    ResetInstrumentation();
+    te = std::vector<double>(16, 0.05);
+    counters = find(CollectInstrumentation().names, "TE");
+    EXPECT_EQ(1u, counters.constructions);
+    EXPECT_EQ(1u, counters.moves);
+    EXPECT_EQ(1u, counters.allocations);
+}
+
+TEST(Instrumentation, OperatorTemporariesAndUnnamedParameters) {
+    ParameterBase<double, si::second> a(std::vector<double>(10, 1.0));
+    ParameterBase<double, si::second> b(std::vector<double>(10, 2.0));
+    ResetInstrumentation();
+    const auto sum = (a + b).Eval();
+    const auto product = EagerApply<mul_op>(a, b);
+    EXPECT_EQ(10u, sum.Size());
+    EXPECT_EQ(10u, product.Size());
+
+    const InstrumentationReport report = CollectInstrumentation();
+    std::uint64_t temporaries = 0;
+    std::uint64_t bytes = 0;
+    for (const auto& e : report.types) {
+        temporaries += e.counters.temporaries;
+        bytes += e.counters.bytes;
+    }
+    EXPECT_EQ(2u, temporaries);
+    EXPECT_EQ(2u * 10 * sizeof(double), bytes);
+    EXPECT_FALSE(contains(report.names, "ParameterBase"));
+}
+
+TEST(Instrumentation, RuntimeNamesAreCountedByText) {
+    // run-time named parameters, whose names live in buffers that are reused after they are freed
+    struct Named : ParameterBase<double> {
+        std::string name;
+        explicit Named(std::string n) : name(std::move(n)) {}
+        std::string_view NameView() const noexcept override { return name; }
+    };
+    ResetInstrumentation();
+    for (int i = 0; i < 3; ++i) {
+        Named a(std::string(32, 'a'));
+        a.Set(1.0);
+        Named b(std::string(32, 'b'));
+        b.Set(2.0);
+        b.Set(3.0);
+    }
+    const InstrumentationReport report = CollectInstrumentation();
+    EXPECT_EQ(3u, find(report.names, std::string(32, 'a')).assignments);
+    EXPECT_EQ(6u, find(report.names, std::string(32, 'b')).assignments);
+}
+
+TEST(Instrumentation, ReportsAsTextAndJson) {
+    ResetInstrumentation();
+    Positions p(std::vector<Eigen::Vector3d>(4, Eigen::Vector3d::Ones()));
+    Positions q = p;
+    const InstrumentationReport report = CollectInstrumentation();
+    EXPECT_EQ(2u, find(report.names, "Positions").allocations);
+    EXPECT_NE(std::string::npos, report.ToText().find("by name"));
+    EXPECT_NE(std::string::npos, report.ToText().find("Vector3d [m]"));
+
+    const auto path = std::filesystem::temp_directory_path() / "methodverse_instrumentation_test.json";
+    WriteInstrumentationReport(path.string());
+    std::ifstream file(path);
+    std::stringstream json;
+    json << file.rdbuf();
+    EXPECT_NE(std::string::npos, json.str().find("\"key\": \"Positions\""));
+    EXPECT_NE(std::string::npos, json.str().find("\"bytes\": " + std::to_string(2 * 4 * sizeof(Eigen::Vector3d))));
+    std::filesystem::remove(path);
+    EXPECT_EQ(4u, q.Size());
+}
+
+TEST(Instrumentation, JsonEscapesNames) {
+    struct Named : ParameterBase<double> {
+        std::string name;
+        explicit Named(std::string n) : name(std::move(n)) {}
+        std::string_view NameView() const noexcept override { return name; }
+    };
+    ResetInstrumentation();
+    Named p("a \"quoted\" \\ name\n");
+    p.Set(1.0);
+    const std::string json = CollectInstrumentation().ToJson();
+    EXPECT_NE(std::string::npos, json.find(R"("key": "a \"quoted\" \\ name\n")"));
+}
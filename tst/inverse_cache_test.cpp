@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include <Eigen/Geometry>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Orientation : Parameter<Eigen::Matrix3d, Orientation, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Orientation";
+};
+
+struct Positions : Parameter<Eigen::RowVector3d, Positions, si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Positions";
+};
+
+Eigen::Matrix3d rotation(double angle) {
+    return Eigen::AngleAxisd(angle, Eigen::Vector3d(1.0, 2.0, 3.0).normalized()).toRotationMatrix();
+}
+
+Eigen::Matrix3d general_matrix() {
+    Eigen::Matrix3d m;
+    m << 2.0, 1.0, 0.0, 0.0, 3.0, 1.0, 1.0, 0.0, 4.0;
+    return m;
+}
+
+TEST(InverseCache, InvertMatrices) {
+    const std::vector<Eigen::Matrix3d> in{rotation(0.3), general_matrix()};
+    std::vector<Eigen::Matrix3d> out(2);
+    InvertMatrices(in, out);
+    EXPECT_TRUE((in[1] * out[1]).isIdentity(1e-12));
+    InvertMatrices(in, out, MatrixStructure::detect);
+    EXPECT_EQ(Eigen::Matrix3d(in[0].transpose()), out[0]);
+    EXPECT_TRUE((in[1] * out[1]).isIdentity(1e-12));
+    InvertMatrices(in, out, MatrixStructure::orthonormal);
+    EXPECT_EQ(Eigen::Matrix3d(in[1].transpose()), out[1]); // declared, not checked
+    std::vector<Eigen::Matrix3d> too_small(1);
+    EXPECT_THROW(InvertMatrices(in, too_small), std::invalid_argument);
+
+    EXPECT_TRUE(IsOrthonormal(rotation(1.0)));
+    EXPECT_FALSE(IsOrthonormal(general_matrix()));
+}
+
+TEST(InverseCache, ComputedOnceAndInvalidatedOnChange) {
+    Orientation o{rotation(0.1), general_matrix()};
+    EXPECT_EQ(nullptr, o.CachedInverse());
+    const auto& inverse = o.Inverse();
+    ASSERT_EQ(2u, inverse.size());
+    EXPECT_EQ(Eigen::Matrix3d(rotation(0.1).transpose()), inverse[0]); // detected rotation
+    EXPECT_TRUE((general_matrix() * inverse[1]).isIdentity(1e-12));
+    EXPECT_EQ(&inverse, o.CachedInverse());
+    EXPECT_EQ(&inverse, &o.Inverse());
+    EXPECT_FALSE(o.IsInline());
+
+    o.Set(general_matrix());
+    EXPECT_EQ(nullptr, o.CachedInverse());
+    EXPECT_TRUE((general_matrix() * o.Inverse()[0]).isIdentity(1e-12));
+
+    o = rotation(0.2);
+    EXPECT_EQ(nullptr, o.CachedInverse());
+    (void)o.Inverse();
+    o[0] = general_matrix(); // a write through a reference is seen by the comparison with the cached values
+    EXPECT_EQ(nullptr, o.CachedInverse());
+    (void)o.Inverse();
+    o.Get()[0] = rotation(0.4);
+    EXPECT_EQ(nullptr, o.CachedInverse());
+}
+
+TEST(InverseCache, WriteThroughAReferenceTakenBeforeTheInverse) {
+    Orientation o{rotation(0.3)};
+    auto& r = o[0];
+    (void)o.Inverse();
+    r = general_matrix();
+    EXPECT_EQ(nullptr, o.CachedInverse());
+    EXPECT_TRUE((general_matrix() * EagerApply<inverse_op>(o).Val()).isIdentity(1e-12));
+    const Positions p{Eigen::RowVector3d(1.0, 2.0, 3.0)};
+    EXPECT_TRUE(EagerApply<div_op>(p, o).Val().isApprox(p[0] * general_matrix().inverse(), 1e-12));
+    EXPECT_TRUE((general_matrix() * o.Inverse()[0]).isIdentity(1e-12));
+}
+
+TEST(InverseCache, DeclaredOrthonormalAndCopies) {
+    Orientation o(general_matrix());
+    o.DeclareOrthonormal();
+    EXPECT_EQ(Eigen::Matrix3d(general_matrix().transpose()), o.Inverse()[0]); // trusted without a check
+
+    const Orientation copy = o; // keeps the declaration, not the inverses
+    EXPECT_EQ(nullptr, copy.CachedInverse());
+    Orientation again = copy;
+    EXPECT_EQ(Eigen::Matrix3d(general_matrix().transpose()), again.Inverse()[0]);
+
+    const Eigen::Matrix3d* cached = o.CachedInverse()->data();
+    const Orientation moved = std::move(o); // takes the inverses along
+    ASSERT_NE(nullptr, moved.CachedInverse());
+    EXPECT_EQ(cached, moved.CachedInverse()->data());
+
+    Orientation plain(general_matrix());
+    plain = moved; // an assignment keeps the declaration of the assigned-to parameter
+    EXPECT_EQ(nullptr, plain.CachedInverse());
+    EXPECT_TRUE((general_matrix() * plain.Inverse()[0]).isIdentity(1e-12));
+}
+
+TEST(InverseCache, EagerApplyUsesTheCache) {
+    Orientation o{rotation(0.5)};
+    const Positions p{Eigen::RowVector3d(1.0, 2.0, 3.0), Eigen::RowVector3d(-1.0, 0.5, 2.0)};
+
+    const auto uncached = EagerApply<div_op>(p, o); // broadcast, inverted once
+    ASSERT_EQ(2u, uncached.Size());
+    EXPECT_TRUE(uncached[1].isApprox(p[1] * rotation(0.5).inverse(), 1e-12));
+    EXPECT_TRUE(EagerApply<inverse_op>(o).Val().isApprox(rotation(0.5).inverse(), 1e-12));
+    const ParameterBase<Eigen::Matrix3d, si::metre> scaled(general_matrix());
+    static_assert(decltype(EagerApply<inverse_op>(scaled))::GetUnit() == one / si::metre);
+
+    o.DeclareOrthonormal();
+    (void)o.Inverse();
+    const auto cached = EagerApply<div_op>(p, o);
+    EXPECT_EQ(Eigen::RowVector3d(p[1] * rotation(0.5).transpose()), cached[1]);
+    EXPECT_EQ(Eigen::Matrix3d(rotation(0.5).transpose()), EagerApply<inverse_op>(o).Val());
+    EXPECT_EQ(Eigen::Matrix3d(general_matrix() * rotation(0.5).transpose()),
+              EagerApply<div_op>(Orientation(general_matrix()), o).Val());
+}
@@ -49,3 +49,15 @@ TEST(OpPolicyDiv, VectorScalar) {
     EXPECT_EQ(r, Eigen::Vector3d(1,2,3));
 }
 
+
+// vector + vector and coefficient-wise ops keep the matrix type
+TEST(OpPolicyAdd, VectorVectorKeepsType) {
+    Eigen::Vector3d a(1,2,3), b(4,5,6);
+    auto r = op_policy<eigen_colvec_tag,eigen_colvec_tag,add_op>::impl(a, b);
+    static_assert(std::is_same_v<decltype(r), Eigen::Vector3d>);
+    EXPECT_EQ(r, Eigen::Vector3d(5,7,9));
+
+    auto m = op_policy<eigen_colvec_tag,eigen_colvec_tag,coefw_mul_op>::impl(a, b);
+    static_assert(std::is_same_v<decltype(m), Eigen::Vector3d>);
+    EXPECT_EQ(m, Eigen::Vector3d(4,10,18));
+}
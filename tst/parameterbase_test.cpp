@@ -49,7 +49,7 @@ public:
     using Base = ParamCRTP<T, Param<T,U>, U>;
     using Base::Base;
     static constexpr const char* name = "Param";
-    std::string Name() const override {
+    std::string_view NameView() const noexcept override {
         return name;
     }
 };
@@ -123,6 +123,7 @@ TYPED_TEST(ParameterBaseTypedTest, CanConstructAndUse) {
     ParameterType p0;
     EXPECT_EQ(0, p0.Size());
     EXPECT_EQ("Param", p0.Name());
+    EXPECT_EQ(ParameterId("Param"), p0.Id());
 
     // 1) copy constructor
     ParameterType p1(pe);
@@ -286,7 +287,7 @@ TEST(OpPolicyAdd, ScalarScalar) {
     Param<double, si::metre> p2(3.5);
     auto r = p1 + p2;
     EXPECT_DOUBLE_EQ(r.Val(), 5.5);
-    static_assert(std::is_same_v<decltype(r), ParameterBase<double, si::metre>>);
+    static_assert(std::is_same_v<decltype(r.Eval()), ParameterBase<double, si::metre>>);
 }
 
 TEST(OpPolicyMul, ScalarScalarResultantValuAndUnitCorrect) {
@@ -298,11 +299,141 @@ TEST(OpPolicyMul, ScalarScalarResultantValuAndUnitCorrect) {
     Param<double, si::second> dt(0.001);
 
     auto gamma_grad = gamma * grad_str; // should be of unit hertz/metre
-    //EXPECT_DOUBLE_EQ(gamma_grad.Val(), 425774.78461);
+    EXPECT_DOUBLE_EQ(gamma_grad.Val(), 425774784.61);
+    static_assert(si::hertz / si::metre == decltype(gamma_grad)::GetUnit(), "Unit should be hertz/metre");
     auto r = gamma * grad_str * dt; // should be of unit hertz/metre * tesla/metre * second = hertz/metre
     EXPECT_DOUBLE_EQ(r.Val(), 425774.78461);
     //using ExpectedType = ParameterBase<double, si::hertz / si::metre / si::second>;
     static_assert(si::hertz / si::metre * si::second == decltype(r)::GetUnit(), "Unit should be hertz/metre/second");
     std::cout << "r unit: " << decltype(r)::GetUnit() << "\n";
 
-}
\ No newline at end of file
+}
+TEST(OpPolicyElementwise, EqualSizesCombineElementByElement) {
+    Param<double, si::metre> p1{1.0, 2.0, 3.0};
+    Param<double, si::metre> p2{10.0, 20.0, 30.0};
+    auto r = p1 + p2;
+    ASSERT_EQ(3, r.Size());
+    EXPECT_DOUBLE_EQ(11.0, r[0]);
+    EXPECT_DOUBLE_EQ(22.0, r[1]);
+    EXPECT_DOUBLE_EQ(33.0, r[2]);
+
+    auto q = p2 / p1;
+    EXPECT_EQ(std::vector<double>({10.0, 10.0, 10.0}), q.Vals());
+}
+
+TEST(OpPolicyElementwise, SizeOneOperandIsBroadcast) {
+    Param<double, si::second> te{0.01, 0.02, 0.03};
+    Param<double, one> scale(2.0);
+
+    auto r1 = te * scale;
+    EXPECT_EQ(std::vector<double>({0.02, 0.04, 0.06}), r1.Vals());
+
+    auto r2 = scale * te;
+    EXPECT_EQ(r1.Vals(), r2.Vals());
+
+    Param<Eigen::Vector3d, si::metre> pos{Eigen::Vector3d(1, 0, 0), Eigen::Vector3d(0, 1, 0)};
+    Param<double, si::metre> offset(1.0);
+    auto shifted = pos - offset;
+    ASSERT_EQ(2, shifted.Size());
+    EXPECT_EQ(Eigen::Vector3d(0, -1, -1), shifted[0]);
+    EXPECT_EQ(Eigen::Vector3d(-1, 0, -1), shifted[1]);
+}
+
+TEST(OpPolicyElementwise, EmptyAndMismatchedSizes) {
+    Param<double, si::metre> empty;
+    Param<double, si::metre> single(1.0);
+    Param<double, si::metre> two{1.0, 2.0};
+    Param<double, si::metre> three{1.0, 2.0, 3.0};
+
+    EXPECT_EQ(0, (empty + single).Size());
+    EXPECT_EQ(0, (single + empty).Size());
+    EXPECT_THROW(two + three, std::invalid_argument);
+    EXPECT_THROW(empty + three, std::invalid_argument);
+}
+
+TEST(ParameterExpression, ChainIsLazyAndFused) {
+    constexpr auto Hz_per_T = si::hertz / si::tesla;
+    constexpr auto T_per_m = si::tesla / si::metre;
+
+    Param<double, Hz_per_T> gamma(42.577478461e6);
+    Param<double, T_per_m> grad_str{10.0, 20.0, 30.0};
+    Param<double, si::second> dt(0.001);
+
+    auto expr = gamma * grad_str * dt;
+    static_assert(parameter_expression<decltype(expr)>);
+    static_assert(decltype(expr)::GetUnit() == si::hertz / si::metre * si::second);
+    EXPECT_EQ(3, expr.Size());
+
+    // operands are captured by reference: a change before evaluation is visible in the result
+    grad_str[2] = 40.0;
+    ParameterBase<double, si::hertz / si::metre * si::second> r = expr;
+    ASSERT_EQ(3, r.Size());
+    EXPECT_DOUBLE_EQ(425774.78461, r[0]);
+    EXPECT_DOUBLE_EQ(851549.56922, r[1]);
+    EXPECT_DOUBLE_EQ(1703099.13844, r[2]);
+    EXPECT_DOUBLE_EQ(r[1], expr[1]);
+    EXPECT_EQ(r.Vals(), expr.Vals());
+}
+
+TEST(ParameterExpression, MatchesEagerEvaluation) {
+    Param<double, si::metre> a{1.0, 2.0, 3.0, 4.0};
+    Param<double, si::metre> b{0.5, 0.25, 0.125, 0.0625};
+    Param<double, one> c(3.0);
+
+    ParameterBase<double, si::metre> fused = (a + b) * c - a;
+    auto eager = EagerApply<sub_op>(EagerApply<mul_op>(EagerApply<add_op>(a, b), c), a);
+    EXPECT_EQ(eager, fused);
+}
+
+template<class Op, class L, class R>
+concept eager_applicable = requires(const L& l, const R& r) { EagerApply<Op>(l, r); };
+
+TEST(ParameterExpression, EagerApplyChecksUnits) {
+    static_assert(!eager_applicable<add_op, ParameterBase<double, si::second>, ParameterBase<double, si::metre>>);
+    static_assert(eager_applicable<mul_op, ParameterBase<double, si::second>, ParameterBase<double, si::metre>>);
+    const ParameterBase<bool, one> flags(true);
+    EXPECT_TRUE(EagerApply<and_op>(flags, flags).Val()); // bool policies have no unit rule
+}
+
+TEST(ParameterExpression, TemporaryOperandsAreMovedIntoTheNode) {
+    Param<double, si::metre> a{1.0, 2.0};
+    auto expr = a + ParameterBase<double, si::metre>{10.0, 20.0};
+    EXPECT_EQ(std::vector<double>({11.0, 22.0}), expr.Vals());
+}
+
+struct Distance : Parameter<double, Distance, si::metre> {
+    using Parameter<double, Distance, si::metre>::Parameter;
+    using Parameter<double, Distance, si::metre>::operator=;
+    static constexpr const char* name = "Distance";
+};
+
+TEST(ParameterExpression, AssignToParameter) {
+    Param<double, si::metre> a(1.5);
+    Param<double, si::metre> b(2.5);
+
+    Distance d = a + b;
+    EXPECT_DOUBLE_EQ(4.0, d.Val());
+    d = a - b;
+    EXPECT_DOUBLE_EQ(-1.0, d.Val());
+    EXPECT_EQ("Distance", d.Name());
+}
+
+TYPED_TEST(ParameterBaseTypedTest, ZeroCopyAccessors) {
+    using ParameterType = TypeParam;
+    using T = typename ParameterType::value_type;
+    auto primitive_values = make<T>();
+    ParameterType pe(primitive_values);
+
+    // ValRef refers into the storage, View spans all values without copying
+    EXPECT_EQ(&pe.Get()[0], &pe.ValRef());
+    auto view = pe.View();
+    ASSERT_EQ(pe.Size(), view.size());
+    EXPECT_EQ(pe.Get().data(), view.data());
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(pe[i], view[i]);
+        EXPECT_EQ(pe[i], pe.Unchecked(i));
+    }
+
+    ParameterType empty;
+    EXPECT_TRUE(empty.View().empty());
+}
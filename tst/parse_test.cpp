@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/parse.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Acceleration : Parameter<Eigen::Vector3d, Acceleration, si::metre / square(si::second)> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Acceleration";
+};
+
+struct Dwell : Parameter<int, Dwell, si::micro<si::second>> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Dwell";
+};
+
+// parse(ValueAsString(p)) == p for every primitive type
+template<class T>
+void expect_round_trip(const std::vector<T>& values) {
+    const ParameterBase<T> p(values);
+    ParameterBase<T> q;
+    ParseInto(p.ValueAsString(), q);
+    ASSERT_EQ(p.Size(), q.Size()) << p.ValueAsString();
+    for (std::size_t i = 0; i < p.Size(); ++i) {
+        if constexpr (std::is_same_v<T, Eigen::Quaterniond>) EXPECT_TRUE(p[i].coeffs() == q[i].coeffs());
+        else EXPECT_TRUE(p[i] == q[i]) << p.ValueAsString();
+    }
+}
+
+TEST(Parse, RoundTripsValueAsString) {
+    expect_round_trip<int>({-3});
+    expect_round_trip<int>({1, 2, 3});
+    expect_round_trip<double>({0.1});
+    expect_round_trip<double>({0.1, -2.5e-300, 1e300, std::numeric_limits<double>::infinity()});
+    expect_round_trip<bool>({true, false, true});
+    expect_round_trip<std::string>({"hello world"});
+    expect_round_trip<std::string>({"a", "b c"});
+    expect_round_trip<std::string>({"a, b", "x]y", "\"quoted\"", " padded ", "back\\slash", ""});
+    expect_round_trip<std::string>({"[not a list]"});
+    expect_round_trip<std::string>({" leading space"});
+    expect_round_trip<Eigen::Vector3d>({Eigen::Vector3d(1, 2.5, -3)});
+    expect_round_trip<Eigen::RowVector3d>({Eigen::RowVector3d(1, 2, 3), Eigen::RowVector3d(0.1, 0.2, 0.3)});
+    Eigen::Matrix3d m;
+    m << 1, 2, 3, 4, 5, 6, 7, 8, 9;
+    expect_round_trip<Eigen::Matrix3d>({m});
+    expect_round_trip<Eigen::Quaterniond>({Eigen::Quaterniond(0.5, 0.5, -0.5, 0.5)});
+}
+
+TEST(Parse, AcceptsFreeFormatting) {
+    ParameterBase<double> p;
+    ParseInto("  [ 1 ,2,+3.5e1 ]  ", p);
+    EXPECT_EQ((std::vector<double>{1, 2, 35}), std::vector<double>(p.View().begin(), p.View().end()));
+    ParseInto("[]", p);
+    EXPECT_EQ(0u, p.Size());
+
+    ParameterBase<bool> b;
+    ParseInto("[1, 0, true]", b);
+    EXPECT_EQ(3u, b.Size());
+    EXPECT_FALSE(b[1]);
+
+    ParameterBase<std::string> s;
+    ParseInto(R"(["a, \"b\"", c ])", s);
+    ASSERT_EQ(2u, s.Size());
+    EXPECT_EQ("a, \"b\"", s[0]);
+    EXPECT_EQ("c", s[1]);
+}
+
+TEST(Parse, ValidatesUnitSuffix) {
+    const auto te = Parse<EchoTime>("[0.01, 0.02] s");
+    EXPECT_EQ(2u, te.Size());
+    EXPECT_DOUBLE_EQ(0.02, te[1]);
+    EXPECT_DOUBLE_EQ(0.01, Parse<EchoTime>("0.01").Val()); // the suffix is optional
+
+    EXPECT_DOUBLE_EQ(9.81, Parse<Acceleration>("(0, 0, 9.81) m/s²")[0].z());
+    EXPECT_DOUBLE_EQ(9.81, Parse<Acceleration>("(0, 0, 9.81) m/s^2")[0].z());
+    EXPECT_EQ(10, Parse<Dwell>("10 µs").Val());
+    EXPECT_EQ(10, Parse<Dwell>("10 us").Val());
+
+    // round trip through the fmt formatter with unit
+    EXPECT_DOUBLE_EQ(0.01, Parse<EchoTime>(fmt::format("{:u}", EchoTime(0.01))).Val());
+
+    EXPECT_THROW((void)Parse<EchoTime>("0.01 ms"), std::invalid_argument);
+    EXPECT_THROW((void)Parse<EchoTime>("0.01 m"), std::invalid_argument);
+    EXPECT_THROW((void)Parse<Dwell>("10.5 us"), std::invalid_argument);
+}
+
+TEST(Parse, ReportsErrorsWithPosition) {
+    ParameterBase<double> p;
+    try {
+        ParseInto("[1, x]", p);
+        FAIL();
+    } catch (const std::invalid_argument& e) {
+        EXPECT_EQ("Parse: expected a number at position 4 in '[1, x]'", std::string(e.what()));
+    }
+    EXPECT_THROW(ParseInto("[1, 2", p), std::invalid_argument);
+    EXPECT_THROW(ParseInto("", p), std::invalid_argument);
+
+    ParameterBase<int> i;
+    EXPECT_THROW(ParseInto("99999999999", i), std::invalid_argument);
+
+    ParameterBase<Eigen::Vector3d> v;
+    EXPECT_THROW(ParseInto("(1, 2)", v), std::invalid_argument);
+    ParameterBase<std::string> s;
+    EXPECT_THROW(ParseInto("[\"abc]", s), std::invalid_argument);
+
+    ParameterBase<bool> b;
+    EXPECT_THROW(ParseInto("truex", b), std::invalid_argument);
+    EXPECT_THROW(ParseInto("[10]", b), std::invalid_argument);
+    EXPECT_THROW(ParseInto("[true, falsey]", b), std::invalid_argument);
+}
+
+TEST(Parse, ErrorLeavesTheParameterUnchanged) {
+    ParameterBase<double> p{1.0, 2.0, 3.0};
+    EXPECT_THROW(ParseInto("[4, 5, x]", p), std::invalid_argument);
+    EXPECT_EQ((std::vector<double>{1, 2, 3}), p.Vals());
+    EXPECT_THROW(ParseInto("4 ms", p), std::invalid_argument);
+    EXPECT_EQ((std::vector<double>{1, 2, 3}), p.Vals());
+    ParseInto("[4, 5]", p);
+    EXPECT_EQ((std::vector<double>{4, 5}), p.Vals());
+}
+
+TEST(Parse, FastPathMatchesFromChars) {
+    const std::vector<std::string> inputs{"0", "-0", "1.", ".5", "123.456", "-9007199254740992", "9007199254740993",
+                                          "1e22", "1e23", "1.5e-22", "2.5E+3", "0.000001", "12345678901234567890",
+                                          "3.141592653589793", "1e", "7e-300", "00000000000000000000001"};
+    for (const auto& s : inputs) {
+        double expected = 0.0;
+        const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), expected);
+        ASSERT_EQ(std::errc{}, ec) << s;
+        ParameterBase<double> p;
+        if (end == s.data() + s.size()) {
+            ParseInto(s, p);
+            EXPECT_EQ(std::bit_cast<std::uint64_t>(expected), std::bit_cast<std::uint64_t>(p.Val())) << s;
+        } else {
+            EXPECT_THROW(ParseInto(s, p), std::invalid_argument) << s; // trailing "e" is not a unit
+        }
+    }
+}
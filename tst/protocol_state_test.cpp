@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/protocol_state.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct Label : Parameter<std::string, Label, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Label";
+};
+
+// runtime-named parameter, to fill a state with many ids
+struct Named : ParameterBase<double> {
+    std::string name;
+    Named(std::string n, double v) : ParameterBase<double>(v), name(std::move(n)) {}
+    std::string_view NameView() const noexcept override { return name; }
+};
+
+TEST(ProtocolState, SetGetAndReplace) {
+    ProtocolState state;
+    EXPECT_TRUE(state.Empty());
+    EXPECT_EQ(nullptr, state.Get<EchoTime>());
+
+    state.Set(EchoTime(0.01));
+    state.Set(Label("localizer"));
+    EXPECT_EQ(2u, state.Size());
+    ASSERT_NE(nullptr, state.Get<EchoTime>());
+    EXPECT_DOUBLE_EQ(0.01, state.Get<EchoTime>()->Get()[0]);
+    EXPECT_EQ("localizer", state.Get<Label>()->Get()[0]);
+    EXPECT_EQ(state.Get<EchoTime>(), state.Find("TE"));
+
+    state.Set(EchoTime(0.02));
+    EXPECT_EQ(2u, state.Size());
+    EXPECT_DOUBLE_EQ(0.02, state.Get<EchoTime>()->Get()[0]);
+
+    EXPECT_THROW(state.Set(std::shared_ptr<const IParameter>()), std::invalid_argument);
+}
+
+TEST(ProtocolState, GetOfTheWrongClassReturnsNull) {
+    // stored under the id of EchoTime, but not an EchoTime
+    ProtocolState state;
+    state.Set(Named("TE", 0.01));
+    EXPECT_NE(nullptr, state.Find(EchoTime::id));
+    EXPECT_EQ(nullptr, state.Get<EchoTime>());
+    EXPECT_THROW(state.Modify<EchoTime>([](EchoTime&) {}), std::out_of_range);
+}
+
+TEST(ProtocolState, CopiesAreIndependentAndShareUnchangedParameters) {
+    ProtocolState original;
+    original.Set(EchoTime(0.01));
+    original.Set(RepetitionTime(2.0));
+
+    ProtocolState variant = original;
+    variant.Modify<EchoTime>([](EchoTime& te) { te.Get()[0] = 0.03; });
+
+    EXPECT_DOUBLE_EQ(0.01, original.Get<EchoTime>()->Get()[0]);
+    EXPECT_DOUBLE_EQ(0.03, variant.Get<EchoTime>()->Get()[0]);
+    EXPECT_FALSE(original.Shares(variant, EchoTime::id));
+    EXPECT_TRUE(original.Shares(variant, RepetitionTime::id));
+
+    EXPECT_THROW(variant.Modify<Label>([](Label&) {}), std::out_of_range);
+}
+
+TEST(ProtocolState, SharedHandleOutlivesState) {
+    std::shared_ptr<const IParameter> te;
+    {
+        ProtocolState state;
+        state.Set(EchoTime(0.05));
+        te = state.Share(EchoTime::id);
+    }
+    ASSERT_NE(nullptr, te);
+    EXPECT_EQ("0.05", te->ValueAsString());
+}
+
+TEST(ProtocolState, ManyParametersInsertFindErase) {
+    constexpr int count = 5000;
+    ProtocolState state;
+    std::vector<ProtocolState> versions;
+    for (int i = 0; i < count; ++i) {
+        state.Set(std::make_shared<const Named>(fmt::format("P{}", i), i));
+        if (i % 1000 == 999) versions.push_back(state);
+    }
+    EXPECT_EQ(static_cast<std::size_t>(count), state.Size());
+    for (int i = 0; i < count; ++i) {
+        const IParameter* p = state.Find(fmt::format("P{}", i));
+        ASSERT_NE(nullptr, p);
+        EXPECT_DOUBLE_EQ(i, p->UncheckedViewAs<double>()[0]);
+    }
+    EXPECT_EQ(nullptr, state.Find(fmt::format("P{}", count)));
+
+    std::size_t visited = 0;
+    std::set<std::string> names;
+    state.ForEach([&](const IParameter& p) {
+        ++visited;
+        names.insert(p.Name());
+    });
+    EXPECT_EQ(static_cast<std::size_t>(count), visited);
+    EXPECT_EQ(static_cast<std::size_t>(count), names.size());
+
+    for (int i = 0; i < count; i += 2) EXPECT_TRUE(state.Erase(ParameterId(fmt::format("P{}", i))));
+    EXPECT_FALSE(state.Erase(ParameterId("P0")));
+    EXPECT_EQ(static_cast<std::size_t>(count / 2), state.Size());
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(i % 2 == 1, state.Contains(ParameterId(fmt::format("P{}", i))));
+    }
+    for (int i = 1; i < count; i += 2) EXPECT_TRUE(state.Erase(ParameterId(fmt::format("P{}", i))));
+    EXPECT_TRUE(state.Empty());
+
+    // earlier versions are untouched
+    for (std::size_t v = 0; v < versions.size(); ++v) {
+        EXPECT_EQ((v + 1) * 1000, versions[v].Size());
+        EXPECT_NE(nullptr, versions[v].Find("P0"));
+    }
+}
+
+TEST(ProtocolHistory, UndoRedo) {
+    ProtocolHistory history;
+    history.Edit([](ProtocolState& s) { s.Set(EchoTime(0.01)); });
+    history.Edit([](ProtocolState& s) { s.Modify<EchoTime>([](EchoTime& te) { te.Get()[0] = 0.02; }); });
+    history.Edit([](ProtocolState& s) { s.Set(RepetitionTime(3.0)); });
+    EXPECT_EQ(3u, history.UndoDepth());
+
+    EXPECT_TRUE(history.Undo());
+    EXPECT_EQ(nullptr, history.Current().Get<RepetitionTime>());
+    EXPECT_TRUE(history.Undo());
+    EXPECT_DOUBLE_EQ(0.01, history.Current().Get<EchoTime>()->Get()[0]);
+    EXPECT_TRUE(history.Redo());
+    EXPECT_DOUBLE_EQ(0.02, history.Current().Get<EchoTime>()->Get()[0]);
+    EXPECT_EQ(1u, history.RedoDepth());
+
+    // a new edit drops the redo list
+    history.Edit([](ProtocolState& s) { s.Erase(EchoTime::id); });
+    EXPECT_EQ(0u, history.RedoDepth());
+    EXPECT_FALSE(history.Redo());
+    EXPECT_TRUE(history.Current().Empty());
+
+    while (history.Undo()) {}
+    EXPECT_TRUE(history.Current().Empty());
+    EXPECT_EQ(0u, history.UndoDepth());
+}
+
+TEST(ProtocolHistory, DepthIsBounded) {
+    ProtocolHistory history({}, 2);
+    for (int i = 0; i < 5; ++i) history.Edit([&](ProtocolState& s) { s.Set(EchoTime(i)); });
+    EXPECT_EQ(2u, history.UndoDepth());
+    EXPECT_TRUE(history.Undo());
+    EXPECT_TRUE(history.Undo());
+    EXPECT_FALSE(history.Undo());
+    EXPECT_DOUBLE_EQ(2.0, history.Current().Get<EchoTime>()->Get()[0]);
+}
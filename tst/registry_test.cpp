@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/registry.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+TEST(ParameterId, ComputedAtCompileTime) {
+    static_assert(EchoTime::id == "TE"_pid);
+    static_assert(EchoTime::id != RepetitionTime::id);
+    static_assert(fnv1a_64("") == 0xcbf29ce484222325ull);
+    static_assert(fnv1a_64("a") == 0xaf63dc4c8601ec8cull);
+
+    EchoTime te(0.01);
+    const IParameter& p = te;
+    EXPECT_EQ("TE", p.NameView());
+    EXPECT_EQ("TE", p.Name());
+    EXPECT_EQ(ParameterId("TE"), p.Id());
+    EXPECT_EQ("ParameterBase", ParameterBase<double>(1.0).NameView());
+}
+
+TEST(ParameterRegistry, FindsByIdAndName) {
+    EchoTime te(0.01);
+    RepetitionTime tr(1.0);
+    ParameterRegistry registry;
+    registry.Insert(te);
+    registry.Insert(tr);
+    registry.Insert(te); // same parameter again: no-op
+
+    EXPECT_EQ(2u, registry.Size());
+    EXPECT_EQ(&te, registry.Find("TE"_pid));
+    EXPECT_EQ(&tr, registry.Find("TR"));
+    EXPECT_EQ(&te, registry.Find<EchoTime>());
+    EXPECT_EQ(nullptr, registry.Find("TI"));
+
+    EchoTime other(0.02);
+    EXPECT_THROW(registry.Insert(other), std::invalid_argument);
+}
+
+TEST(ParameterRegistry, FindOfTheWrongClassReturnsNull) {
+    // same name and value type as EchoTime, but not an EchoTime
+    struct OtherEchoTime : ParameterBase<double, si::second> {
+        std::string_view NameView() const noexcept override { return "TE"; }
+    };
+    OtherEchoTime te;
+    ParameterRegistry registry;
+    registry.Insert(te);
+
+    EXPECT_EQ(&te, registry.Find("TE"_pid));
+    EXPECT_EQ(nullptr, registry.Find<EchoTime>());
+}
+
+TEST(ParameterRegistry, MovedFromIsEmptyAndUsable) {
+    EchoTime te(0.01);
+    RepetitionTime tr(1.0);
+    ParameterRegistry a;
+    a.Insert(te);
+
+    ParameterRegistry b(std::move(a));
+    EXPECT_EQ(&te, b.Find<EchoTime>());
+    EXPECT_TRUE(a.Empty());
+    EXPECT_EQ(nullptr, a.Find("TE"_pid));
+    EXPECT_FALSE(a.Erase("TE"_pid));
+
+    a.Insert(tr);
+    b = std::move(a);
+    EXPECT_EQ(&tr, b.Find("TR"));
+    EXPECT_EQ(nullptr, b.Find("TE"));
+    EXPECT_EQ(nullptr, a.Find("TR"));
+    a.Insert(te);
+    EXPECT_EQ(&te, a.Find("TE"));
+}
+
+TEST(ParameterRegistry, GrowsAndErases) {
+    // parameters with run-time names
+    struct Named : ParameterBase<double> {
+        std::string name;
+        explicit Named(std::string n) : name(std::move(n)) {}
+        std::string_view NameView() const noexcept override { return name; }
+    };
+    std::vector<Named> params;
+    params.reserve(1000);
+    for (int i = 0; i < 1000; ++i) params.emplace_back(fmt::format("p{}", i));
+
+    ParameterRegistry registry;
+    for (auto& p : params) registry.Insert(p);
+    EXPECT_EQ(1000u, registry.Size());
+    for (auto& p : params) EXPECT_EQ(&p, registry.Find(p.NameView()));
+
+    // erase every other entry; the remaining ones must stay reachable
+    for (int i = 0; i < 1000; i += 2) EXPECT_TRUE(registry.Erase(ParameterId(fmt::format("p{}", i))));
+    EXPECT_FALSE(registry.Erase(ParameterId("p0")));
+    EXPECT_EQ(500u, registry.Size());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(i % 2 ? &params[i] : nullptr, registry.Find(params[i].NameView()));
+    }
+}
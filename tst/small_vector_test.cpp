@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <methodverse/parameter/small_vector.h>
+#include <methodverse/parameter/parameter.h>
+
+using namespace methodverse::parameter;
+
+TEST(SmallVector, SingleValueStaysInline) {
+    small_vector<double, 1> v{1.5};
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(1, v.size());
+    EXPECT_DOUBLE_EQ(1.5, v[0]);
+}
+
+TEST(SmallVector, GrowsToHeapAndBack) {
+    small_vector<std::string, 2> v{"a", "b"};
+    EXPECT_TRUE(v.is_inline());
+    v.push_back("c");
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}), v);
+    v.resize(1);
+    EXPECT_EQ(1, v.size());
+    EXPECT_EQ("a", v.at(0));
+    EXPECT_THROW((void)v.at(1), std::out_of_range);
+}
+
+TEST(SmallVector, CopyAndMove) {
+    small_vector<Eigen::Quaterniond, 1> a{Eigen::Quaterniond(1, 0, 0, 0), Eigen::Quaterniond(0, 1, 0, 0)};
+    small_vector<Eigen::Quaterniond, 1> b(a);
+    EXPECT_EQ(a, b);
+
+    small_vector<Eigen::Quaterniond, 1> c(std::move(b));
+    EXPECT_EQ(a, c);
+    EXPECT_TRUE(b.empty());
+    EXPECT_TRUE(b.is_inline());
+
+    small_vector<Eigen::Quaterniond, 1> d{Eigen::Quaterniond(2, 0, 0, 0)};
+    d = a;
+    EXPECT_EQ(a, d);
+    d = small_vector<Eigen::Quaterniond, 1>{Eigen::Quaterniond(3, 0, 0, 0)};
+    EXPECT_EQ(1, d.size());
+    EXPECT_TRUE(d.is_inline());
+}
+
+TEST(SmallVector, ParameterScalarIsInline) {
+    ParameterBase<double, mp_units::si::second> p(1.0);
+    EXPECT_TRUE(p.Get().is_inline());
+
+    ParameterBase<double, mp_units::si::second * mp_units::si::second> r = p * p;
+    EXPECT_TRUE(r.Get().is_inline());
+    EXPECT_DOUBLE_EQ(1.0, r.Val());
+}
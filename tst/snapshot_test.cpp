@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/snapshot.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct Orientation : Parameter<Eigen::Quaterniond, Orientation, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Orientation";
+};
+
+struct Gradients : Parameter<Eigen::Vector3d, Gradients, si::milli<si::tesla> / si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Gradients";
+};
+
+struct Labels : Parameter<std::string, Labels, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Labels";
+};
+
+struct Flags : Parameter<bool, Flags, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Flags";
+};
+
+class SnapshotTest : public ::testing::Test {
+protected:
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("snapshot_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".mvps"))
+                           .string();
+    void TearDown() override { std::filesystem::remove(path); }
+};
+
+TEST_F(SnapshotTest, ValuesAreReadInPlace) {
+    const EchoTime te(std::vector<double>{0.01, 0.02, 0.03});
+    const Orientation q(Eigen::Quaterniond(0.5, 0.5, -0.5, 0.5));
+    std::vector<Eigen::Vector3d> g(1000);
+    for (std::size_t i = 0; i < g.size(); ++i) g[i] = Eigen::Vector3d(i, -double(i), 0.5);
+    const Gradients gradients(g);
+    const Labels labels(std::vector<std::string>{"a", "", "long label with spaces"});
+    const Flags flags(std::vector<bool>{true, false});
+    WriteSnapshot(path, {&te, &q, &gradients, &labels, &flags});
+
+    const Snapshot snapshot(path);
+    ASSERT_EQ(5u, snapshot.Size());
+
+    const SnapshotParameter* s = snapshot.Find(EchoTime::id);
+    ASSERT_NE(nullptr, s);
+    EXPECT_EQ("TE", s->NameView());
+    EXPECT_EQ(EchoTime::id, s->Id());
+    EXPECT_EQ(runtime_unit_of<si::second>, s->GetRuntimeUnit());
+    const auto values = s->ViewAs<double>();
+    EXPECT_EQ((std::vector<double>{0.01, 0.02, 0.03}), std::vector<double>(values.begin(), values.end()));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % 64);
+    EXPECT_THROW((void)s->ViewAs<int>(), std::bad_cast);
+    EXPECT_EQ("[0.01, 0.02, 0.03]", s->ValueAsString());
+
+    const auto view = snapshot.Find("Gradients")->ViewAs<Eigen::Vector3d>();
+    ASSERT_EQ(1000u, view.size());
+    EXPECT_EQ(Eigen::Vector3d(999, -999, 0.5), view[999]);
+    EXPECT_EQ(runtime_unit_of<si::milli<si::tesla> / si::metre>, snapshot.Find("Gradients")->GetRuntimeUnit());
+
+    EXPECT_EQ("(0.5, 0.5, -0.5, 0.5)", snapshot.Find("Orientation")->ValueAsString());
+    EXPECT_EQ("[true, false]", snapshot.Find("Flags")->ValueAsString());
+    EXPECT_EQ("[a, , long label with spaces]", snapshot.Find("Labels")->ValueAsString());
+    EXPECT_EQ(no_type_id, snapshot.Find("Labels")->TypeId());
+    EXPECT_EQ(nullptr, snapshot.Find("TR"));
+
+    // the entries are sorted by id
+    for (std::size_t i = 1; i < snapshot.Size(); ++i) EXPECT_LT(snapshot[i - 1].Id(), snapshot[i].Id());
+}
+
+TEST_F(SnapshotTest, LoadIntoChecksTypeAndUnit) {
+    const EchoTime te(0.01);
+    const Labels labels(std::vector<std::string>{"x", "y"});
+    WriteSnapshot(path, {&te, &labels});
+    const Snapshot snapshot(path);
+
+    EchoTime loaded;
+    snapshot.LoadInto(loaded);
+    EXPECT_DOUBLE_EQ(0.01, loaded.Val());
+
+    Labels loaded_labels;
+    snapshot.LoadInto(loaded_labels);
+    EXPECT_EQ((std::vector<std::string>{"x", "y"}), loaded_labels.Vals());
+
+    EchoTimeInMetres wrong_unit;
+    EXPECT_THROW(snapshot.LoadInto(wrong_unit), std::invalid_argument);
+    EchoTimeAsInt wrong_type;
+    EXPECT_THROW(snapshot.LoadInto(wrong_type), std::invalid_argument);
+    Gradients missing;
+    EXPECT_THROW(snapshot.LoadInto(missing), std::out_of_range);
+}
+
+TEST_F(SnapshotTest, RejectsInvalidInput) {
+    const EchoTime te(0.01), te2(0.02);
+    EXPECT_THROW(WriteSnapshot(path, {&te, &te2}), std::invalid_argument);
+
+    EXPECT_THROW(Snapshot("/nonexistent/file.mvps"), std::runtime_error);
+
+    { std::ofstream(path, std::ios::binary) << "not a snapshot, just some text that is long enough"; }
+    EXPECT_THROW(Snapshot{path}, std::runtime_error);
+
+    // truncated file
+    WriteSnapshot(path, {&te});
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+    EXPECT_THROW(Snapshot{path}, std::runtime_error);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/soa.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+TEST(SoaParameter, ProxyAccessKeepsParameterSemantics) {
+    SoaParameter<Eigen::Vector3d, si::metre> p{Eigen::Vector3d(1, 2, 3), Eigen::Vector3d(4, 5, 6)};
+    ASSERT_EQ(2, p.Size());
+    EXPECT_EQ(Eigen::Vector3d(4, 5, 6), static_cast<Eigen::Vector3d>(p[1]));
+
+    p[0] = Eigen::Vector3d(7, 8, 9);
+    EXPECT_EQ(Eigen::Vector3d(7, 8, 9), p.Val());
+    EXPECT_EQ(7.0, p.Get().lane(0)[0]);
+    EXPECT_EQ(9.0, p.Get().lane(2)[0]);
+    EXPECT_THROW((void)p[2], std::out_of_range);
+
+    const auto& cp = p;
+    EXPECT_EQ(Eigen::Vector3d(4, 5, 6), cp[1]);
+}
+
+TEST(SoaParameter, RoundTripThroughParameterBase) {
+    ParameterBase<Eigen::Quaterniond, one> aos{Eigen::Quaterniond(1, 2, 3, 4), Eigen::Quaterniond(5, 6, 7, 8)};
+    SoaParameter<Eigen::Quaterniond, one> soa(aos);
+    EXPECT_EQ(aos.Vals(), soa.Vals());
+    EXPECT_EQ(aos, soa.ToParameterBase());
+}
+
+TEST(SoaParameter, KernelsMatchOpPolicy) {
+    std::vector<Eigen::Vector3d> a, b;
+    for (int i = 0; i < 37; ++i) {
+        a.emplace_back(i, 2.0 * i, 1.0 - i);
+        b.emplace_back(0.5 * i, 3.0, -i);
+    }
+    SoaParameter<Eigen::Vector3d, si::metre> sa(a);
+    SoaParameter<Eigen::Vector3d, si::second> sb(b);
+
+    auto dot = Dot(sa, sb);
+    auto cross = Cross(sa, sb);
+    auto mul = CoefwMul(sa, sb);
+    static_assert(decltype(dot)::GetUnit() == si::metre * si::second);
+    ASSERT_EQ(a.size(), dot.Size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_DOUBLE_EQ((op_policy<eigen_colvec_tag, eigen_colvec_tag, dot_op>::impl(a[i], b[i])), dot[i]);
+        EXPECT_EQ((op_policy<eigen_colvec_tag, eigen_colvec_tag, cross_op>::impl(a[i], b[i])), cross.Get().get(i));
+        EXPECT_EQ(Eigen::Vector3d(a[i].cwiseProduct(b[i])), mul.Get().get(i));
+    }
+
+    // a single direction is broadcast against the table
+    SoaParameter<Eigen::Vector3d, si::second> axis(Eigen::Vector3d(0, 0, 1));
+    auto proj = Dot(sa, axis);
+    ASSERT_EQ(a.size(), proj.Size());
+    EXPECT_DOUBLE_EQ(a[5].z(), proj[5]);
+}
+
+TEST(SoaParameter, QuaternionProduct) {
+    std::vector<Eigen::Quaterniond> a{Eigen::Quaterniond(1, 2, 3, 4), Eigen::Quaterniond(0.5, -1, 0, 2)};
+    std::vector<Eigen::Quaterniond> b{Eigen::Quaterniond(4, 3, 2, 1), Eigen::Quaterniond(1, 0, 1, 0)};
+    auto r = SoaApply<mul_op>(SoaParameter<Eigen::Quaterniond>(a), SoaParameter<Eigen::Quaterniond>(b));
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        EXPECT_TRUE((a[i] * b[i]).isApprox(r.Get().get(i)));
+    }
+}
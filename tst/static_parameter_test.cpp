@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/static_parameter.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+// sequence constants, all folded at compile time
+inline constexpr StaticParameter<double, 1, si::second> grad_raster(10e-6);
+inline constexpr StaticParameter<int, 1> ramp_samples(12);
+inline constexpr StaticParameter<double, 1, si::second> flat_time(1.2e-3);
+inline constexpr auto ramp_time = grad_raster * ramp_samples;
+inline constexpr auto readout_time = ramp_time + flat_time + ramp_time;
+inline constexpr StaticParameter<double, 3, si::second> echo_spacing(2e-3, 4e-3, 6e-3);
+
+template<class L, class R>
+concept addable = requires(const L& l, const R& r) { l + r; };
+
+TEST(StaticParameter, ConstantExpressions) {
+    static_assert(std::is_trivially_copyable_v<StaticParameter<double, 3, si::second>>);
+    static_assert(ramp_time.GetUnit() == si::second);
+    static_assert(std::is_same_v<decltype(ramp_time)::value_type, double>);
+    static_assert(ramp_time.Val() == 10e-6 * 12);
+    static_assert(readout_time.Val() == 10e-6 * 12 + 1.2e-3 + 10e-6 * 12);
+
+    constexpr auto rate = ramp_samples / ramp_time; // 1/s
+    static_assert(rate.GetUnit() == ramp_samples.GetUnit() / si::second);
+
+    constexpr StaticParameter<int, 1> two(2);
+    static_assert((two * two + two).Val() == 6);
+    static_assert(std::is_same_v<decltype(two * two)::value_type, int>);
+
+    constexpr StaticParameter<bool, 2> enabled(true, false);
+    static_assert(StaticApply<not_op>(enabled) == StaticParameter<bool, 2>(false, true));
+    static_assert(StaticApply<and_op>(enabled, StaticParameter<bool, 1>(true)) == enabled);
+    EXPECT_EQ(6, (two * two + two).Val());
+}
+
+TEST(StaticParameter, BroadcastingAndUnitChecks) {
+    constexpr auto te = echo_spacing + readout_time;
+    static_assert(te.Size() == 3);
+    static_assert(te[2] == 6e-3 + readout_time.Val());
+    static_assert(!addable<StaticParameter<double, 2>, StaticParameter<double, 3>>);   // sizes do not broadcast
+    static_assert(!addable<StaticParameter<double, 1, si::second>, StaticParameter<double, 1, si::metre>>);
+    static_assert(!addable<StaticParameter<std::string, 1>, StaticParameter<double, 1>>);
+    EXPECT_THROW((void)te[3], std::out_of_range);
+}
+
+TEST(StaticParameter, UnitConversion) {
+    constexpr auto raster_us = grad_raster.In<si::micro<si::second>>();
+    static_assert(raster_us.GetUnit() == si::micro<si::second>);
+    EXPECT_DOUBLE_EQ(10.0, raster_us.Val());
+    EXPECT_DOUBLE_EQ(1.2, flat_time.In<si::milli<si::second>>().Val());
+}
+
+TEST(StaticParameter, ToParameterBase) {
+    const EchoTime te(echo_spacing.ToParameterBase());
+    EXPECT_EQ(3u, te.Size());
+    EXPECT_EQ(4e-3, te[1]);
+    EXPECT_EQ(te.ValueAsString(), echo_spacing.ValueAsString());
+}
+
+TEST(StaticParameter, EigenValuesAtRunTime) {
+    const StaticParameter<Eigen::Vector3d, 1, si::metre> offset(Eigen::Vector3d(1.0, 2.0, 3.0));
+    const StaticParameter<double, 2> scale(2.0, 3.0);
+    const auto scaled = scale * offset;
+    static_assert(std::is_same_v<decltype(scaled), const StaticParameter<Eigen::Vector3d, 2, si::metre>>);
+    EXPECT_EQ(Eigen::Vector3d(3.0, 6.0, 9.0), scaled[1]);
+}
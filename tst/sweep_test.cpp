@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include <boost/mp11.hpp>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/sweep.h>
+#include "test_parameters.h"
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct RepetitionTime : Parameter<double, RepetitionTime, si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TR";
+};
+
+struct MatrixSize : Parameter<int, MatrixSize, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "MatrixSize";
+};
+
+struct Averages : Parameter<int, Averages, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "Averages";
+};
+
+TEST(Sweep, ShapeIndicesAndPoints) {
+    const Sweep sweep(EchoTime{0.01, 0.02}, RepetitionTime{1.0, 2.0, 3.0}, MatrixSize{128, 256});
+    EXPECT_EQ(12u, sweep.Size());
+    EXPECT_EQ((std::array<std::size_t, 3>{2, 3, 2}), sweep.Shape());
+
+    // the last axis varies fastest
+    EXPECT_EQ((std::array<std::size_t, 3>{0, 0, 1}), sweep.Indices(1));
+    EXPECT_EQ((std::array<std::size_t, 3>{1, 2, 1}), sweep.Indices(11));
+    EXPECT_THROW((void)sweep.Indices(12), std::out_of_range);
+
+    const auto [te, tr, matrix] = sweep.Point(7);
+    EXPECT_DOUBLE_EQ(0.02, te.Val());
+    EXPECT_DOUBLE_EQ(1.0, tr.Val());
+    EXPECT_EQ(256, matrix.Val());
+    EXPECT_EQ(1u, te.Size());
+}
+
+TEST(Sweep, ForEachMatchesTheCompileTimeProduct) {
+    // the same order as mp_product over the value lists
+    using product = boost::mp11::mp_product<boost::mp11::mp_list, boost::mp11::mp_list_c<int, 1, 2, 3>,
+                                            boost::mp11::mp_list_c<int, 10, 20>>;
+    std::vector<std::pair<int, int>> expected;
+    boost::mp11::mp_for_each<product>([&](auto point) {
+        using p = decltype(point);
+        expected.emplace_back(boost::mp11::mp_at_c<p, 0>::value, boost::mp11::mp_at_c<p, 1>::value);
+    });
+
+    std::vector<std::pair<int, int>> visited;
+    const Sweep sweep(MatrixSize{1, 2, 3}, Averages{10, 20});
+    sweep.ForEach([&](const MatrixSize& m, const Averages& a) { visited.emplace_back(m.Val(), a.Val()); });
+    EXPECT_EQ(expected, visited);
+}
+
+TEST(Sweep, RunVisitsEveryPointOnce) {
+    std::vector<double> te_values(17), tr_values(23);
+    std::vector<int> matrix(11);
+    for (std::size_t i = 0; i < te_values.size(); ++i) te_values[i] = 0.001 * static_cast<double>(i + 1);
+    for (std::size_t i = 0; i < tr_values.size(); ++i) tr_values[i] = 0.1 * static_cast<double>(i + 1);
+    for (std::size_t i = 0; i < matrix.size(); ++i) matrix[i] = 64 * static_cast<int>(i + 1);
+    const Sweep sweep{EchoTime(te_values), RepetitionTime(tr_values), MatrixSize(matrix)};
+
+    for (std::size_t threads : {1u, 3u, 8u}) {
+        std::vector<int> seen(sweep.Size(), 0);
+        std::vector<double> results(sweep.Size(), 0.0);
+        sweep.Run([](const EchoTime& te, const RepetitionTime& tr,
+                     const MatrixSize& m) { return te.Val() * m.Val() + tr.Val(); },
+                  [&](std::size_t index, double r) {
+                      ++seen[index];
+                      results[index] = r;
+                  },
+                  SweepOptions{.threads = threads, .grain = 7});
+        for (std::size_t i = 0; i < sweep.Size(); ++i) {
+            ASSERT_EQ(1, seen[i]) << "point " << i << " with " << threads << " threads";
+            const auto [te, tr, m] = sweep.Point(i);
+            EXPECT_DOUBLE_EQ(te.Val() * m.Val() + tr.Val(), results[i]);
+        }
+    }
+}
+
+TEST(Sweep, RunWithoutSinkAndEmptyAxis) {
+    const Sweep sweep(EchoTime{0.01, 0.02, 0.03}, RepetitionTime{1.0, 2.0});
+    std::atomic<int> count{0};
+    sweep.Run([&](const EchoTime&, const RepetitionTime&) { ++count; }, SweepOptions{.threads = 4, .grain = 1});
+    EXPECT_EQ(6, count.load());
+
+    const Sweep empty(EchoTime{0.01}, RepetitionTime(std::vector<double>{}));
+    EXPECT_EQ(0u, empty.Size());
+    empty.Run([&](const EchoTime&, const RepetitionTime&) { ++count; });
+    EXPECT_EQ(6, count.load());
+}
+
+TEST(Sweep, ExceptionStopsTheSweepAndIsRethrown) {
+    std::vector<double> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<double>(i);
+    const Sweep sweep{EchoTime(values)};
+    EXPECT_THROW(sweep.Run(
+                     [](const EchoTime& te) {
+                         if (te.Val() == 500.0) throw std::runtime_error("timing check failed");
+                         return te.Val();
+                     },
+                     [](std::size_t, double) {}, SweepOptions{.threads = 4, .grain = 16}),
+                 std::runtime_error);
+}
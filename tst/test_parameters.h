@@ -0,0 +1,24 @@
+// test_parameters.h
+// This file defines the parameter classes shared by the tests: EchoTime ("TE" in seconds), and two classes with
+// the same name (and id) but another unit or value type, for the tests of type and unit checks.
+// Author: Chenguang Zhao
+// Date: 2026-10-16
+
+#pragma once
+
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/parameter.h>
+
+struct EchoTime : methodverse::parameter::Parameter<double, EchoTime, mp_units::si::second> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "TE";
+};
+
+// same name (and id) as EchoTime with another unit or value type
+struct EchoTimeInMetres : methodverse::parameter::Parameter<double, EchoTimeInMetres, mp_units::si::metre> {
+    static constexpr const char* name = "TE";
+};
+
+struct EchoTimeAsInt : methodverse::parameter::Parameter<int, EchoTimeAsInt, mp_units::si::second> {
+    static constexpr const char* name = "TE";
+};
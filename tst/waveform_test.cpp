@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <mp-units/systems/si.h>
+#include <methodverse/parameter/any_parameter.h>
+#include <methodverse/parameter/dispatch.h>
+#include <methodverse/parameter/parse.h>
+#include <methodverse/parameter/snapshot.h>
+
+using namespace methodverse::parameter;
+using namespace mp_units;
+
+struct GradientShape : Parameter<Eigen::VectorXd, GradientShape, si::tesla / si::metre> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "GradientShape";
+};
+
+struct RfShape : Parameter<Eigen::ArrayXf, RfShape, one> {
+    using Parameter::Parameter;
+    static constexpr const char* name = "RfShape";
+};
+
+template<class Op, class L, class R>
+concept eager_applicable = requires(const L& l, const R& r) { EagerApply<Op>(l, r); };
+
+Eigen::VectorXd ramp(Eigen::Index n, double last) { return Eigen::VectorXd::LinSpaced(n, 0.0, last); }
+
+TEST(Waveform, CategoriesAndTypeNames) {
+    static_assert(std::is_same_v<category_t<Eigen::VectorXd>, eigen_waveform_tag>);
+    static_assert(std::is_same_v<category_t<Eigen::ArrayXf>, eigen_waveform_tag>);
+    static_assert(waveform_type<Eigen::ArrayXd> && !waveform_type<Eigen::Vector3d>);
+    EXPECT_EQ("VectorXd", primitive_type_names[primitive_type_id_v<Eigen::VectorXd>]);
+    EXPECT_EQ("ArrayXf", primitive_type_names[primitive_type_id_v<Eigen::ArrayXf>]);
+}
+
+TEST(Waveform, UnitSafeFusedArithmetic) {
+    const GradientShape shape(ramp(8, 7.0));
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> offset(Eigen::VectorXd::Constant(8, 1.0));
+    const ParameterBase<double, si::second> raster(10e-6);
+
+    // (shape + offset) * raster: one fused pass, the unit is T/m * s
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre * si::second> moment = (shape + offset) * raster;
+    EXPECT_TRUE(moment.Val().isApprox((ramp(8, 7.0).array() + 1.0).matrix() * 10e-6));
+
+    const ParameterBase<int, one> two(2);
+    const auto scaled = two * shape - offset;
+    static_assert(std::is_same_v<decltype(scaled)::value_type, Eigen::VectorXd>);
+    EXPECT_EQ(2.0 * 7.0 - 1.0, scaled.Val()[7]);
+    EXPECT_EQ(2.0 * 3.0 - 1.0, scaled[0][3]);
+
+    // * and / are sample by sample
+    const auto ratio = EagerApply<div_op>(shape, offset);
+    static_assert(ratio.GetUnit() == one);
+    EXPECT_EQ(ramp(8, 7.0), ratio.Val());
+    EXPECT_EQ(EagerApply<coefw_mul_op>(shape, shape).Val(), (shape * shape).Val());
+
+    static_assert(!eager_applicable<add_op, ParameterBase<Eigen::VectorXd, si::tesla>, ParameterBase<Eigen::VectorXd, si::metre>>);
+    static_assert(!eager_applicable<dot_op, ParameterBase<Eigen::VectorXd, one>, ParameterBase<Eigen::VectorXd, one>>);
+    static_assert(!eager_applicable<coefw_mul_op, ParameterBase<Eigen::VectorXd, one>, ParameterBase<double, one>>);
+}
+
+TEST(Waveform, FloatArraysAndBroadcasting) {
+    Eigen::ArrayXf b1(4);
+    b1 << 0.0f, 0.5f, 1.0f, 0.5f;
+    const RfShape pulse{b1, Eigen::ArrayXf(b1 * 2.0f)};
+    const ParameterBase<double, one> gain(0.5);
+
+    const ParameterBase<Eigen::ArrayXf, one> scaled = pulse * gain + gain; // the scalars are cast to float
+    ASSERT_EQ(2u, scaled.Size());
+    EXPECT_FLOAT_EQ(1.0f, scaled[0][2]);
+    EXPECT_FLOAT_EQ(1.5f, scaled[1][2]);
+}
+
+TEST(Waveform, LengthsMustMatch) {
+    const GradientShape a(ramp(8, 1.0));
+    const GradientShape b(ramp(9, 1.0));
+    EXPECT_THROW((void)EagerApply<add_op>(a, b), std::invalid_argument);
+    EXPECT_THROW((void)(a - b).Val(), std::invalid_argument);
+    EXPECT_FALSE(a == b);
+    EXPECT_TRUE(a == GradientShape(ramp(8, 1.0)));
+}
+
+TEST(Waveform, AssignmentReusesSampleBuffers) {
+    ParameterBase<Eigen::VectorXd, si::tesla / si::metre> shape{ramp(8, 7.0), ramp(8, 1.0)};
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> offset(Eigen::VectorXd::Constant(8, 1.0));
+    const ParameterBase<double, one> gain(2.0);
+    const double* samples = shape[1].data();
+
+    shape = shape * gain + offset; // the target is an operand
+    EXPECT_EQ(samples, shape[1].data());
+    EXPECT_EQ(Eigen::VectorXd((ramp(8, 14.0).array() + 1.0).matrix()), shape[0]);
+
+    const ParameterBase<Eigen::VectorXd, si::tesla / si::metre> longer{ramp(8, 1.0), ramp(9, 1.0)};
+    const auto before = shape;
+    EXPECT_THROW(shape = shape + longer, std::invalid_argument);
+    EXPECT_TRUE(shape == before); // the lengths are checked before anything is written
+}
+
+TEST(Waveform, FormatAndParse) {
+    Eigen::VectorXd v(3);
+    v << 0.0, 0.5, 1.0;
+    const GradientShape shape{v, Eigen::VectorXd()};
+    EXPECT_EQ("[(0, 0.5, 1), ()]", shape.ValueAsString());
+
+    const auto parsed = Parse<GradientShape>("[(0, 0.5, 1), ()] T/m");
+    EXPECT_TRUE(parsed == shape);
+    EXPECT_THROW((void)Parse<GradientShape>("(0, 0.5"), std::invalid_argument);
+}
+
+TEST(Waveform, TypeErasedCode) {
+    const GradientShape shape(ramp(4, 3.0));
+    const ParameterBase<double, si::second> raster(2.0);
+
+    const auto moment = DynamicApply<mul_op>(shape, raster);
+    ASSERT_EQ(primitive_type_id_v<Eigen::VectorXd>, moment->TypeId());
+    EXPECT_EQ(ramp(4, 6.0), moment->ViewAs<Eigen::VectorXd>()[0]);
+    EXPECT_EQ(shape.GetRuntimeUnit() * raster.GetRuntimeUnit(), moment->GetRuntimeUnit());
+    const ParameterBase<Eigen::ArrayXd, si::tesla / si::metre> array(Eigen::ArrayXd::Zero(4));
+    EXPECT_THROW((void)DynamicApply<add_op>(shape, array), std::invalid_argument); // waveforms of different types
+
+    const AnyParameter any{shape};
+    EXPECT_EQ(primitive_type_id_v<Eigen::VectorXd>, any.TypeId());
+    EXPECT_TRUE(any == AnyParameter::From(shape));
+    EXPECT_FALSE(any == AnyParameter{GradientShape(ramp(5, 3.0))});
+}
+
+TEST(Waveform, SnapshotRecords) {
+    Eigen::ArrayXf odd(3); // 12 bytes of samples, padded to 16
+    odd << 1.0f, 2.0f, 3.0f;
+    const RfShape pulse{odd, Eigen::ArrayXf::Constant(5, 0.25f)};
+    const GradientShape shape{ramp(16, 1.0)};
+    const std::string path = testing::TempDir() + "waveform_snapshot.mvps";
+    WriteSnapshot(path, {&pulse, &shape});
+
+    {
+        const Snapshot snapshot(path);
+        const SnapshotParameter* stored = snapshot.Find("RfShape");
+        ASSERT_NE(nullptr, stored);
+        EXPECT_EQ(no_type_id, stored->TypeId()); // records, not an array of ArrayXf
+        const auto views = stored->Waveforms<Eigen::ArrayXf>();
+        ASSERT_EQ(2u, views.size());
+        EXPECT_EQ(3, views[0].size());
+        EXPECT_FLOAT_EQ(3.0f, views[0][2]);
+        EXPECT_FLOAT_EQ(0.25f, views[1][4]);
+        EXPECT_THROW((void)stored->Waveforms<Eigen::ArrayXd>(), std::bad_cast);
+        EXPECT_EQ(pulse.ValueAsString(), stored->ValueAsString());
+
+        RfShape loaded;
+        snapshot.LoadInto(loaded);
+        EXPECT_TRUE(loaded == pulse);
+        GradientShape loaded_shape;
+        snapshot.LoadInto(loaded_shape);
+        EXPECT_TRUE(loaded_shape == shape);
+    }
+    std::remove(path.c_str());
+}